@@ -363,6 +363,15 @@ public:
     detail::Constant<GLint, GL_MAX_TEXTURE_SIZE> max_texture_size;
     detail::Constant<GLint, GL_MAX_3D_TEXTURE_SIZE> max_3d_texture_size;
     detail::Constant<GLint, GL_MAX_ARRAY_TEXTURE_LAYERS> max_array_texture_layers;
+    detail::Constant<GLint, GL_MAX_UNIFORM_BUFFER_BINDINGS> max_uniform_buffer_bindings;
+    detail::Constant<GLint, GL_MAJOR_VERSION> major_version;
+    detail::Constant<GLint, GL_MINOR_VERSION> minor_version;
+
+    /// @brief Whether the context supports at least the given OpenGL version.
+    bool supportsVersion(GLint major, GLint minor) const
+    {
+        return major_version > major || (major_version == major && minor_version >= minor);
+    }
 
 private:
     /// @brief If the property hasn't been backed up yet, it gets added to the top of the state backup stack.
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "dang-gl/global.h"
+
+namespace dang::gl {
+
+/// @brief A read-only memory mapping of a whole file, which unmaps itself on destruction.
+/// @remark Gives direct access to the file contents without copying them into a buffer first.
+class MappedFile {
+public:
+    /// @brief Creates an empty mapping without an associated file.
+    MappedFile() = default;
+    /// @brief Maps the whole file at the given path into memory.
+    /// @remark Similar to std::ifstream, failure is not reported with an exception, but can be checked with operator
+    /// bool instead. Empty files cannot be mapped and fail as well.
+    explicit MappedFile(const fs::path& path);
+    /// @brief Unmaps the file.
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /// @brief Returns a pointer to the first byte of the file or nullptr if no file is mapped.
+    const std::byte* data() const { return data_; }
+    /// @brief Returns the size of the file in bytes.
+    std::size_t size() const { return size_; }
+
+    /// @brief Whether a file is currently mapped.
+    explicit operator bool() const { return data_ != nullptr; }
+
+private:
+    /// @brief Unmaps the file, if one is mapped.
+    void unmap() noexcept;
+
+    const std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+} // namespace dang::gl
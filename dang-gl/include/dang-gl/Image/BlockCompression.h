@@ -0,0 +1,247 @@
+#pragma once
+
+#include "dang-gl/General/GLConstants.h"
+#include "dang-gl/Image/Image.h"
+#include "dang-gl/Image/ImageView.h"
+#include "dang-gl/Image/Pixel.h"
+#include "dang-gl/Image/PixelFormat.h"
+#include "dang-gl/Image/PixelInternalFormat.h"
+#include "dang-gl/Image/PixelType.h"
+#include "dang-gl/global.h"
+
+#include "dang-math/vector.h"
+#include "dang-utils/enum.h"
+
+#include <future>
+#include <thread>
+
+namespace dang::gl {
+
+/// @brief Block compressed formats, which store each block of 4x4 pixels in either 8 or 16 bytes.
+enum class BlockCompression {
+    /// @brief RGB with an optional 1-bit alpha in 8 bytes per block, also known as DXT1.
+    BC1,
+    /// @brief RGB with separately interpolated alpha in 16 bytes per block, also known as DXT5.
+    BC3,
+    /// @brief Only the red channel in 8 bytes per block, also known as RGTC1.
+    BC4,
+    /// @brief The red and green channel in 16 bytes per block, also known as RGTC2.
+    BC5,
+    /// @brief High quality RGBA in 16 bytes per block, also known as BPTC.
+    BC7,
+
+    COUNT
+};
+
+} // namespace dang::gl
+
+namespace dang::utils {
+
+template <>
+struct enum_count<dang::gl::BlockCompression> : default_enum_count<dang::gl::BlockCompression> {};
+
+} // namespace dang::utils
+
+namespace dang::gl {
+
+/// @brief The internal format, which textures need to use to store blocks of the given compression.
+inline constexpr dutils::EnumArray<BlockCompression, PixelInternalFormat> block_compression_internal_formats = {
+    PixelInternalFormat::COMPRESSED_RGBA_S3TC_DXT1,
+    PixelInternalFormat::COMPRESSED_RGBA_S3TC_DXT5,
+    PixelInternalFormat::COMPRESSED_RED_RGTC1,
+    PixelInternalFormat::COMPRESSED_RG_RGTC2,
+    PixelInternalFormat::COMPRESSED_RGBA_BPTC_UNORM};
+
+/// @brief The number of bytes of a single block of 4x4 pixels.
+inline constexpr dutils::EnumArray<BlockCompression, std::size_t> block_compression_block_sizes = {8, 16, 8, 16, 16};
+
+namespace detail {
+
+/// @brief Returns the number of blocks along each axis for an image of the given size, including partial blocks.
+inline dmath::svec2 compressedBlockCount(const dmath::svec2& size, std::size_t block_size)
+{
+    return {(size.x() + block_size - 1) / block_size, (size.y() + block_size - 1) / block_size};
+}
+
+} // namespace detail
+
+/// @brief A non-owning view on the blocks of a block compressed image, e.g. pointing into a mapped file.
+class CompressedImageView {
+public:
+    /// @brief The width and height of a single block in pixels.
+    static constexpr std::size_t block_size = 4;
+
+    CompressedImageView() = default;
+
+    /// @brief Views the blocks at the given pointer, which are stored row by row.
+    CompressedImageView(const std::byte* data, const dmath::svec2& size, BlockCompression compression)
+        : data_(data)
+        , size_(size)
+        , compression_(compression)
+    {}
+
+    /// @brief Returns the size of the image in pixels.
+    const dmath::svec2& size() const { return size_; }
+
+    /// @brief Returns the used compression format.
+    BlockCompression compression() const { return compression_; }
+
+    /// @brief Returns the number of blocks along each axis, including partial blocks at the edges.
+    dmath::svec2 blockCount() const { return detail::compressedBlockCount(size_, block_size); }
+
+    /// @brief The number of bytes of a single block.
+    std::size_t blockByteCount() const { return block_compression_block_sizes[compression_]; }
+
+    /// @brief The total number of bytes of all blocks.
+    std::size_t byteCount() const { return blockCount().product() * blockByteCount(); }
+
+    /// @brief Provides access to the raw underlying data, which can be used to provide OpenGL the data.
+    const std::byte* data() const { return data_; }
+
+private:
+    const std::byte* data_ = nullptr;
+    dmath::svec2 size_;
+    BlockCompression compression_ = BlockCompression::BC1;
+};
+
+/// @brief Stores the blocks of a block compressed image row by row, exactly like OpenGL expects them.
+class CompressedImage {
+public:
+    /// @brief The width and height of a single block in pixels.
+    static constexpr std::size_t block_size = CompressedImageView::block_size;
+
+    /// @brief Initializes the image with a size of zero without allocating any storage.
+    CompressedImage() = default;
+
+    /// @brief Initializes an image of the given size, with all blocks set to zero.
+    CompressedImage(const dmath::svec2& size, BlockCompression compression)
+        : size_(size)
+        , compression_(compression)
+        , data_(byteCount() > 0 ? std::make_unique<std::byte[]>(byteCount()) : nullptr)
+    {}
+
+    /// @brief Returns the size of the image in pixels.
+    const dmath::svec2& size() const { return size_; }
+
+    /// @brief Returns the used compression format.
+    BlockCompression compression() const { return compression_; }
+
+    /// @brief Returns the number of blocks along each axis, including partial blocks at the edges.
+    dmath::svec2 blockCount() const { return detail::compressedBlockCount(size_, block_size); }
+
+    /// @brief The number of bytes of a single block.
+    std::size_t blockByteCount() const { return block_compression_block_sizes[compression_]; }
+
+    /// @brief The total number of bytes of all blocks.
+    std::size_t byteCount() const { return blockCount().product() * blockByteCount(); }
+
+    /// @brief Returns a pointer to the block at the given position, which is measured in blocks.
+    std::byte* block(const dmath::svec2& block_pos) { return &data_[blockIndex(block_pos)]; }
+
+    /// @brief Returns a pointer to the block at the given position, which is measured in blocks.
+    const std::byte* block(const dmath::svec2& block_pos) const { return &data_[blockIndex(block_pos)]; }
+
+    /// @brief Provides access to the raw underlying data, which can be used to provide OpenGL the data.
+    std::byte* data() { return data_.get(); }
+
+    /// @brief Provides access to the raw underlying data, which can be used to provide OpenGL the data.
+    const std::byte* data() const { return data_.get(); }
+
+    /// @brief Returns a view on all blocks of the image.
+    CompressedImageView view() const { return {data_.get(), size_, compression_}; }
+
+    /// @brief Whether the image contains any actual data.
+    explicit operator bool() const { return bool{data_}; }
+
+private:
+    std::size_t blockIndex(const dmath::svec2& block_pos) const
+    {
+        return (block_pos.y() * blockCount().x() + block_pos.x()) * blockByteCount();
+    }
+
+    dmath::svec2 size_;
+    BlockCompression compression_ = BlockCompression::BC1;
+    std::unique_ptr<std::byte[]> data_;
+};
+
+namespace detail {
+
+using BlockCompressionPixel = Pixel<PixelFormat::RGBA, PixelType::UNSIGNED_BYTE>;
+
+/// @brief The pixels of a single block, row by row.
+using BlockCompressionPixels =
+    std::array<BlockCompressionPixel, CompressedImage::block_size * CompressedImage::block_size>;
+
+/// @brief Encodes the pixels of a single block into the given compression format.
+void compressBlock(const BlockCompressionPixels& pixels, BlockCompression compression, std::byte* block);
+
+/// @brief Decodes a single block of the given compression format.
+/// @exception std::invalid_argument if a BC7 block does not use mode 6.
+BlockCompressionPixels decompressBlock(const std::byte* block, BlockCompression compression);
+
+} // namespace detail
+
+/// @brief Compresses the given view on a pool of threads, each of which encodes whole rows of blocks.
+/// @remark Partial blocks at the right and bottom edge are filled up by repeating the last row and column.
+/// @remark BC4 and BC5 only use the red and green channel, while BC1 makes pixels with an alpha below one half
+/// transparent.
+/// @remark A thread count of zero uses the hardware concurrency.
+template <std::size_t v_row_alignment>
+CompressedImage compressImage(
+    const ImageView<2, PixelFormat::RGBA, PixelType::UNSIGNED_BYTE, v_row_alignment>& image_view,
+    BlockCompression compression,
+    std::size_t thread_count = 0)
+{
+    constexpr auto block_size = CompressedImage::block_size;
+
+    CompressedImage result(image_view.size(), compression);
+    auto size = image_view.size();
+    auto block_count = result.blockCount();
+    if (block_count.product() == 0)
+        return result;
+
+    if (thread_count == 0)
+        thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+    thread_count = std::min(thread_count, block_count.y());
+
+    auto compress = [&](std::size_t first) {
+        detail::BlockCompressionPixels pixels;
+        for (auto block_y = first; block_y < block_count.y(); block_y += thread_count) {
+            for (std::size_t block_x = 0; block_x < block_count.x(); block_x++) {
+                for (std::size_t y = 0; y < block_size; y++) {
+                    auto pixel_y = std::min(block_y * block_size + y, size.y() - 1);
+                    for (std::size_t x = 0; x < block_size; x++) {
+                        auto pixel_x = std::min(block_x * block_size + x, size.x() - 1);
+                        pixels[y * block_size + x] = image_view[dmath::svec2(pixel_x, pixel_y)];
+                    }
+                }
+                detail::compressBlock(pixels, compression, result.block({block_x, block_y}));
+            }
+        }
+    };
+
+    std::vector<std::future<void>> workers;
+    workers.reserve(thread_count - 1);
+    for (std::size_t first = 1; first < thread_count; first++)
+        workers.push_back(std::async(std::launch::async, compress, first));
+    compress(0);
+    for (auto& worker : workers)
+        worker.get();
+    return result;
+}
+
+/// @brief Compresses the given image on a pool of threads, each of which encodes whole rows of blocks.
+template <std::size_t v_row_alignment>
+CompressedImage compressImage(const Image<2, PixelFormat::RGBA, PixelType::UNSIGNED_BYTE, v_row_alignment>& image,
+                              BlockCompression compression,
+                              std::size_t thread_count = 0)
+{
+    return compressImage(image.view(), compression, thread_count);
+}
+
+/// @brief Decodes a compressed image, e.g. to measure the quality of the compression.
+/// @remark Channels, which are not stored by the compression format, are zero with an alpha of one.
+/// @exception std::invalid_argument if a BC7 block does not use mode 6, which is the only mode produced by the encoder.
+Image2D decompressImage(const CompressedImage& image);
+
+} // namespace dang::gl
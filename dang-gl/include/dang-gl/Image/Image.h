@@ -1,5 +1,7 @@
 #pragma once
 
+#include "dang-gl/General/MappedFile.h"
+#include "dang-gl/Image/ImageView.h"
 #include "dang-gl/Image/PNGLoader.h"
 #include "dang-gl/Image/Pixel.h"
 #include "dang-gl/Image/PixelFormat.h"
@@ -12,6 +14,7 @@
 namespace dang::gl {
 
 /// @brief Stores pixels data for an n-dimensional image in a template specified type.
+/// @remark Pixels are stored row-major with x being contiguous, so bulk operations work on whole rows at once.
 template <std::size_t v_dim,
           PixelFormat v_pixel_format = PixelFormat::RGBA,
           PixelType v_pixel_type = PixelType::UNSIGNED_BYTE,
@@ -26,6 +29,7 @@ public:
     using Pixel = Pixel<pixel_format, pixel_type>;
     using Size = dmath::svec<dim>;
     using Bounds = dmath::sbounds<dim>;
+    using View = ImageView<dim, pixel_format, pixel_type, row_alignment>;
 
     static_assert(row_alignment > 0);
 
@@ -35,39 +39,73 @@ public:
     /// @brief Initializes the image with a size of zero without allocating any storage.
     Image() = default;
 
+    /// @brief Copies all pixels, while copies of freed images and placeholders stay without pixels.
     Image(const Image& other)
         : size_(other.size_)
+        , data_(other.data_ ? allocate(other.byteCount()) : nullptr)
     {
-        std::memcpy(data_.get(), other.data_.get(), byteCount());
+        if (data_)
+            std::memcpy(data_.get(), other.data_.get(), byteCount());
     }
 
     Image(Image&&) = default;
 
+    /// @brief Copies all pixels, while copies of freed images and placeholders stay without pixels.
     Image& operator=(const Image& other)
     {
+        if (this == &other)
+            return *this;
         size_ = other.size_;
+        if (!other.data_) {
+            data_ = nullptr;
+            return *this;
+        }
         auto byte_count = byteCount();
-        data_ = std::make_unique<std::byte[]>(byte_count);
+        data_ = allocate(byte_count);
         std::memcpy(data_.get(), other.data_.get(), byte_count);
+        return *this;
     }
 
     Image& operator=(Image&&) = default;
 
     /// @brief Initializes the image using the given size and fills it with the value.
+    /// @remark If all bytes of the value are the same, e.g. zero, the whole image is filled using a single memset,
+    /// after which the alignment padding is cleared again, unless it is already zero. Otherwise only the first row is
+    /// filled pixel by pixel, which then gets copied into all other rows.
     Image(const Size& size, const Pixel& value = {})
         : size_(size)
     {
-        for (const auto& pos : Bounds(size_))
-            new (&(*this)[pos]) Pixel(value);
+        if (count() == 0)
+            return;
+
+        auto bytes = reinterpret_cast<const std::byte*>(&value);
+        if (std::all_of(bytes, bytes + sizeof(Pixel), [&](std::byte byte) { return byte == bytes[0]; })) {
+            std::memset(data_.get(), std::to_integer<int>(bytes[0]), byteCount());
+            if (bytes[0] != std::byte() && alignedByteWidth() != byteWidth())
+                forEachRow(Bounds(size_), [&](const Size& pos) { clearPadding(pos); });
+            return;
+        }
+
+        auto first_row = data_.get();
+        std::uninitialized_fill_n(reinterpret_cast<Pixel*>(first_row), size_[0], value);
+        clearPadding(Size());
+        forEachRow(Bounds(size_), [&](const Size& pos) {
+            if (pos != Size())
+                std::memcpy(&data_[posToIndex(pos)], first_row, alignedByteWidth());
+        });
     }
 
-    /// @brief Initializes the image using the given size and pixel iterator.
+    /// @brief Initializes the image using the given size and pixel iterator, which is read row by row.
     template <typename TIter>
     Image(const Size& size, TIter first)
         : size_(size)
     {
-        for (const auto& pos : Bounds(size_))
-            new (&(*this)[pos]) Pixel(first++);
+        forEachRow(Bounds(size_), [&](const Size& pos) {
+            auto row = reinterpret_cast<Pixel*>(&data_[posToIndex(pos)]);
+            for (std::size_t x = 0; x < size_[0]; x++)
+                new (&row[x]) Pixel(*first++);
+            clearPadding(pos);
+        });
     }
 
     /// @brief Initializes the image using the given size and preexisting chunk of data, which should match the size.
@@ -82,12 +120,28 @@ public:
         assert((count() == 0) == (data_.get() == nullptr));
     }
 
+    /// @brief Creates a new image by copying the pixels of a view.
+    explicit Image(const View& view)
+        : size_(view.size())
+    {
+        auto row_size = byteWidth();
+        forEachRow(Bounds(size_), [&](const Size& pos) {
+            std::memcpy(&(*this)[pos], &view[pos], row_size);
+            clearPadding(pos);
+        });
+    }
+
     /// @brief Creates a new image from a subsection of an existing image.
     Image(const Image& image, const Bounds& bounds)
-        : size_(bounds.size())
+        : Image(image.view(bounds))
+    {}
+
+    /// @brief Creates an image of the given size without allocating any pixels, as if it had been freed.
+    static Image placeholder(const Size& size)
     {
-        for (const auto& pos : bounds)
-            new (&(*this)[pos - bounds.low]) Pixel(image[pos]);
+        Image result;
+        result.size_ = size;
+        return result;
     }
 
     /// @brief Loads a PNG image from the given stream and returns it.
@@ -103,7 +157,32 @@ public:
         return Image(png_loader.size(), std::move(data));
     }
 
+    /// @brief Loads a PNG image from the given memory and returns it.
+    /// @exception PNGError if the memory does not contain a valid PNG.
+    // TODO: C++20 replace with std::span
+    static Image loadFromPNG(const std::byte* data, std::size_t size)
+    {
+        static_assert(pixel_type == PixelType::UNSIGNED_BYTE, "Loading PNG images only supports unsigned bytes.");
+        PNGLoader png_loader;
+        // TODO: Better logging
+        png_loader.onWarning.append([](const PNGWarningInfo& info) { std::cerr << info.message << '\n'; });
+        png_loader.init(data, size);
+        auto image_data = png_loader.read<pixel_format, row_alignment>(true);
+        return Image(png_loader.size(), std::move(image_data));
+    }
+
+    /// @brief Loads a PNG image from the given memory mapped file and returns it.
+    /// @exception PNGError if the file is not mapped.
+    /// @exception PNGError if the file does not represent a valid PNG.
+    static Image loadFromPNG(const MappedFile& file)
+    {
+        if (!file)
+            throw PNGError("PNG file is not mapped.");
+        return loadFromPNG(file.data(), file.size());
+    }
+
     /// @brief Loads a PNG image from the given file and returns it.
+    /// @remark Mapping the file is not worth it for small images; use the MappedFile overload for big ones.
     /// @exception PNGError if the file cannot be opened.
     /// @exception PNGError if the file does not represent a valid PNG.
     static Image loadFromPNG(const fs::path& path)
@@ -127,7 +206,7 @@ public:
     std::size_t alignedByteWidth() const { return (byteWidth() - 1) / row_alignment * row_alignment + row_alignment; }
 
     /// @brief The size of the image, but with width as the aligned byte width.
-    dmath::svec2 alignedByteSize() const
+    Size alignedByteSize() const
     {
         auto result = size();
         result[0] = alignedByteWidth();
@@ -144,18 +223,95 @@ public:
     const Pixel& operator[](const Size& pos) const { return *reinterpret_cast<const Pixel*>(&data_[posToIndex(pos)]); }
 
     /// @brief Creates a new image from a subsection.
+    /// @remark Prefer view, if the pixels do not need to outlive this image.
     Image operator[](const Bounds& bounds) const { return Image(*this, bounds); }
 
+    /// @brief Returns a non-owning view on the whole image.
+    View view() const { return View(data(), size_); }
+
+    /// @brief Returns a non-owning view on a subsection, without copying any pixels.
+    View view(const Bounds& bounds) const { return View(data(), size_, bounds); }
+
     /// @brief Copies pixels from a subsection of an existing image with a given offset.
+    /// @remark The source may also be an overlapping region of the same image.
     void setSubImage(const Size& offset, const Image& image, const Bounds& bounds)
     {
-        for (const auto& pos : bounds)
-            (*this)[pos + offset] = image[pos];
+        auto row_size = bounds.size()[0] * sizeof(Pixel);
+        auto copy_row = [&](const Size& pos) { std::memmove(&(*this)[pos + offset], &image[pos], row_size); };
+        // The offset cannot move rows towards the start, so copying back to front never overwrites unread rows.
+        if (&image == this)
+            forEachRowReversed(bounds, copy_row);
+        else
+            forEachRow(bounds, copy_row);
     }
 
     /// @brief Copies pixels from an existing image with a given offset.
     void setSubImage(const Size& offset, const Image& image) { setSubImage(offset, image, Bounds(image.size())); }
 
+    /// @brief Copies all pixels of a view, placing its first pixel at the given offset.
+    void setSubImage(const Size& offset, const View& view)
+    {
+        auto row_size = view.byteWidth();
+        forEachRow(Bounds(view.size()),
+                   [&](const Size& pos) { std::memcpy(&(*this)[pos + offset], &view[pos], row_size); });
+    }
+
+    /// @brief Returns the next smaller mipmap level with half the size (rounded up), averaging 2x2 pixels each.
+    /// @remark For odd sizes, the missing pixels past the edge are taken from the opposite side if wrap is set, which
+    /// keeps tiling images seamless, and are clamped to the edge otherwise.
+    /// @remark Works on the raw components of whole rows, so that the inner loop can be vectorized by the compiler.
+    Image downsample(bool wrap) const
+    {
+        static_assert(dim == 2, "Only two-dimensional images can be downsampled.");
+        static_assert(pixel_type <= PixelType::FLOAT && pixel_type != PixelType::HALF_FLOAT,
+                      "Downsampling requires a plain integer or float per pixel component.");
+
+        using Component = typename Pixel::value_type;
+        using Sum = std::conditional_t<std::is_floating_point_v<Component>,
+                                       Component,
+                                       std::conditional_t<(sizeof(Component) < sizeof(int)), int, std::int64_t>>;
+        constexpr auto components = pixel_format_component_count_v<pixel_format>;
+
+        if (count() == 0)
+            return Image();
+
+        Image result;
+        result.size_ = Size((size_[0] + 1) / 2, (size_[1] + 1) / 2);
+        result.data_ = allocate(result.byteCount());
+
+        auto edge = [&](std::size_t pos, std::size_t size) { return pos < size ? pos : wrap ? 0 : size - 1; };
+        auto average = [](Sum a, Sum b, Sum c, Sum d) {
+            if constexpr (std::is_floating_point_v<Component>)
+                return static_cast<Component>((a + b + c + d) * Component{0.25});
+            else
+                return static_cast<Component>((a + b + c + d + 2) / 4);
+        };
+
+        auto full_width = size_[0] / 2;
+        auto last_x = edge(size_[0], size_[0]);
+        for (std::size_t y = 0; y < result.size_[1]; y++) {
+            auto top = reinterpret_cast<const Component*>(&(*this)[Size(0, 2 * y)]);
+            auto bottom = reinterpret_cast<const Component*>(&(*this)[Size(0, edge(2 * y + 1, size_[1]))]);
+            auto row = reinterpret_cast<Component*>(&result[Size(0, y)]);
+            for (std::size_t x = 0; x < full_width; x++) {
+                for (std::size_t c = 0; c < components; c++) {
+                    auto left = 2 * x * components + c;
+                    auto right = left + components;
+                    row[x * components + c] = average(top[left], top[right], bottom[left], bottom[right]);
+                }
+            }
+            if (size_[0] % 2 == 1) {
+                for (std::size_t c = 0; c < components; c++) {
+                    auto left = 2 * full_width * components + c;
+                    auto right = last_x * components + c;
+                    row[full_width * components + c] = average(top[left], top[right], bottom[left], bottom[right]);
+                }
+            }
+            result.clearPadding(Size(0, y));
+        }
+        return result;
+    }
+
     /// @brief Provides access to the raw underlying data, which can be used to provide OpenGL the data.
     void* data() { return data_.get(); }
 
@@ -176,6 +332,70 @@ public:
     explicit operator bool() const { return bool{data_}; }
 
 private:
+    /// @brief Allocates storage for the given number of bytes without initializing it.
+    /// @remark All constructors initialize every byte themselves, including the alignment padding of each row.
+    // TODO: C++20 replace with std::make_unique_for_overwrite
+    static std::unique_ptr<std::byte[]> allocate(std::size_t byte_count)
+    {
+        return std::unique_ptr<std::byte[]>(new std::byte[byte_count]);
+    }
+
+    /// @brief Zeroes the alignment padding at the end of the row with the given position.
+    void clearPadding(const Size& row_pos)
+    {
+        auto padding = alignedByteWidth() - byteWidth();
+        if (padding > 0)
+            std::memset(&data_[posToIndex(row_pos) + byteWidth()], 0, padding);
+    }
+
+    /// @brief Calls the given function with the position of the first pixel of each row in the bounds.
+    /// @remark Iterates y first, followed by z, etc., which matches the memory layout.
+    template <typename TRowFunction>
+    static void forEachRow(const Bounds& bounds, TRowFunction row_function)
+    {
+        for (std::size_t d = 0; d < dim; d++) {
+            if (bounds.low[d] >= bounds.high[d])
+                return;
+        }
+        auto pos = bounds.low;
+        while (true) {
+            row_function(pos);
+            std::size_t d = 1;
+            for (; d < dim; d++) {
+                if (++pos[d] < bounds.high[d])
+                    break;
+                pos[d] = bounds.low[d];
+            }
+            if (d == dim)
+                return;
+        }
+    }
+
+    /// @brief Calls the given function with the position of the first pixel of each row in the bounds, starting with
+    /// the last row.
+    template <typename TRowFunction>
+    static void forEachRowReversed(const Bounds& bounds, TRowFunction row_function)
+    {
+        for (std::size_t d = 0; d < dim; d++) {
+            if (bounds.low[d] >= bounds.high[d])
+                return;
+        }
+        auto pos = bounds.low;
+        for (std::size_t d = 1; d < dim; d++)
+            pos[d] = bounds.high[d] - 1;
+        while (true) {
+            row_function(pos);
+            std::size_t d = 1;
+            for (; d < dim; d++) {
+                if (pos[d]-- > bounds.low[d])
+                    break;
+                pos[d] = bounds.high[d] - 1;
+            }
+            if (d == dim)
+                return;
+        }
+    }
+
     /// @brief A helper function, which calculates the position offset of a single dimension.
     template <std::size_t v_first, std::size_t... v_indices>
     std::size_t posToIndexHelperMul(const Size& pos, std::index_sequence<v_indices...>) const
@@ -197,7 +417,7 @@ private:
     }
 
     Size size_;
-    std::unique_ptr<std::byte[]> data_ = count() > 0 ? std::make_unique<std::byte[]>(byteCount()) : nullptr;
+    std::unique_ptr<std::byte[]> data_ = count() > 0 ? allocate(byteCount()) : nullptr;
 };
 
 using Image1D = Image<1>;
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "dang-gl/General/MappedFile.h"
+#include "dang-gl/Image/Image.h"
+#include "dang-gl/global.h"
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+
+namespace dang::gl {
+
+/// @brief Decodes PNG images on a pool of worker threads.
+/// @remark The pixel format and row alignment are taken from the given image type.
+/// @remark Images are moved out of the returned futures, so that they can be passed on to e.g. a texture atlas on the
+/// GL thread without being copied.
+template <typename TImage = Image2D>
+class ImageLoader {
+public:
+    using Image = TImage;
+
+    /// @brief Starts the given number of worker threads.
+    /// @remark A thread count of zero uses the hardware concurrency.
+    explicit ImageLoader(std::size_t thread_count = 0)
+    {
+        if (thread_count == 0)
+            thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+        threads_.reserve(thread_count);
+        for (std::size_t i = 0; i < thread_count; i++)
+            threads_.emplace_back([this] { work(); });
+    }
+
+    /// @brief Finishes all queued images and stops the worker threads.
+    ~ImageLoader()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        condition_.notify_all();
+        for (auto& thread : threads_)
+            thread.join();
+    }
+
+    ImageLoader(const ImageLoader&) = delete;
+    ImageLoader(ImageLoader&&) = delete;
+    ImageLoader& operator=(const ImageLoader&) = delete;
+    ImageLoader& operator=(ImageLoader&&) = delete;
+
+    /// @brief Returns the number of worker threads.
+    std::size_t threadCount() const { return threads_.size(); }
+
+    /// @brief Queues the PNG file at the given path for decoding.
+    /// @remark Errors, like a missing file or an invalid PNG, are rethrown by the future as PNGError.
+    [[nodiscard]] std::future<Image> load(fs::path path)
+    {
+        return enqueue([path = std::move(path)] { return Image::loadFromPNG(path); });
+    }
+
+    /// @brief Queues the PNG in the given memory for decoding.
+    /// @remark The memory must stay alive until the future is ready.
+    // TODO: C++20 replace with std::span
+    [[nodiscard]] std::future<Image> load(const std::byte* data, std::size_t size)
+    {
+        return enqueue([data, size] { return Image::loadFromPNG(data, size); });
+    }
+
+    /// @brief Queues the PNG in the given memory mapped file for decoding, which is unmapped afterwards.
+    [[nodiscard]] std::future<Image> load(MappedFile file)
+    {
+        return enqueue([file = std::move(file)] { return Image::loadFromPNG(file); });
+    }
+
+    /// @brief Queues all PNG files at the given paths for decoding, returning futures in the same order.
+    [[nodiscard]] std::vector<std::future<Image>> load(const std::vector<fs::path>& paths)
+    {
+        std::vector<std::future<Image>> result;
+        result.reserve(paths.size());
+        for (const auto& path : paths)
+            result.push_back(load(path));
+        return result;
+    }
+
+private:
+    using Task = std::packaged_task<Image()>;
+
+    /// @brief Adds a new task to the queue and wakes up a single worker.
+    template <typename TFunction>
+    std::future<Image> enqueue(TFunction&& function)
+    {
+        Task task(std::forward<TFunction>(function));
+        auto future = task.get_future();
+        {
+            std::lock_guard lock(mutex_);
+            tasks_.push_back(std::move(task));
+        }
+        condition_.notify_one();
+        return future;
+    }
+
+    /// @brief Executes tasks until the loader is stopping and no tasks are left.
+    void work()
+    {
+        while (true) {
+            Task task;
+            {
+                std::unique_lock lock(mutex_);
+                condition_.wait(lock, [&] { return stopping_ || !tasks_.empty(); });
+                if (tasks_.empty())
+                    return;
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::deque<Task> tasks_;
+    bool stopping_ = false;
+    std::vector<std::thread> threads_;
+};
+
+} // namespace dang::gl
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "dang-gl/Image/Pixel.h"
+#include "dang-gl/Image/PixelFormat.h"
+#include "dang-gl/Image/PixelType.h"
+#include "dang-gl/global.h"
+
+#include "dang-math/bounds.h"
+#include "dang-math/vector.h"
+
+namespace dang::gl {
+
+/// @brief A non-owning, read-only view on a subsection of n-dimensional pixel data.
+/// @remark The underlying data uses the same row-major layout as Image, which is described by the full image size.
+/// @remark Views are cheap to copy and can be passed to OpenGL without copying the pixels, using the unpack row length
+/// and skip parameters.
+/// @remark The view is only valid as long as the underlying pixel data stays alive.
+template <std::size_t v_dim,
+          PixelFormat v_pixel_format = PixelFormat::RGBA,
+          PixelType v_pixel_type = PixelType::UNSIGNED_BYTE,
+          std::size_t v_row_alignment = 4>
+class ImageView {
+public:
+    static constexpr auto dim = v_dim;
+    static constexpr auto pixel_format = v_pixel_format;
+    static constexpr auto pixel_type = v_pixel_type;
+    static constexpr auto row_alignment = v_row_alignment;
+
+    using Pixel = Pixel<pixel_format, pixel_type>;
+    using Size = dmath::svec<dim>;
+    using Bounds = dmath::sbounds<dim>;
+
+    static_assert(row_alignment > 0);
+
+    /// @brief Initializes an empty view, which does not reference any data.
+    ImageView() = default;
+
+    /// @brief Initializes a view on the given bounds of pixel data with the specified full size.
+    ImageView(const void* data, const Size& image_size, const Bounds& bounds)
+        : data_(static_cast<const std::byte*>(data))
+        , image_size_(image_size)
+        , bounds_(bounds)
+    {
+        assert(bounds_.low.lessThanEqual(bounds_.high).all());
+        assert(bounds_.high.lessThanEqual(image_size_).all());
+    }
+
+    /// @brief Initializes a view on all of the given pixel data with the specified size.
+    ImageView(const void* data, const Size& image_size)
+        : ImageView(data, image_size, Bounds(image_size))
+    {}
+
+    /// @brief Returns the size of the view along each axis.
+    Size size() const { return bounds_.size(); }
+
+    /// @brief Returns the total count of pixels in the view.
+    std::size_t count() const { return size().product(); }
+
+    /// @brief Returns the bounds of the view inside of the underlying image.
+    const Bounds& bounds() const { return bounds_; }
+
+    /// @brief Returns the size of the underlying image, which determines the layout of the data.
+    const Size& imageSize() const { return image_size_; }
+
+    /// @brief The width of a single row of the view in bytes.
+    std::size_t byteWidth() const { return size()[0] * sizeof(Pixel); }
+
+    /// @brief The distance between two rows of the underlying image in bytes.
+    std::size_t rowStride() const
+    {
+        return (image_size_[0] * sizeof(Pixel) + row_alignment - 1) / row_alignment * row_alignment;
+    }
+
+    /// @brief Provides access for a single pixel at the given position, relative to the view.
+    const Pixel& operator[](const Size& pos) const
+    {
+        return *reinterpret_cast<const Pixel*>(data_ + posToIndex(bounds_.low + pos));
+    }
+
+    /// @brief Creates a new view on a subsection, relative to this view.
+    ImageView operator[](const Bounds& bounds) const
+    {
+        assert(bounds.high.lessThanEqual(size()).all());
+        return ImageView(data_, image_size_, Bounds(bounds_.low + bounds.low, bounds_.low + bounds.high));
+    }
+
+    /// @brief Provides access to the first pixel of the underlying image.
+    /// @remark Together with imageSize and bounds this is what OpenGL needs to unpack the pixels of the view.
+    const void* data() const { return data_; }
+
+    /// @brief Whether the view references any data.
+    explicit operator bool() const { return data_ != nullptr; }
+
+private:
+    /// @brief Converts the given pixel position of the underlying image into an index to the data.
+    std::size_t posToIndex(const Size& pos) const
+    {
+        auto index = pos[0] * sizeof(Pixel);
+        auto stride = rowStride();
+        for (std::size_t d = 1; d < dim; d++) {
+            index += pos[d] * stride;
+            stride *= image_size_[d];
+        }
+        return index;
+    }
+
+    const std::byte* data_ = nullptr;
+    Size image_size_;
+    Bounds bounds_;
+};
+
+using ImageView1D = ImageView<1>;
+using ImageView2D = ImageView<2>;
+using ImageView3D = ImageView<3>;
+
+} // namespace dang::gl
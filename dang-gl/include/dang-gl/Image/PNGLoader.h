@@ -33,6 +33,8 @@ public:
     PNGLoader();
     /// @brief Immediately calls init with the given stream.
     explicit PNGLoader(std::istream& stream);
+    /// @brief Immediately calls init with the given memory.
+    PNGLoader(const std::byte* data, std::size_t size);
     /// @brief Cleans up the libpng handles.
     ~PNGLoader();
 
@@ -45,6 +47,12 @@ public:
     /// @remark The same stream is reused for a likely read call and must therefore life long enough.
     void init(std::istream& stream);
 
+    /// @brief Initializes the info struct from a PNG in memory, e.g. from a MappedFile.
+    /// @remark Reads simply copy from and advance a pointer, avoiding any stream overhead.
+    /// @remark The memory is reused for a likely read call and must therefore life long enough.
+    // TODO: C++20 replace with std::span
+    void init(const std::byte* data, std::size_t size);
+
     /// @brief After initialization, returns the width and height of the image.
     dmath::svec2 size() const;
 
@@ -78,8 +86,13 @@ private:
     static void errorCallback(png_structp png_ptr, png_const_charp message);
     /// @brief Called by libpng for warning messages.
     static void warningCallback(png_structp png_ptr, png_const_charp message);
-    /// @brief Called by libpng to read a chunk of data from the PNG file.
+    /// @brief Called by libpng to read a chunk of data from the PNG stream.
     static void readCallback(png_structp png_ptr, png_bytep bytes, png_size_t size);
+    /// @brief Called by libpng to read a chunk of data from the PNG in memory.
+    static void memoryReadCallback(png_structp png_ptr, png_bytep bytes, png_size_t size);
+
+    /// @brief Reads the info struct, after the read function has been set.
+    void readInfo();
 
     /// @brief Used in initialization to check the libpng pointers.
     template <typename T>
@@ -130,6 +143,10 @@ private:
     bool initialized_ = false;
     bool read_ = false;
 
+    /// @brief The remaining memory, when reading from memory.
+    const std::byte* memory_ = nullptr;
+    const std::byte* memory_end_ = nullptr;
+
     dmath::svec2 size_;
 
     // Keep track of modifications, as png_read_update_info can only be called once after the first call.
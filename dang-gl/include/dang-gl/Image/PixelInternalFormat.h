@@ -5,6 +5,14 @@
 
 #include "dang-utils/enum.h"
 
+// S3TC is not part of core OpenGL, but supported by virtually all desktop GPUs.
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
 namespace dang::gl {
 
 /// @brief Formats, for how OpenGL stores its pixel data.
@@ -95,6 +103,8 @@ enum class PixelInternalFormat {
     COMPRESSED_SRGB_ALPHA_BPTC_UNORM,
     COMPRESSED_RGB_BPTC_SIGNED_FLOAT,
     COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT,
+    COMPRESSED_RGBA_S3TC_DXT1,
+    COMPRESSED_RGBA_S3TC_DXT5,
 
     // stencil formats
     STENCIL_INDEX1,
@@ -205,6 +215,8 @@ inline constexpr dutils::EnumArray<PixelInternalFormat, GLenum> gl_constants<Pix
     GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM,
     GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT,
     GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT,
+    GL_COMPRESSED_RGBA_S3TC_DXT1_EXT,
+    GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,
 
     // stencil formats
     GL_STENCIL_INDEX1,
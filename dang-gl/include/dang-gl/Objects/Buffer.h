@@ -29,6 +29,9 @@ public:
     /// @brief Binds the buffer to the correct target.
     void bind() const { objectContext().bind(v_target, handle()); }
 
+    /// @brief Unbinds the buffer, if it is currently bound to its target.
+    void release() const { objectContext().reset(v_target, handle()); }
+
 protected:
     BufferBase() = default;
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "dang-gl/Context/Context.h"
 #include "dang-gl/Objects/ObjectContext.h"
 #include "dang-gl/Objects/ObjectHandle.h"
 #include "dang-gl/Objects/ObjectType.h"
@@ -8,6 +9,11 @@
 
 namespace dang::gl {
 
+/// @brief Thrown, when a buffer cannot be bound to an indexed binding point, as all of them are in use.
+class BufferBindingError : public std::runtime_error {
+    using runtime_error::runtime_error;
+};
+
 /// @brief Specializes the context class for buffer objects.
 template <>
 class ObjectContext<ObjectType::Buffer> : public ObjectContextBase {
@@ -35,8 +41,29 @@ public:
         bound_buffers_[target] = {};
     }
 
+    /// @brief Binds the buffer to the first free uniform buffer binding point and returns it or throws a
+    /// BufferBindingError, if all binding points are occupied.
+    /// @remark The buffer stays bound to this binding point, until it is released again.
+    std::size_t bindUniformBuffer(Handle handle)
+    {
+        auto pos = std::find(uniform_buffers_.begin(), uniform_buffers_.end(), Handle{});
+        if (pos == uniform_buffers_.end())
+            throw BufferBindingError("Cannot bind uniform buffer, as all binding points are in use.");
+        auto binding_point = static_cast<std::size_t>(std::distance(uniform_buffers_.begin(), pos));
+        glBindBufferBase(GL_UNIFORM_BUFFER, static_cast<GLuint>(binding_point), handle.unwrap());
+        // Binding to an indexed binding point also binds to the generic binding point.
+        bound_buffers_[BufferTarget::UniformBuffer] = handle;
+        *pos = handle;
+        return binding_point;
+    }
+
+    /// @brief Makes the given uniform buffer binding point free for another buffer to use.
+    void releaseUniformBuffer(std::size_t binding_point) { uniform_buffers_[binding_point] = {}; }
+
 private:
     dutils::EnumArray<BufferTarget, Handle> bound_buffers_{};
+    // avoid accidental list initialization
+    std::vector<Handle> uniform_buffers_ = std::vector<Handle>(context()->max_uniform_buffer_bindings);
 };
 
 } // namespace dang::gl
@@ -0,0 +1,266 @@
+#pragma once
+
+#include "dang-gl/Math/MathTypes.h"
+#include "dang-gl/Objects/DataTypes.h"
+#include "dang-gl/global.h"
+
+#include "dang-math/matrix.h"
+#include "dang-math/vector.h"
+#include "dang-utils/enum.h"
+
+namespace dang::gl {
+
+/// @brief The standardized memory layouts of interface blocks.
+/// @remark Uniform blocks only support std140, while std430 is limited to shader storage blocks.
+enum class BufferLayout {
+    Std140,
+    Std430,
+
+    COUNT
+};
+
+} // namespace dang::gl
+
+namespace dang::utils {
+
+template <>
+struct enum_count<dang::gl::BufferLayout> : default_enum_count<dang::gl::BufferLayout> {};
+
+} // namespace dang::utils
+
+namespace dang::gl {
+
+/// @brief Has to be specialized for structs, which are stored in a buffer with a standardized layout.
+/// @remark The specialization lists all members of the struct in the order of the block in the shader:
+/// template <>
+/// struct buffer_layout_members<MyStruct> : buffer_layout_member_list<&MyStruct::a, &MyStruct::b> {};
+template <typename TStruct>
+struct buffer_layout_members;
+
+/// @brief A list of pointers to the members of a struct, used to specialize buffer_layout_members.
+template <auto... v_members>
+struct buffer_layout_member_list {
+    static constexpr auto members = std::tuple{v_members...};
+};
+
+/// @brief Describes where and how a single member of a struct is stored in a buffer.
+/// @remark Array and matrix strides are zero for non-array and non-matrix types, just like OpenGL reports them.
+struct BufferLayoutMember {
+    DataType type = DataType::None;
+    std::size_t count = 1;
+    std::size_t offset = 0;
+    std::size_t size = 0;
+    std::size_t array_stride = 0;
+    std::size_t matrix_stride = 0;
+};
+
+namespace detail {
+
+constexpr std::size_t alignBufferOffset(std::size_t offset, std::size_t alignment)
+{
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+/// @brief Splits a type into its scalar type, the number of rows and columns and an optional array length.
+template <typename T>
+struct buffer_layout_type {
+    static_assert(std::is_same_v<T, GLfloat> || std::is_same_v<T, GLdouble> || std::is_same_v<T, GLint> ||
+                      std::is_same_v<T, GLuint>,
+                  "Buffer layouts only support float, double, int and unsigned int based types.");
+
+    using Scalar = T;
+    static constexpr std::size_t rows = 1;
+    static constexpr std::size_t columns = 1;
+    static constexpr std::size_t count = 0;
+};
+
+template <typename T, std::size_t v_dim>
+struct buffer_layout_type<dmath::Vector<T, v_dim>> : buffer_layout_type<T> {
+    static_assert(v_dim >= 2 && v_dim <= 4, "Buffer layouts only support vectors with two to four components.");
+
+    static constexpr std::size_t rows = v_dim;
+};
+
+template <typename T, std::size_t v_cols, std::size_t v_rows>
+struct buffer_layout_type<dmath::Matrix<T, v_cols, v_rows>> : buffer_layout_type<dmath::Vector<T, v_rows>> {
+    static_assert(std::is_floating_point_v<T>, "Buffer layouts only support float and double matrices.");
+    static_assert(v_cols >= 2 && v_cols <= 4, "Buffer layouts only support matrices with two to four columns.");
+
+    static constexpr std::size_t columns = v_cols;
+};
+
+template <typename T, std::size_t v_count>
+struct buffer_layout_type<std::array<T, v_count>> : buffer_layout_type<T> {
+    static_assert(buffer_layout_type<T>::count == 0, "Buffer layouts do not support arrays of arrays.");
+
+    static constexpr std::size_t count = v_count;
+};
+
+/// @brief Returns the matching GLSL data type for the given scalar type, number of rows and columns.
+template <typename TScalar>
+constexpr DataType bufferLayoutDataType(std::size_t rows, std::size_t columns)
+{
+    if (columns == 1) {
+        constexpr std::size_t scalar_index = std::is_same_v<TScalar, GLfloat>    ? 0
+                                             : std::is_same_v<TScalar, GLdouble> ? 1
+                                             : std::is_same_v<TScalar, GLint>    ? 2
+                                                                                 : 3;
+        constexpr DataType types[4][4] = {{DataType::Float, DataType::Vec2, DataType::Vec3, DataType::Vec4},
+                                          {DataType::Double, DataType::DVec2, DataType::DVec3, DataType::DVec4},
+                                          {DataType::Int, DataType::IVec2, DataType::IVec3, DataType::IVec4},
+                                          {DataType::UInt, DataType::UVec2, DataType::UVec3, DataType::UVec4}};
+        return types[scalar_index][rows - 1];
+    }
+    constexpr DataType float_types[3][3] = {{DataType::Mat2, DataType::Mat2x3, DataType::Mat2x4},
+                                            {DataType::Mat3x2, DataType::Mat3, DataType::Mat3x4},
+                                            {DataType::Mat4x2, DataType::Mat4x3, DataType::Mat4}};
+    constexpr DataType double_types[3][3] = {{DataType::DMat2, DataType::DMat2x3, DataType::DMat2x4},
+                                             {DataType::DMat3x2, DataType::DMat3, DataType::DMat3x4},
+                                             {DataType::DMat4x2, DataType::DMat4x3, DataType::DMat4}};
+    if constexpr (std::is_same_v<TScalar, GLdouble>)
+        return double_types[columns - 2][rows - 2];
+    else
+        return float_types[columns - 2][rows - 2];
+}
+
+/// @brief Calculates alignment, size and strides of a type for the given layout.
+/// @remark Matrices are stored as arrays of their columns. Besides three component vectors being aligned like four
+/// component vectors, std140 additionally rounds the alignment of arrays and matrix columns up to that of a vec4.
+template <BufferLayout v_layout, typename T>
+struct buffer_layout_info {
+    using Type = buffer_layout_type<T>;
+
+    static constexpr bool std140 = v_layout == BufferLayout::Std140;
+    static constexpr std::size_t vec4_alignment = 4 * sizeof(GLfloat);
+    static constexpr std::size_t scalar_size = sizeof(typename Type::Scalar);
+    static constexpr std::size_t column_alignment = scalar_size * (Type::rows == 3 ? 4 : Type::rows);
+
+    static constexpr std::size_t matrix_stride =
+        Type::columns == 1 ? 0 : std140 ? alignBufferOffset(column_alignment, vec4_alignment) : column_alignment;
+    static constexpr std::size_t element_alignment = Type::columns == 1 ? column_alignment : matrix_stride;
+    static constexpr std::size_t element_size =
+        Type::columns == 1 ? scalar_size * Type::rows : Type::columns * matrix_stride;
+
+    static constexpr std::size_t array_alignment =
+        std140 ? alignBufferOffset(element_alignment, vec4_alignment) : element_alignment;
+    static constexpr std::size_t array_stride =
+        Type::count == 0 ? 0 : alignBufferOffset(element_size, array_alignment);
+
+    static constexpr std::size_t alignment = Type::count == 0 ? element_alignment : array_alignment;
+    static constexpr std::size_t size = Type::count == 0 ? element_size : Type::count * array_stride;
+    static constexpr std::size_t count = Type::count == 0 ? 1 : Type::count;
+    static constexpr DataType type = bufferLayoutDataType<typename Type::Scalar>(Type::rows, Type::columns);
+};
+
+template <typename T>
+struct buffer_layout_member_pointer;
+
+template <typename TStruct, typename T>
+struct buffer_layout_member_pointer<T TStruct::*> {
+    using Struct = TStruct;
+    using Type = T;
+};
+
+template <typename TStruct>
+inline constexpr std::size_t buffer_layout_member_count =
+    std::tuple_size_v<std::remove_const_t<decltype(buffer_layout_members<TStruct>::members)>>;
+
+template <typename TStruct, std::size_t v_index>
+using buffer_layout_member_type = typename buffer_layout_member_pointer<
+    std::tuple_element_t<v_index, std::remove_const_t<decltype(buffer_layout_members<TStruct>::members)>>>::Type;
+
+template <BufferLayout v_layout, typename T>
+constexpr BufferLayoutMember placeBufferLayoutMember(std::size_t& offset)
+{
+    using Info = buffer_layout_info<v_layout, T>;
+    offset = alignBufferOffset(offset, Info::alignment);
+    BufferLayoutMember result{Info::type, Info::count, offset, Info::size, Info::array_stride, Info::matrix_stride};
+    offset += Info::size;
+    return result;
+}
+
+template <BufferLayout v_layout, typename TStruct, std::size_t... v_indices>
+constexpr auto bufferLayoutMembers(std::index_sequence<v_indices...>)
+{
+    std::array<BufferLayoutMember, sizeof...(v_indices)> result{};
+    std::size_t offset = 0;
+    ((result[v_indices] =
+          placeBufferLayoutMember<v_layout, buffer_layout_member_type<TStruct, v_indices>>(offset)),
+     ...);
+    return result;
+}
+
+/// @brief Returns the size of the whole struct, which is rounded up to its alignment like nested structs.
+template <BufferLayout v_layout, typename TStruct, std::size_t... v_indices>
+constexpr std::size_t bufferLayoutSize(std::index_sequence<v_indices...> indices)
+{
+    std::size_t alignment = v_layout == BufferLayout::Std140 ? 4 * sizeof(GLfloat) : 1;
+    ((alignment = std::max(
+          alignment, buffer_layout_info<v_layout, buffer_layout_member_type<TStruct, v_indices>>::alignment)),
+     ...);
+    std::size_t end = 0;
+    for (const auto& member : bufferLayoutMembers<v_layout, TStruct>(indices))
+        end = std::max(end, member.offset + member.size);
+    return alignBufferOffset(end, alignment);
+}
+
+/// @brief Copies a single value into the buffer, where matrices are written column by column.
+template <BufferLayout v_layout, typename T>
+void writeBufferLayoutElement(const T& value, std::byte* data)
+{
+    using Info = buffer_layout_info<v_layout, T>;
+    if constexpr (Info::Type::columns == 1) {
+        std::memcpy(data, &value, sizeof(T));
+    }
+    else {
+        for (std::size_t column = 0; column < Info::Type::columns; column++)
+            std::memcpy(data + column * Info::matrix_stride, &value[column], sizeof(value[column]));
+    }
+}
+
+template <BufferLayout v_layout, typename T>
+void writeBufferLayoutMember(const T& value, const BufferLayoutMember& member, std::byte* data)
+{
+    if constexpr (buffer_layout_type<T>::count == 0) {
+        writeBufferLayoutElement<v_layout>(value, data + member.offset);
+    }
+    else {
+        for (std::size_t index = 0; index < value.size(); index++)
+            writeBufferLayoutElement<v_layout>(value[index], data + member.offset + index * member.array_stride);
+    }
+}
+
+} // namespace detail
+
+/// @brief Calculates the layout of a struct at compile time, which has to specialize buffer_layout_members.
+/// @remark The struct itself can use any layout, as members are copied to their correct offset one by one.
+template <typename TStruct, BufferLayout v_layout = BufferLayout::Std140>
+struct BufferStructLayout {
+    static constexpr auto member_count = detail::buffer_layout_member_count<TStruct>;
+
+    /// @brief The layout of each member in the same order as listed in buffer_layout_members.
+    static constexpr auto members =
+        detail::bufferLayoutMembers<v_layout, TStruct>(std::make_index_sequence<member_count>());
+
+    /// @brief The total size of the struct in the buffer, including padding at the end.
+    static constexpr std::size_t size =
+        detail::bufferLayoutSize<v_layout, TStruct>(std::make_index_sequence<member_count>());
+
+    /// @brief Writes all members of the given value to their offsets, leaving any padding untouched.
+    static void write(const TStruct& value, std::byte* data)
+    {
+        write(value, data, std::make_index_sequence<member_count>());
+    }
+
+private:
+    template <std::size_t... v_indices>
+    static void write(const TStruct& value, std::byte* data, std::index_sequence<v_indices...>)
+    {
+        constexpr auto& member_pointers = buffer_layout_members<TStruct>::members;
+        (detail::writeBufferLayoutMember<v_layout>(
+             value.*std::get<v_indices>(member_pointers), members[v_indices], data),
+         ...);
+    }
+};
+
+} // namespace dang::gl
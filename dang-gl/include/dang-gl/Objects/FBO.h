@@ -116,6 +116,28 @@ public:
     bool isAttached(AttachmentPoint attachment_point) const;
     /// @brief Attaches the given renderbuffer to the specified attachment point.
     void attach(const RBO& rbo, AttachmentPoint attachment_point);
+    /// @brief Attaches the given mipmap level of a 2D texture to the specified attachment point.
+    template <typename TTexture>
+    void attach(const TTexture& texture, AttachmentPoint attachment_point, GLint mipmap_level = 0)
+    {
+        auto target = FramebufferTarget::DrawFramebuffer;
+        bind(target);
+        glFramebufferTexture(toGLConstant(target), attachment_point, texture.handle().unwrap(), mipmap_level);
+        updateSize(mipmapSize(texture.size(), mipmap_level));
+        updateAttachmentPoint(attachment_point, true);
+    }
+    /// @brief Attaches a single layer of the given mipmap level of an array or 3D texture to the specified attachment
+    /// point.
+    template <typename TTexture>
+    void attachLayer(const TTexture& texture, AttachmentPoint attachment_point, GLint layer, GLint mipmap_level = 0)
+    {
+        auto target = FramebufferTarget::DrawFramebuffer;
+        bind(target);
+        glFramebufferTextureLayer(
+            toGLConstant(target), attachment_point, texture.handle().unwrap(), mipmap_level, layer);
+        updateSize(mipmapSize(texture.size(), mipmap_level));
+        updateAttachmentPoint(attachment_point, true);
+    }
     /// @brief Detaches the current renderbuffer or texture from the specified attachment point.
     void detach(AttachmentPoint attachment_point);
 
@@ -135,10 +157,24 @@ public:
     void clearDefault(BufferMask mask = BufferMask::ALL);
 
     void blitFrom(const FBO& other, BufferMask mask = BufferMask::ALL, BlitFilter filter = BlitFilter::Nearest);
+    /// @brief Blits the given rectangle of another framebuffer into a rectangle of this framebuffer.
+    void blitFrom(const FBO& other,
+                  const ibounds2& src_rect,
+                  const ibounds2& dst_rect,
+                  BufferMask mask = BufferMask::ALL,
+                  BlitFilter filter = BlitFilter::Nearest);
     void blitFromDefault(BufferMask mask = BufferMask::ALL, BlitFilter filter = BlitFilter::Nearest);
     void blitToDefault(BufferMask mask = BufferMask::ALL, BlitFilter filter = BlitFilter::Nearest) const;
 
 private:
+    /// @brief Returns the width and height of the given mipmap level for a texture of the given size.
+    template <std::size_t v_dim>
+    static svec2 mipmapSize(const svec<v_dim>& size, GLint mipmap_level)
+    {
+        static_assert(v_dim >= 2, "Only textures with at least two dimensions can be attached.");
+        return {std::max(size.x() >> mipmap_level, 1), std::max(size.y() >> mipmap_level, 1)};
+    }
+
     /// @brief Used to keep track of the smallest width and height.
     void updateSize(svec2 size);
     /// @brief Updates the given attachment point to being active or not.
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "dang-gl/Objects/Buffer.h"
+#include "dang-gl/Objects/ObjectType.h"
+#include "dang-gl/global.h"
+
+namespace dang::gl {
+
+/// @brief A pixel buffer object, which serves as the source of texture uploads.
+/// @remark While the buffer is bound, the data pointer of texture uploads is interpreted as a byte offset into it.
+class PBO : public BufferBase<BufferTarget::PixelUnpackBuffer> {
+public:
+    PBO(EmptyObject)
+        : BufferBase<BufferTarget::PixelUnpackBuffer>(empty_object)
+    {}
+
+    /// @brief Allocates uninitialized storage of the given size in bytes, which is written once per upload.
+    explicit PBO(std::size_t size);
+
+    ~PBO() = default;
+
+    PBO(const PBO&) = delete;
+    PBO(PBO&&) = default;
+    PBO& operator=(const PBO&) = delete;
+    PBO& operator=(PBO&&) = default;
+
+    /// @brief Returns the size of the buffer in bytes.
+    std::size_t size() const { return size_; }
+
+    /// @brief Maps the given range for writing, without waiting for pending uploads from the buffer to finish.
+    /// @remark The caller has to make sure, that the range is no longer in use, e.g. by waiting on a fence.
+    std::byte* mapRange(std::size_t offset, std::size_t size);
+
+    /// @brief Unmaps the buffer again, which is required before uploading from it.
+    void unmap();
+
+private:
+    std::size_t size_ = 0;
+};
+
+} // namespace dang::gl
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "dang-gl/General/GLConstants.h"
+#include "dang-gl/Objects/BufferLayout.h"
 #include "dang-gl/Objects/DataTypes.h"
 #include "dang-gl/Objects/Object.h"
 #include "dang-gl/Objects/ObjectContext.h"
@@ -160,6 +161,8 @@ class ShaderUniformBase : public ShaderVariable {
 public:
     /// @brief Initializes a shader uniform wrapper with the given introspection information.
     ShaderUniformBase(const Program& program, GLint count, DataType type, std::string name);
+    /// @brief Initializes a shader uniform wrapper with an already known location.
+    ShaderUniformBase(const Program& program, GLint count, DataType type, std::string name, GLint location);
     /// @brief Virtual destructor for polymorphism.
     virtual ~ShaderUniformBase() {}
 
@@ -213,6 +216,80 @@ private:
 
 using ShaderUniformSampler = ShaderUniform<int>;
 
+/// @brief A typed handle to a uniform of a specific program, which is resolved once using Program::resolve.
+/// @remark Accessing a uniform through its handle is a plain array access without any name lookup or type check.
+/// @remark The handle also remembers the uniform it was resolved to, which lets debug builds assert, that it is only
+/// used with the program that resolved it.
+template <typename T>
+class UniformHandle {
+public:
+    friend class Program;
+
+    /// @brief Creates an unresolved handle, which cannot be used to access a uniform.
+    UniformHandle() = default;
+
+    /// @brief The index of the uniform in the list of resolved uniforms of the program.
+    std::size_t index() const { return index_; }
+
+    /// @brief Whether the handle was resolved.
+    explicit operator bool() const { return index_ != invalid_index; }
+
+private:
+    static constexpr auto invalid_index = std::numeric_limits<std::size_t>::max();
+
+    UniformHandle(std::size_t index, const ShaderUniformBase* uniform)
+        : index_(index)
+        , uniform_(uniform)
+    {}
+
+    std::size_t index_ = invalid_index;
+    const ShaderUniformBase* uniform_ = nullptr;
+};
+
+/// @brief A single member of a uniform block, as reported by shader introspection.
+struct ShaderUniformBlockMember {
+    std::string name;
+    BufferLayoutMember layout;
+};
+
+/// @brief An active uniform block of a program, which sources its values from a bound uniform buffer.
+class ShaderUniformBlock {
+public:
+    /// @brief Initializes a uniform block wrapper with the given introspection information and queries its current
+    /// binding point.
+    /// @remark The members are expected to be sorted by their offset.
+    ShaderUniformBlock(const Program& program,
+                       GLuint index,
+                       std::string name,
+                       std::size_t data_size,
+                       std::vector<ShaderUniformBlockMember> members);
+
+    /// @brief The index of the block in the program.
+    GLuint index() const;
+    /// @brief The name of the block.
+    const std::string& name() const;
+    /// @brief The minimum size in bytes of a buffer, which is bound to the block.
+    std::size_t dataSize() const;
+    /// @brief The members of the block, sorted by their offset.
+    const std::vector<ShaderUniformBlockMember>& members() const;
+
+    /// @brief Throws a ShaderUniformError, if the given layout does not match the layout of the block.
+    void validate(const BufferLayoutMember* members, std::size_t member_count, std::size_t size) const;
+
+    /// @brief The binding point, from which the block sources its values.
+    GLuint bindingPoint() const;
+    /// @brief Lets the block source its values from the given binding point, if it doesn't already.
+    void setBindingPoint(GLuint binding_point);
+
+private:
+    ObjectHandle<ObjectType::Program> program_;
+    GLuint index_;
+    std::string name_;
+    std::size_t data_size_;
+    std::vector<ShaderUniformBlockMember> members_;
+    GLuint binding_point_;
+};
+
 /// @brief Contains the attribute order, stride and also supports instance division.
 struct AttributeOrder {
     std::vector<std::reference_wrapper<ShaderAttribute>> attributes;
@@ -280,6 +357,24 @@ public:
     /// @remark Will throw ShaderUniformError if the type or count doesn't match.
     ShaderUniformSampler& uniformSampler(const std::string& name, GLint count = 1);
 
+    /// @brief Looks up a uniform once and returns a handle, which stays valid for the lifetime of the program.
+    /// @remark Resolving the same uniform multiple times returns the same handle.
+    /// @remark Searches all previously resolved uniforms, so it should be called once up front and not every frame.
+    /// @remark Will throw ShaderUniformError if the type or count doesn't match.
+    template <typename T>
+    UniformHandle<T> resolve(const std::string& name, GLint count = 1);
+
+    /// @brief Returns the wrapper of a previously resolved uniform without looking it up by name.
+    /// @remark The handle must have been resolved by this program, which is only checked in debug builds.
+    template <typename T>
+    ShaderUniform<T>& uniform(UniformHandle<T> handle);
+    /// @brief Returns the wrapper of a previously resolved uniform without looking it up by name.
+    template <typename T>
+    const ShaderUniform<T>& uniform(UniformHandle<T> handle) const;
+
+    /// @brief Returns the uniform block with the given name or nullptr, if the block is missing or optimized.
+    ShaderUniformBlock* uniformBlock(const std::string& name);
+
 private:
     using ShaderHandle = ObjectHandle<ObjectType::Shader>;
 
@@ -300,7 +395,10 @@ private:
     /// @brief Queries all attributes after the program has been linked successfully.
     void loadAttributeLocations();
     /// @brief Queries all uniforms after the program has been linked successfully.
+    /// @remark Members of uniform blocks are skipped, as their values are sourced from a buffer.
     void loadUniformLocations();
+    /// @brief Queries all uniform blocks and the layout of their members after the program has been linked.
+    void loadUniformBlocks();
     /// @brief Sets the order of attributes, which should be the order of the Data structs, used in the VBO.
     void setAttributeOrder(const AttributeNames& attribute_order,
                            const InstancedAttributeNames& instanced_attribute_order);
@@ -309,6 +407,8 @@ private:
     std::map<std::string, std::string> includes_;
     std::map<std::string, ShaderAttribute> attributes_;
     std::map<std::string, std::unique_ptr<ShaderUniformBase>> uniforms_;
+    std::vector<ShaderUniformBase*> resolved_uniforms_;
+    std::map<std::string, ShaderUniformBlock> uniform_blocks_;
     AttributeOrder attribute_order_;
     std::vector<AttributeOrder> instanced_attribute_order_;
 };
@@ -342,7 +442,7 @@ inline ShaderUniform<T>::ShaderUniform(const Program& program, GLint count, Data
 
 template <typename T>
 inline ShaderUniform<T>::ShaderUniform(const Program& program, GLint count, std::string name)
-    : ShaderUniformBase(program, count, DataType::None, std::move(name))
+    : ShaderUniformBase(program, count, DataType::None, std::move(name), -1)
     , values_(count)
 {}
 
@@ -367,7 +467,7 @@ inline void ShaderUniform<T>::set(const T& value, GLint index)
 {
     if (value == values_[index])
         return;
-    force(value);
+    force(value, index);
 }
 
 template <typename T>
@@ -411,4 +511,30 @@ inline ShaderUniform<T>& Program::uniform(const std::string& name, GLint count)
     throw ShaderUniformError("Shader-Uniform type does not match.");
 }
 
+template <typename T>
+inline UniformHandle<T> Program::resolve(const std::string& name, GLint count)
+{
+    ShaderUniformBase* shader_uniform = &uniform<T>(name, count);
+    auto pos = std::find(resolved_uniforms_.begin(), resolved_uniforms_.end(), shader_uniform);
+    if (pos != resolved_uniforms_.end())
+        return UniformHandle<T>(static_cast<std::size_t>(pos - resolved_uniforms_.begin()), shader_uniform);
+    resolved_uniforms_.push_back(shader_uniform);
+    return UniformHandle<T>(resolved_uniforms_.size() - 1, shader_uniform);
+}
+
+template <typename T>
+inline ShaderUniform<T>& Program::uniform(UniformHandle<T> handle)
+{
+    assert(handle.index() < resolved_uniforms_.size() && resolved_uniforms_[handle.index()] == handle.uniform_);
+    // The type was already checked by resolve.
+    return static_cast<ShaderUniform<T>&>(*resolved_uniforms_[handle.index()]);
+}
+
+template <typename T>
+inline const ShaderUniform<T>& Program::uniform(UniformHandle<T> handle) const
+{
+    assert(handle.index() < resolved_uniforms_.size() && resolved_uniforms_[handle.index()] == handle.uniform_);
+    return static_cast<const ShaderUniform<T>&>(*resolved_uniforms_[handle.index()]);
+}
+
 } // namespace dang::gl
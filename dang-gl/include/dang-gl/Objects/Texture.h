@@ -1,9 +1,11 @@
 #pragma once
 
+#include "dang-gl/Image/BlockCompression.h"
 #include "dang-gl/Image/Image.h"
 #include "dang-gl/Image/PixelFormat.h"
 #include "dang-gl/Image/PixelInternalFormat.h"
 #include "dang-gl/Image/PixelType.h"
+#include "dang-gl/Objects/FBO.h"
 #include "dang-gl/Objects/Object.h"
 #include "dang-gl/Objects/ObjectContext.h"
 #include "dang-gl/Objects/ObjectHandle.h"
@@ -226,6 +228,14 @@ inline constexpr auto& glTexSubImage<2> = glTexSubImage2D;
 template <>
 inline constexpr auto& glTexSubImage<3> = glTexSubImage3D;
 
+template <std::size_t v_dim>
+inline constexpr auto glCompressedTexSubImage = nullptr;
+
+template <>
+inline constexpr auto& glCompressedTexSubImage<2> = glCompressedTexSubImage2D;
+template <>
+inline constexpr auto& glCompressedTexSubImage<3> = glCompressedTexSubImage3D;
+
 /// @brief A base for all textures with template parameters for the dimension and texture target.
 template <std::size_t v_dim, TextureTarget v_target>
 class TextureBaseTyped : public TextureBase {
@@ -243,9 +253,68 @@ public:
     void modify(const Image<v_image_dim, v_pixel_format, v_pixel_type, v_row_alignment>& image,
                 ivec<v_dim> offset = {},
                 GLint mipmap_level = 0)
+    {
+        modify(image.view(), offset, mipmap_level);
+    }
+
+    /// @brief Modifies a part of the stored texture using a view, without copying its pixels first.
+    template <std::size_t v_image_dim, PixelFormat v_pixel_format, PixelType v_pixel_type, std::size_t v_row_alignment>
+    void modify(const ImageView<v_image_dim, v_pixel_format, v_pixel_type, v_row_alignment>& image_view,
+                ivec<v_dim> offset = {},
+                GLint mipmap_level = 0)
     {
         this->bind();
-        subImage(std::make_index_sequence<v_dim>(), image, offset, mipmap_level);
+        subImage(std::make_index_sequence<v_dim>(), image_view, offset, mipmap_level);
+    }
+
+    /// @brief Modifies a part of the stored texture using an already block compressed image.
+    void modifyCompressed(const CompressedImage& image, ivec<v_dim> offset = {}, GLint mipmap_level = 0)
+    {
+        modifyCompressed(image.view(), offset, mipmap_level);
+    }
+
+    /// @brief Modifies a part of the stored texture using already block compressed data.
+    /// @remark The texture has to use the internal format of the compression and the offset has to be a multiple of
+    /// the block size, unless the image reaches the edge of the mipmap level.
+    /// @remark For array and 3D textures, the image modifies a single layer at the z-component of the offset.
+    /// @remark Cube maps are not supported, as their faces have to be addressed using separate targets.
+    void modifyCompressed(const CompressedImageView& image, ivec<v_dim> offset = {}, GLint mipmap_level = 0)
+    {
+        static_assert(v_dim >= 2, "Block compression requires at least two dimensions.");
+        static_assert(v_target != TextureTarget::TextureCubeMap,
+                      "Compressed cube map faces cannot be modified through the cube map target.");
+        static_assert(v_target != TextureTarget::TextureRectangle, "Rectangle textures cannot be block compressed.");
+        assert(image.size().lessThanEqual(std::numeric_limits<GLsizei>::max()).all());
+        assert(image.byteCount() <= static_cast<std::size_t>(std::numeric_limits<GLsizei>::max()));
+        this->bind();
+        auto format = toGLConstant(block_compression_internal_formats[image.compression()]);
+        auto width = static_cast<GLsizei>(image.size().x());
+        auto height = static_cast<GLsizei>(image.size().y());
+        auto byte_count = static_cast<GLsizei>(image.byteCount());
+        if constexpr (v_dim == 2) {
+            glCompressedTexSubImage<2>(toGLConstant(v_target),
+                                       mipmap_level,
+                                       offset.x(),
+                                       offset.y(),
+                                       width,
+                                       height,
+                                       format,
+                                       byte_count,
+                                       image.data());
+        }
+        else {
+            glCompressedTexSubImage<3>(toGLConstant(v_target),
+                                       mipmap_level,
+                                       offset.x(),
+                                       offset.y(),
+                                       offset.z(),
+                                       width,
+                                       height,
+                                       1,
+                                       format,
+                                       byte_count,
+                                       image.data());
+        }
     }
 
     /// @brief Regenerates all mipmaps from the top level.
@@ -255,6 +324,73 @@ public:
         glGenerateMipmap(toGLConstant(v_target));
     }
 
+    /// @brief Copies a box of texels from the given texture into this texture, without a roundtrip to the CPU.
+    /// @remark Uses glCopyImageSubData if OpenGL 4.3 is supported, otherwise falls back to blitting each layer using
+    /// two temporary framebuffers, which only works for color-renderable formats.
+    /// @exception TextureError if the fallback is required, but the texture is neither 2D, 2D array nor 3D.
+    void copyFrom(const TextureBaseTyped& source,
+                  ivec<v_dim> src_offset,
+                  ivec<v_dim> dst_offset,
+                  svec<v_dim> size,
+                  GLint src_mipmap_level = 0,
+                  GLint dst_mipmap_level = 0)
+    {
+        ivec3 src;
+        ivec3 dst;
+        svec3 copy_size(1);
+        for (std::size_t i = 0; i < v_dim; i++) {
+            src[i] = src_offset[i];
+            dst[i] = dst_offset[i];
+            copy_size[i] = size[i];
+        }
+
+        auto& state = this->context().state();
+        if (state.supportsVersion(4, 3)) {
+            glCopyImageSubData(source.handle().unwrap(),
+                               toGLConstant(v_target),
+                               src_mipmap_level,
+                               src.x(),
+                               src.y(),
+                               src.z(),
+                               this->handle().unwrap(),
+                               toGLConstant(v_target),
+                               dst_mipmap_level,
+                               dst.x(),
+                               dst.y(),
+                               dst.z(),
+                               copy_size.x(),
+                               copy_size.y(),
+                               copy_size.z());
+            return;
+        }
+
+        constexpr bool layered = v_target == TextureTarget::Texture2DArray || v_target == TextureTarget::Texture3D;
+        if constexpr (layered || v_target == TextureTarget::Texture2D) {
+            // Blitting is affected by the scissor test.
+            auto scoped_state = state.scoped();
+            scoped_state->scissor_test = false;
+            FBO read_framebuffer;
+            FBO draw_framebuffer;
+            auto attachment = read_framebuffer.colorAttachment(0);
+            ibounds2 src_rect(src.xy(), src.xy() + ivec2(copy_size.xy()));
+            ibounds2 dst_rect(dst.xy(), dst.xy() + ivec2(copy_size.xy()));
+            for (GLint layer = 0; layer < copy_size.z(); layer++) {
+                if constexpr (layered) {
+                    read_framebuffer.attachLayer(source, attachment, src.z() + layer, src_mipmap_level);
+                    draw_framebuffer.attachLayer(*this, attachment, dst.z() + layer, dst_mipmap_level);
+                }
+                else {
+                    read_framebuffer.attach(source, attachment, src_mipmap_level);
+                    draw_framebuffer.attach(*this, attachment, dst_mipmap_level);
+                }
+                draw_framebuffer.blitFrom(read_framebuffer, src_rect, dst_rect, BufferMask::Color);
+            }
+        }
+        else {
+            throw TextureError("Copying between textures of this type requires OpenGL 4.3.");
+        }
+    }
+
     const vec4& borderColor() const { return border_color_; }
 
     void setBorderColor(const vec4& color)
@@ -442,27 +578,46 @@ protected:
     void setSize(svec<v_dim> size) { size_ = size; }
 
     /// @brief Calls glTexSubImage with the provided parameters and index sequence of the textures dimension.
+    /// @remark The layout of the underlying image is described using the unpack row length, image height and skip
+    /// parameters, so that views on subsections can be uploaded directly.
     template <std::size_t v_image_dim,
               PixelFormat v_pixel_format,
               PixelType v_pixel_type,
               std::size_t v_row_alignment,
               std::size_t... v_indices>
     void subImage(std::index_sequence<v_indices...>,
-                  const Image<v_image_dim, v_pixel_format, v_pixel_type, v_row_alignment>& image,
+                  const ImageView<v_image_dim, v_pixel_format, v_pixel_type, v_row_alignment>& image_view,
                   ivec<v_dim> offset = {},
                   GLint mipmap_level = 0)
     {
-        assert(image.size().lessThanEqual(std::numeric_limits<GLsizei>::max()).all());
+        assert(image_view.imageSize().lessThanEqual(std::numeric_limits<GLsizei>::max()).all());
         static_assert(v_row_alignment == 1 || v_row_alignment == 2 || v_row_alignment == 4 || v_row_alignment == 8,
                       "OpenGL only supports image data with row alignments of 1, 2, 4 or 8.");
-        context()->unpack_alignment = static_cast<GLint>(v_row_alignment);
+        const auto& image_size = image_view.imageSize();
+        const auto& low = image_view.bounds().low;
+        auto& state = this->context().state();
+        state.unpack_alignment = static_cast<GLint>(v_row_alignment);
+        state.unpack_row_length = static_cast<GLint>(image_size[0]);
+        state.unpack_skip_pixels = static_cast<GLint>(low[0]);
+        if constexpr (v_image_dim >= 2)
+            state.unpack_skip_rows = static_cast<GLint>(low[1]);
+        else
+            state.unpack_skip_rows = 0;
+        if constexpr (v_image_dim >= 3) {
+            state.unpack_image_height = static_cast<GLint>(image_size[1]);
+            state.unpack_skip_images = static_cast<GLint>(low[2]);
+        }
+        else {
+            state.unpack_image_height = 0;
+            state.unpack_skip_images = 0;
+        }
         glTexSubImage<v_dim>(toGLConstant(v_target),
                              mipmap_level,
                              offset[v_indices]...,
-                             static_cast<GLsizei>(v_indices < v_image_dim ? image.size()[v_indices] : 1)...,
+                             static_cast<GLsizei>(v_indices < v_image_dim ? image_view.size()[v_indices] : 1)...,
                              toGLConstant(v_pixel_format),
                              toGLConstant(v_pixel_type),
-                             image.data());
+                             image_view.data());
     }
 
 private:
@@ -553,10 +708,38 @@ public:
         this->bind();
         storage(
             std::make_index_sequence<v_dim>(), static_cast<svec<v_dim>>(image.size()), mipmap_levels, internal_format);
-        this->subImage(std::make_index_sequence<v_dim>(), image);
+        this->subImage(std::make_index_sequence<v_dim>(), image.view());
         glGenerateMipmap(toGLConstant(v_target));
     }
 
+    /// @brief Generates texture storage for the given block compressed mipmap chain and uploads all of its levels.
+    /// @remark Compressed formats cannot be rendered to, so mipmaps have to be compressed on the CPU as well, starting
+    /// with the full size image.
+    /// @exception std::invalid_argument if the chain is empty, mixes different compressions or sizes do not halve.
+    void generateCompressed(const std::vector<CompressedImage>& mipmaps)
+    {
+        static_assert(v_dim == 2, "Compressed mipmap chains are only supported for two-dimensional textures.");
+        if (mipmaps.empty())
+            throw std::invalid_argument("Compressed mipmap chain is empty.");
+        auto compression = mipmaps.front().compression();
+        auto size = mipmaps.front().size();
+        for (const auto& mipmap : mipmaps) {
+            if (mipmap.compression() != compression)
+                throw std::invalid_argument("Compressed mipmap chain mixes different compressions.");
+            if (mipmap.size() != size)
+                throw std::invalid_argument("Compressed mipmap chain does not halve in size.");
+            size = (size / 2).max(1);
+        }
+
+        this->bind();
+        storage(std::make_index_sequence<v_dim>(),
+                static_cast<svec<v_dim>>(mipmaps.front().size()),
+                static_cast<GLsizei>(mipmaps.size()),
+                block_compression_internal_formats[compression]);
+        for (std::size_t level = 0; level < mipmaps.size(); level++)
+            this->modifyCompressed(mipmaps[level], {}, static_cast<GLint>(level));
+    }
+
 protected:
     TextureBaseRegular(TextureBaseRegular&&) = default;
     TextureBaseRegular& operator=(TextureBaseRegular&&) = default;
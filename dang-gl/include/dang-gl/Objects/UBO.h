@@ -0,0 +1,94 @@
+#pragma once
+
+#include "dang-gl/Objects/Buffer.h"
+#include "dang-gl/Objects/BufferLayout.h"
+#include "dang-gl/Objects/ObjectType.h"
+#include "dang-gl/Objects/Program.h"
+#include "dang-gl/global.h"
+
+namespace dang::gl {
+
+/// @brief A uniform buffer object, which stores a single struct using the std140 layout.
+/// @remark The struct has to list its members by specializing buffer_layout_members.
+/// @remark The buffer occupies a uniform buffer binding point for its whole lifetime, which makes attaching it to the
+/// uniform blocks of any number of programs a one-time cost.
+template <typename T>
+class UBO : public BufferBase<BufferTarget::UniformBuffer> {
+public:
+    using Layout = BufferStructLayout<T, BufferLayout::Std140>;
+
+    UBO(EmptyObject)
+        : BufferBase<BufferTarget::UniformBuffer>(empty_object)
+    {}
+
+    /// @brief Allocates zero-initialized storage for the struct and binds it to a free binding point.
+    UBO()
+    {
+        bind();
+        glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(Layout::size), data_.data(), GL_DYNAMIC_DRAW);
+        binding_point_ = objectContext().bindUniformBuffer(handle());
+    }
+
+    /// @brief Frees the binding point for other uniform buffers to use.
+    ~UBO()
+    {
+        if (*this)
+            objectContext().releaseUniformBuffer(binding_point_);
+    }
+
+    UBO(const UBO&) = delete;
+    UBO(UBO&&) = default;
+    UBO& operator=(const UBO&) = delete;
+
+    /// @brief Frees the binding point of the replaced buffer, before taking over the other one.
+    UBO& operator=(UBO&& other) noexcept
+    {
+        if (this == &other)
+            return *this;
+        if (*this)
+            objectContext().releaseUniformBuffer(binding_point_);
+        BufferBase<BufferTarget::UniformBuffer>::operator=(std::move(other));
+        binding_point_ = other.binding_point_;
+        data_ = other.data_;
+        return *this;
+    }
+
+    /// @brief The binding point, which the buffer is bound to.
+    std::size_t bindingPoint() const { return binding_point_; }
+
+    /// @brief Lets the given uniform block source its values from this buffer.
+    /// @remark Will throw ShaderUniformError if the layout of the block doesn't match the struct.
+    void attach(ShaderUniformBlock& block) const
+    {
+        block.validate(Layout::members.data(), Layout::members.size(), Layout::size);
+        block.setBindingPoint(static_cast<GLuint>(binding_point_));
+    }
+
+    /// @brief Lets the uniform block with the given name source its values from this buffer.
+    /// @remark Will throw ShaderUniformError if the block is missing or its layout doesn't match the struct.
+    void attach(Program& program, const std::string& name) const
+    {
+        auto block = program.uniformBlock(name);
+        if (!block)
+            throw ShaderUniformError("Shader-Uniform-Block missing or optimized: " + name);
+        attach(*block);
+    }
+
+    /// @brief Packs the struct into the std140 layout and uploads it, if it differs from the previous upload.
+    void write(const T& value)
+    {
+        std::array<std::byte, Layout::size> data = data_;
+        Layout::write(value, data.data());
+        if (data == data_)
+            return;
+        data_ = data;
+        bind();
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, static_cast<GLsizeiptr>(Layout::size), data_.data());
+    }
+
+private:
+    std::size_t binding_point_ = 0;
+    std::array<std::byte, Layout::size> data_{};
+};
+
+} // namespace dang::gl
@@ -159,6 +159,9 @@ public:
     /// @brief Returns the element count of the VBO.
     std::size_t max_size() const { return vbo_.count(); }
 
+    /// @brief Returns a pointer to the mapped data, e.g. to construct a dmath::StridedSpan on a single attribute.
+    T* data() noexcept { return data_; }
+
     /// @brief Returns an iterator to the first element of the mapped data.
     iterator begin() noexcept { return iterator(data_); }
 
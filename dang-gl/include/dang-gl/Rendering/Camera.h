@@ -3,7 +3,10 @@
 #include "dang-gl/Context/Context.h"
 #include "dang-gl/Math/MathTypes.h"
 #include "dang-gl/Math/Transform.h"
+#include "dang-gl/Objects/BufferLayout.h"
 #include "dang-gl/Objects/Program.h"
+#include "dang-gl/Objects/UBO.h"
+#include "dang-gl/Rendering/RenderQueue.h"
 #include "dang-gl/global.h"
 
 #include "dang-utils/enum.h"
@@ -122,18 +125,32 @@ private:
     bounds3 clip_;
 };
 
+/// @brief The per-frame data of a camera, which is shared by all programs using a matching uniform block:
+/// layout(std140) uniform Camera { mat4 projection_matrix; mat2x4 view_transform; };
+struct CameraBlock {
+    mat4 projection_matrix;
+    mat2x4 view_transform;
+};
+
+template <>
+struct buffer_layout_members<CameraBlock>
+    : buffer_layout_member_list<&CameraBlock::projection_matrix, &CameraBlock::view_transform> {};
+
 /// @brief A simple struct for all the different uniform names, which a camera can write to.
+/// @remark Programs, which contain the uniform block, source the projection matrix and view transform from a buffer,
+/// that is written once per frame, instead of using the separate uniforms.
 struct CameraUniformNames {
     std::string projection_matrix;
     std::string model_transform;
     std::string view_transform;
     std::string model_view_transform;
+    std::string block;
 };
 
 /// @brief The default names for all camera related uniforms.
 // TODO: C++20 use named initializers { .name = value }
 inline const CameraUniformNames default_camera_uniform_names = {
-    "projection_matrix", "model_transform", "view_transform", "modelview_transform"};
+    "projection_matrix", "model_transform", "view_transform", "modelview_transform", "Camera"};
 
 /// @brief Contains references to camera related uniforms of a single GL-Program.
 class CameraUniforms {
@@ -143,6 +160,9 @@ public:
 
     /// @brief Returns the associated GL-Program for the collection of uniforms.
     Program& program() const;
+    /// @brief Returns the uniform block for the projection matrix and view transform or nullptr, if the program
+    /// doesn't use it.
+    ShaderUniformBlock* block() const;
 
     /// @brief Updates the content of the uniform for the projection matrix.
     void updateProjectionMatrix(const mat4& projection_matrix) const;
@@ -151,6 +171,7 @@ public:
 
 private:
     std::reference_wrapper<Program> program_;
+    ShaderUniformBlock* block_;
     std::reference_wrapper<ShaderUniform<mat4>> projection_uniform_;
     dutils::EnumArray<CameraTransformType, std::reference_wrapper<ShaderUniform<mat2x4>>> transform_uniforms_;
 };
@@ -184,16 +205,33 @@ public:
     void setCustomUniforms(Program& program, const CameraUniformNames& names);
 
     /// @brief Draws the given range of renderables, automatically updating the previously supplied uniforms.
+    /// @remark Renderables are sorted by their pass, program, textures, VAO and depth to reduce state changes.
+    /// @remark Renderables with an instance buffer are drawn in batches, which only update the model and model-view
+    /// uniforms for the first renderable of each batch.
     template <typename TRenderableIter>
     void render(TRenderableIter first, TRenderableIter last) const;
     /// @brief Draws the given collection of renderables, automatically updating the previously supplied uniforms.
     template <typename TRenderables>
     void render(const TRenderables& renderables) const;
 
+    /// @brief Returns the number of state changes and draw calls of the last call to render.
+    const RenderQueueStats& renderStats() const;
+
 private:
+    /// @brief Returns the uniforms for the given program, which are created the first time the program is drawn.
+    const CameraUniforms& uniformsFor(Program& program) const;
+
+    /// @brief Updates the projection matrix and view transform of newly added uniforms, either by attaching the
+    /// uniform block to the camera buffer or by forcing the separate uniforms.
+    void initUniforms(const CameraUniforms& uniforms) const;
+
     SharedProjectionProvider projection_provider_;
     SharedTransform transform_ = Transform::create();
     mutable std::vector<CameraUniforms> uniforms_;
+    mutable dquat view_transform_;
+    mutable CameraBlock block_;
+    mutable std::optional<UBO<CameraBlock>> buffer_;
+    mutable RenderQueue render_queue_;
 };
 
 template <typename TRenderableIter>
@@ -206,28 +244,38 @@ inline void Camera::render(TRenderableIter first, TRenderableIter last) const
 
     const auto& view_transform = transform_->fullTransform().inverseFast();
 
+    view_transform_ = view_transform;
+    block_ = {projection_provider_->matrix(), view_transform.toMatrix2x4()};
+    if (buffer_)
+        buffer_->write(block_);
+
     for (const auto& uniforms : uniforms_) {
-        uniforms.updateProjectionMatrix(projection_provider_->matrix());
+        if (uniforms.block())
+            continue;
+        uniforms.updateProjectionMatrix(block_.projection_matrix);
         uniforms.updateTransform(CameraTransformType::View, view_transform);
     }
 
+    render_queue_.clear();
     for (auto iter = first; iter != last; ++iter) {
         const auto& renderable = *iter;
-
         if (!renderable->isVisible())
             continue;
 
-        auto program_matches = [&](const CameraUniforms& uniforms) {
-            return &uniforms.program() == &renderable->program();
-        };
+        // The camera looks along the negative z-axis of view space.
+        const auto& model_transform = renderable->transform();
+        auto model_view_transform =
+            model_transform ? view_transform * model_transform->fullTransform() : view_transform;
+        render_queue_.push(*renderable, -model_view_transform.translation().z());
+    }
+    render_queue_.sort();
 
-        auto uniforms = std::find_if(uniforms_.begin(), uniforms_.end(), program_matches);
-        if (uniforms == uniforms_.end()) {
-            uniforms_.emplace_back(renderable->program());
-            uniforms = std::prev(uniforms_.end());
-        }
+    const CameraUniforms* uniforms = nullptr;
+    render_queue_.submit([&](const Renderable& renderable) {
+        if (!uniforms || &uniforms->program() != &renderable.program())
+            uniforms = &uniformsFor(renderable.program());
 
-        if (const auto& model_transform = renderable->transform()) {
+        if (const auto& model_transform = renderable.transform()) {
             uniforms->updateTransform(CameraTransformType::Model, model_transform->fullTransform());
             uniforms->updateTransform(CameraTransformType::ModelView,
                                       view_transform * model_transform->fullTransform());
@@ -236,9 +284,7 @@ inline void Camera::render(TRenderableIter first, TRenderableIter last) const
             uniforms->updateTransform(CameraTransformType::Model, dquat());
             uniforms->updateTransform(CameraTransformType::ModelView, view_transform);
         }
-
-        renderable->draw();
-    }
+    });
 }
 
 template <typename TRenderables>
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "dang-gl/Objects/Program.h"
+#include "dang-gl/Objects/VAO.h"
+#include "dang-gl/Objects/VBO.h"
+#include "dang-gl/Rendering/Renderable.h"
+#include "dang-gl/global.h"
+
+#include <unordered_map>
+
+namespace dang::gl {
+
+/// @brief The number of state changes and draw calls of the last submission of a render queue.
+struct RenderQueueStats {
+    std::size_t program_binds = 0;
+    std::size_t vertex_array_binds = 0;
+    std::size_t texture_binds = 0;
+    std::size_t draw_calls = 0;
+    /// @brief The number of objects, which were drawn in batches using instanced rendering.
+    std::size_t batched_objects = 0;
+};
+
+/// @brief A single renderable of a render queue together with its sort key.
+struct RenderQueueItem {
+    std::uint64_t key;
+    const Renderable* renderable;
+};
+
+/// @brief A range of consecutive sorted items, which is drawn using a single draw call.
+struct RenderQueueBatch {
+    std::size_t first;
+    std::size_t count;
+    /// @brief Whether the items share an instance buffer, which receives their model transforms.
+    bool instanced;
+};
+
+/// @brief Collects the renderables of a frame and sorts them, so that drawing them requires as few state changes as
+/// possible.
+/// @remark From the most to the least significant bits, sort keys consist of pass, program, texture set, VAO and
+/// depth, which draws opaque objects front to back. Transparent objects are sorted by their inverted depth right after
+/// the pass instead, as blending requires them to be drawn back to front.
+/// @remark Programs, texture sets and VAOs are numbered in the order they are pushed. Once more than 2^14 distinct
+/// values are pushed in a single frame, the remaining ones share the last number, which only makes sorting less
+/// effective.
+class RenderQueue {
+public:
+    static constexpr unsigned pass_bits = 2;
+    static constexpr unsigned state_bits = 14;
+    static constexpr unsigned depth_bits = 20;
+
+    static_assert(pass_bits + 3 * state_bits + depth_bits == 64);
+    static_assert(dutils::enum_count_v<RenderPass> <= 1 << pass_bits);
+
+    /// @brief Removes all items, but keeps the allocated memory for the next frame.
+    void clear();
+    /// @brief Adds a renderable with the given view space depth, which is the distance along the view direction.
+    /// @remark Objects behind the camera with a negative depth are treated as having a depth of zero.
+    void push(const Renderable& renderable, float depth);
+    /// @brief Sorts all items by their key using a radix sort.
+    void sort();
+
+    /// @brief Returns all items, which are only ordered by their key after calling sort.
+    const std::vector<RenderQueueItem>& items() const;
+
+    /// @brief Draws all items in order, only binding programs, VAOs and textures, when they differ from the previous
+    /// item.
+    /// @remark Consecutive items with the same instance buffer and state are drawn as a single batch, after writing
+    /// their model transforms into the instance buffer.
+    /// @remark The given function is called with the first renderable of each batch right before it is drawn, e.g. to
+    /// update uniforms. Uniforms set for the other renderables of a batch are never seen by the shader, so objects with
+    /// per-object uniforms must not provide an instance buffer.
+    template <typename TBeforeDraw>
+    void submit(TBeforeDraw before_draw);
+
+    /// @brief Returns the number of state changes and draw calls of the last submission.
+    const RenderQueueStats& stats() const;
+
+    /// @brief Splits the given sorted items into the batches, which submit draws with one draw call each.
+    /// @remark Only consecutive items can form a batch, so transparent items are never batched across another item,
+    /// that lies between them in depth.
+    static void makeBatches(const std::vector<RenderQueueItem>& items, std::vector<RenderQueueBatch>& batches);
+
+    /// @brief Packs the given pass, state numbers and quantized depth into a sort key.
+    static std::uint64_t makeKey(RenderPass pass,
+                                 std::uint64_t program,
+                                 std::uint64_t texture_set,
+                                 std::uint64_t vertex_array,
+                                 std::uint64_t depth);
+    /// @brief Quantizes the given depth to depth_bits, while preserving the order of different depths.
+    static std::uint64_t quantizeDepth(float depth);
+
+private:
+    using StateNumbers = std::unordered_map<const void*, std::uint64_t>;
+
+    /// @brief Returns the number of the given state, which is assigned the first time it is seen in a frame.
+    static std::uint64_t stateNumber(StateNumbers& numbers, const void* state);
+
+    /// @brief Whether the two renderables can be drawn in the same batch.
+    static bool sameBatch(const Renderable& first, const Renderable& other);
+
+    /// @brief Writes the model transforms of the given range of items into the instance buffer of the first one.
+    void writeInstanceTransforms(std::vector<RenderQueueItem>::const_iterator first,
+                                 std::vector<RenderQueueItem>::const_iterator last);
+
+    std::vector<RenderQueueItem> items_;
+    std::vector<RenderQueueItem> sort_buffer_;
+    std::vector<RenderQueueBatch> batches_;
+    StateNumbers program_numbers_;
+    StateNumbers texture_set_numbers_;
+    StateNumbers vertex_array_numbers_;
+    std::vector<mat2x4> instance_transforms_;
+    RenderQueueStats stats_;
+};
+
+template <typename TBeforeDraw>
+inline void RenderQueue::submit(TBeforeDraw before_draw)
+{
+    stats_ = {};
+
+    const Program* program = nullptr;
+    const VAOBase* vertex_array = nullptr;
+    const void* texture_set = nullptr;
+
+    makeBatches(items_, batches_);
+    for (const auto& batch : batches_) {
+        auto item = items_.cbegin() + static_cast<std::ptrdiff_t>(batch.first);
+        const auto& renderable = *item->renderable;
+
+        const auto& item_program = renderable.program();
+        if (&item_program != program) {
+            item_program.bind();
+            program = &item_program;
+            stats_.program_binds++;
+        }
+
+        // Renderables without a VAO or texture set might bind anything, so the next one has to bind its own again.
+        const auto* item_vertex_array = renderable.vertexArray();
+        if (item_vertex_array && item_vertex_array != vertex_array) {
+            item_vertex_array->bind();
+            stats_.vertex_array_binds++;
+        }
+        vertex_array = item_vertex_array;
+
+        const auto* item_texture_set = renderable.textureSet();
+        if (item_texture_set && item_texture_set != texture_set) {
+            renderable.bindTextures();
+            stats_.texture_binds++;
+        }
+        texture_set = item_texture_set;
+
+        if (batch.instanced) {
+            writeInstanceTransforms(item, item + static_cast<std::ptrdiff_t>(batch.count));
+            stats_.batched_objects += batch.count;
+        }
+
+        before_draw(renderable);
+        renderable.draw();
+        stats_.draw_calls++;
+    }
+}
+
+} // namespace dang::gl
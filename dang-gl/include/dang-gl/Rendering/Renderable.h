@@ -1,11 +1,33 @@
 #pragma once
 
+#include "dang-gl/Math/MathTypes.h"
 #include "dang-gl/Math/Transform.h"
 #include "dang-gl/global.h"
 
+#include "dang-utils/enum.h"
+
+namespace dang::gl {
+
+/// @brief The passes, in which renderables are drawn one after another.
+/// @remark Opaque objects are drawn front to back, while transparent objects are drawn back to front.
+enum class RenderPass { Opaque, Transparent, COUNT };
+
+} // namespace dang::gl
+
+namespace dang::utils {
+
+template <>
+struct enum_count<dang::gl::RenderPass> : default_enum_count<dang::gl::RenderPass> {};
+
+} // namespace dang::utils
+
 namespace dang::gl {
 
 class Program;
+class VAOBase;
+
+template <typename T>
+class VBO;
 
 class Renderable;
 
@@ -26,6 +48,24 @@ public:
     virtual Program& program() const = 0;
     /// @brief Draws the object.
     virtual void draw() const = 0;
+
+    /// @brief The pass, in which the object is drawn, defaulting to the opaque pass.
+    virtual RenderPass renderPass() const;
+    /// @brief Returns the VAO, which is used in the draw method, so that objects with the same VAO are drawn together.
+    virtual const VAOBase* vertexArray() const;
+    /// @brief Identifies the textures bound by bindTextures, so that objects sharing them are drawn together.
+    /// @remark Returning nullptr means, that no textures have to be bound before drawing the object.
+    virtual const void* textureSet() const;
+    /// @brief Binds the textures, which are identified by textureSet, and is only called when they change.
+    virtual void bindTextures() const;
+    /// @brief Returns the instance buffer of the VAO, which receives the model transforms of all objects in a batch.
+    /// @remark Objects with an instance buffer are always drawn in batches of one or more objects, which share the same
+    /// program, VAO, textures and instance buffer. Each batch is drawn with a single call to draw, which has to draw
+    /// one instance per model transform in the buffer.
+    /// @remark Shaders have to read the model transform from an instanced mat2x4 attribute instead of a uniform.
+    /// @remark Only the first object of a batch is passed to the before_draw function of RenderQueue::submit, so any
+    /// other per-object state has to be read from instanced attributes as well.
+    virtual VBO<mat2x4>* instanceTransforms() const;
 };
 
 } // namespace dang::gl
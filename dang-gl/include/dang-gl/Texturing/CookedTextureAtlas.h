@@ -0,0 +1,270 @@
+#pragma once
+
+#include "dang-gl/General/GLConstants.h"
+#include "dang-gl/General/MappedFile.h"
+#include "dang-gl/Image/BlockCompression.h"
+#include "dang-gl/Image/Image.h"
+#include "dang-gl/Image/PixelFormat.h"
+#include "dang-gl/Image/PixelType.h"
+#include "dang-gl/Math/MathTypes.h"
+#include "dang-gl/Texturing/TextureAtlas.h"
+#include "dang-gl/Texturing/TextureAtlasBase.h"
+#include "dang-gl/Texturing/TextureAtlasTiles.h"
+#include "dang-gl/Texturing/TextureAtlasUtils.h"
+#include "dang-gl/global.h"
+
+namespace dang::gl {
+
+/// @brief Thrown, when a cooked texture atlas cannot be read or does not match the requested atlas type.
+class CookedTextureAtlasError : public std::runtime_error {
+    using runtime_error::runtime_error;
+};
+
+/// @brief Describes a cooked texture atlas, except for its pixels.
+struct CookedTextureAtlasInfo {
+    GLenum pixel_format = GL_NONE;
+    GLenum pixel_type = GL_NONE;
+    std::uint32_t row_alignment = 0;
+    /// @brief Set, if all layers are block compressed instead of storing pixels of the given format and type.
+    std::optional<BlockCompression> compression;
+    TextureAtlasPacking packing = TextureAtlasPacking::Grid;
+    GLsizei atlas_size = 0;
+    GLsizei layer_count = 0;
+    GLsizei mipmap_levels = 0;
+    std::vector<TextureAtlasTileLayout> tiles;
+};
+
+/// @brief The raw pixels of a single layer on a single mipmap level.
+struct CookedTextureAtlasImage {
+    const std::byte* data = nullptr;
+    std::size_t size = 0;
+};
+
+/// @brief A memory mapped, cooked texture atlas, which contains the layout of all named tiles and the pixels of every
+/// layer on every mipmap level.
+/// @remark Layers are stored exactly like Image or CompressedImage store their data, so they can be uploaded straight
+/// from the mapping.
+/// @remark All values are stored in native byte order, as cooked atlases are meant for a specific platform.
+class CookedTextureAtlasFile {
+public:
+    /// @brief The current version of the file format, which has to match exactly.
+    static constexpr std::uint32_t version = 2;
+
+    /// @brief Maps the file at the given path and reads the atlas layout.
+    /// @exception CookedTextureAtlasError if the file cannot be mapped or is not a valid cooked texture atlas.
+    explicit CookedTextureAtlasFile(const fs::path& path);
+
+    const CookedTextureAtlasInfo& info() const { return info_; }
+
+    /// @brief Returns the pixels of a layer on a mipmap level, pointing directly into the mapped file.
+    CookedTextureAtlasImage image(GLint mipmap_level, GLsizei layer) const
+    {
+        return images_[static_cast<std::size_t>(mipmap_level) * info_.layer_count + layer];
+    }
+
+    /// @brief Writes a cooked texture atlas with the given images, ordered by mipmap level first and layer second.
+    static void write(std::ostream& stream,
+                      const CookedTextureAtlasInfo& info,
+                      const std::vector<CookedTextureAtlasImage>& images);
+
+private:
+    MappedFile file_;
+    CookedTextureAtlasInfo info_;
+    std::vector<CookedTextureAtlasImage> images_;
+};
+
+namespace detail {
+
+/// @brief Composes all layers and mipmap levels of a texture atlas on the CPU, so that they can be cooked.
+template <PixelFormat v_pixel_format, PixelType v_pixel_type, std::size_t v_row_alignment>
+class TextureAtlasCookingTexture {
+public:
+    using ImageData = Image<2, v_pixel_format, v_pixel_type, v_row_alignment>;
+
+    /// @brief Returns the images of all layers, indexed by mipmap level first and layer second.
+    const std::vector<std::vector<ImageData>>& levels() const { return levels_; }
+
+protected:
+    void resize(GLsizei required_size, GLsizei layers, GLsizei mipmap_levels)
+    {
+        levels_.resize(mipmap_levels);
+        for (GLint mipmap_level = 0; mipmap_level < mipmap_levels; mipmap_level++) {
+            auto size = dmath::svec2(static_cast<std::size_t>(std::max(required_size >> mipmap_level, 1)));
+            auto& images = levels_[mipmap_level];
+            images.resize(layers);
+            for (auto& image : images) {
+                if (image.size() == size)
+                    continue;
+                ImageData resized(size);
+                if (image) {
+                    auto old_size = image.size();
+                    dmath::svec2 copy_size(std::min(old_size.x(), size.x()), std::min(old_size.y(), size.y()));
+                    resized.setSubImage({}, image.view(dmath::sbounds2(copy_size)));
+                }
+                image = std::move(resized);
+            }
+        }
+    }
+
+    void modify(const typename ImageData::View& image_view, ivec3 offset, GLint mipmap_level)
+    {
+        auto& image = levels_[mipmap_level][offset.z()];
+        image.setSubImage(dmath::svec2(offset.x(), offset.y()), image_view);
+    }
+
+    void copy(ivec3 src_offset, ivec3 dst_offset, svec2 size, GLint mipmap_level)
+    {
+        auto& images = levels_[mipmap_level];
+        dmath::svec2 src_pos(src_offset.x(), src_offset.y());
+        dmath::sbounds2 src_bounds(src_pos, src_pos + static_cast<dmath::svec2>(size));
+        ImageData region(images[src_offset.z()].view(src_bounds));
+        images[dst_offset.z()].setSubImage(dmath::svec2(dst_offset.x(), dst_offset.y()), region.view());
+    }
+
+private:
+    std::vector<std::vector<ImageData>> levels_;
+};
+
+} // namespace detail
+
+/// @brief A texture atlas, which is only composed on the CPU, so that it can be cooked without a GL context.
+template <PixelFormat v_pixel_format = Image2D::pixel_format,
+          PixelType v_pixel_type = Image2D::pixel_type,
+          std::size_t v_row_alignment = 4>
+class CookingTextureAtlas
+    : public TextureAtlasBase<detail::TextureAtlasCookingTexture<v_pixel_format, v_pixel_type, v_row_alignment>> {
+public:
+    using Base = TextureAtlasBase<detail::TextureAtlasCookingTexture<v_pixel_format, v_pixel_type, v_row_alignment>>;
+
+    /// @brief Creates an atlas with the given limits, which should match the GPU it will be loaded on.
+    explicit CookingTextureAtlas(const TextureAtlasLimits& limits,
+                                 TextureAtlasPacking packing = TextureAtlasPacking::Grid,
+                                 GLsizei mipmap_levels = 1)
+        : Base(limits, packing, mipmap_levels)
+    {}
+};
+
+template <PixelFormat v_pixel_format = Image2D::pixel_format,
+          PixelType v_pixel_type = Image2D::pixel_type,
+          std::size_t v_row_alignment = 4>
+using FrozenCookingTextureAtlas =
+    BasicFrozenTextureAtlas<detail::TextureAtlasCookingTexture<v_pixel_format, v_pixel_type, v_row_alignment>>;
+
+/// @brief Writes the layout and all layers of a frozen cooking atlas into a stream.
+/// @remark Layers can optionally be block compressed, which requires RGBA pixels with unsigned bytes.
+/// @remark Tiles should be aligned to the block size of four pixels, so that their blocks do not mix with neighbours.
+/// @exception std::invalid_argument if a compression is given, but the atlas does not store RGBA unsigned bytes.
+template <PixelFormat v_pixel_format, PixelType v_pixel_type, std::size_t v_row_alignment>
+void writeCookedTextureAtlas(std::ostream& stream,
+                             const FrozenCookingTextureAtlas<v_pixel_format, v_pixel_type, v_row_alignment>& atlas,
+                             std::optional<BlockCompression> compression = std::nullopt)
+{
+    CookedTextureAtlasInfo info;
+    info.pixel_format = toGLConstant(v_pixel_format);
+    info.pixel_type = toGLConstant(v_pixel_type);
+    info.row_alignment = static_cast<std::uint32_t>(v_row_alignment);
+    info.compression = compression;
+    info.packing = atlas.packing();
+    info.atlas_size = atlas.atlasSize();
+    info.layer_count = atlas.layerCount();
+    info.mipmap_levels = atlas.mipmapLevels();
+    info.tiles = atlas.layout();
+
+    std::vector<CookedTextureAtlasImage> images;
+    std::vector<CompressedImage> compressed_images;
+    for (const auto& level : atlas.levels()) {
+        for (const auto& image : level) {
+            if (!compression) {
+                images.push_back({static_cast<const std::byte*>(image.data()), image.byteCount()});
+                continue;
+            }
+            if constexpr (v_pixel_format == PixelFormat::RGBA && v_pixel_type == PixelType::UNSIGNED_BYTE) {
+                const auto& compressed_image = compressed_images.emplace_back(compressImage(image, *compression));
+                images.push_back({compressed_image.data(), compressed_image.byteCount()});
+            }
+            else {
+                throw std::invalid_argument("Only RGBA atlases with unsigned bytes can be block compressed.");
+            }
+        }
+    }
+    CookedTextureAtlasFile::write(stream, info, images);
+}
+
+/// @brief Writes the layout and all layers of a frozen cooking atlas into a file.
+/// @exception CookedTextureAtlasError if the file cannot be written.
+template <PixelFormat v_pixel_format, PixelType v_pixel_type, std::size_t v_row_alignment>
+void writeCookedTextureAtlas(const fs::path& path,
+                             const FrozenCookingTextureAtlas<v_pixel_format, v_pixel_type, v_row_alignment>& atlas,
+                             std::optional<BlockCompression> compression = std::nullopt)
+{
+    std::ofstream stream(path, std::ios::binary);
+    writeCookedTextureAtlas(stream, atlas, compression);
+    if (!stream.flush())
+        throw CookedTextureAtlasError("Cannot write cooked texture atlas to \"" + path.string() + "\".");
+}
+
+/// @brief Maps a cooked texture atlas and uploads its layers straight into the array texture of a frozen atlas.
+/// @remark Block compressed layers are uploaded as is, with the array texture using the matching compressed format.
+/// @exception CookedTextureAtlasError if the file is invalid or stores a different pixel format, type or alignment.
+/// @exception std::invalid_argument if the atlas exceeds the limits of the current context.
+template <PixelFormat v_pixel_format = Image2D::pixel_format,
+          PixelType v_pixel_type = Image2D::pixel_type,
+          std::size_t v_row_alignment = 4>
+FrozenTextureAtlas<v_pixel_format, v_pixel_type, v_row_alignment> loadCookedTextureAtlas(const fs::path& path)
+{
+    using Frozen = FrozenTextureAtlas<v_pixel_format, v_pixel_type, v_row_alignment>;
+    using ImageData = typename Frozen::ImageData;
+    using View = typename ImageData::View;
+
+    CookedTextureAtlasFile file(path);
+    const auto& info = file.info();
+    if (info.pixel_format != toGLConstant(v_pixel_format) || info.pixel_type != toGLConstant(v_pixel_type) ||
+        info.row_alignment != v_row_alignment)
+        throw CookedTextureAtlasError("Cooked texture atlas \"" + path.string() + "\" has a different pixel layout.");
+
+    auto tiles = TextureAtlasTiles<ImageData>::restore(TextureAtlasUtils::checkLimits(std::nullopt, std::nullopt),
+                                                       info.packing,
+                                                       info.mipmap_levels,
+                                                       info.atlas_size,
+                                                       info.layer_count,
+                                                       info.tiles);
+
+    auto levelSize = [&](GLint mipmap_level) {
+        return dmath::svec2(static_cast<std::size_t>(std::max(info.atlas_size >> mipmap_level, 1)));
+    };
+    auto checkLayerSize = [&](const CookedTextureAtlasImage& image, std::size_t byte_count) {
+        if (image.size != byte_count)
+            throw CookedTextureAtlasError("Cooked texture atlas \"" + path.string() + "\" has a wrong layer size.");
+    };
+
+    if (info.compression) {
+        Frozen result(std::move(tiles), std::vector<View>());
+        auto internal_format = block_compression_internal_formats[*info.compression];
+        auto& texture = result.texture();
+        texture = Texture2DArray(
+            svec3(info.atlas_size, info.atlas_size, info.layer_count), info.mipmap_levels, internal_format);
+        for (GLint mipmap_level = 0; mipmap_level < info.mipmap_levels; mipmap_level++) {
+            for (GLsizei layer = 0; layer < info.layer_count; layer++) {
+                auto image = file.image(mipmap_level, layer);
+                CompressedImageView view(image.data, levelSize(mipmap_level), *info.compression);
+                checkLayerSize(image, view.byteCount());
+                texture.modifyCompressed(view, {0, 0, layer}, mipmap_level);
+            }
+        }
+        return result;
+    }
+
+    std::vector<View> views;
+    views.reserve(static_cast<std::size_t>(info.mipmap_levels) * info.layer_count);
+    for (GLint mipmap_level = 0; mipmap_level < info.mipmap_levels; mipmap_level++) {
+        auto size = levelSize(mipmap_level);
+        for (GLsizei layer = 0; layer < info.layer_count; layer++) {
+            auto image = file.image(mipmap_level, layer);
+            checkLayerSize(image, View(nullptr, size).rowStride() * size.y());
+            views.emplace_back(image.data, size);
+        }
+    }
+    return Frozen(std::move(tiles), views);
+}
+
+} // namespace dang::gl
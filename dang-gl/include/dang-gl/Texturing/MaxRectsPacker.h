@@ -0,0 +1,51 @@
+#pragma once
+
+#include "dang-gl/Math/MathTypes.h"
+#include "dang-gl/global.h"
+
+namespace dang::gl {
+
+/// @brief Packs rectangles of arbitrary size into a fixed area using the MaxRects algorithm.
+/// @remark Keeps a list of all maximal free rectangles, which can overlap each other.
+/// @remark Prefers spots that keep the used area as small and square as possible, followed by the spot that leaves the
+/// shortest side free.
+class MaxRectsPacker {
+public:
+    /// @brief Creates a packer for an entirely free area of the given size.
+    explicit MaxRectsPacker(svec2 size);
+
+    /// @brief Returns the size of the whole area.
+    svec2 size() const { return size_; }
+
+    /// @brief Returns the size of the area starting at the origin, which contains all rectangles inserted so far.
+    /// @remark Does not shrink when rectangles are removed.
+    svec2 usedSize() const { return used_size_; }
+
+    /// @brief Returns the number of free rectangles, which is a measure for fragmentation.
+    std::size_t freeRectCount() const { return free_rects_.size(); }
+
+    /// @brief Occupies a free spot for a rectangle of the given size and returns its position.
+    /// @remark Returns std::nullopt if there is no spot big enough.
+    std::optional<svec2> insert(svec2 size);
+
+    /// @brief Frees a rectangle, which was previously occupied by insert.
+    /// @remark The rectangle is merged with free rectangles that share a full edge, but the free space can still
+    /// fragment over time.
+    void remove(const ibounds2& rect);
+
+private:
+    /// @brief Splits all free rectangles that overlap the given, now occupied, rectangle.
+    void occupy(const ibounds2& rect);
+
+    /// @brief Whether the outer rectangle fully contains the inner rectangle.
+    static bool containsRect(const ibounds2& outer, const ibounds2& inner);
+
+    /// @brief Adds a free rectangle, unless another one already contains it, and removes all that it contains.
+    void addFreeRect(const ibounds2& rect);
+
+    svec2 size_;
+    svec2 used_size_;
+    std::vector<ibounds2> free_rects_;
+};
+
+} // namespace dang::gl
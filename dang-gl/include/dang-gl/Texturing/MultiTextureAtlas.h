@@ -22,10 +22,32 @@ public:
 
     class ImageData {
     public:
+        /// @brief Non-owning views on the same subsection of all sub-texture images.
+        class View {
+        public:
+            View(dutils::EnumArray<TSubTextureEnum, typename Image::View> views)
+                : views_(std::move(views))
+            {}
+
+            const typename Image::View& operator[](TSubTextureEnum sub_texture) const { return views_[sub_texture]; }
+
+        private:
+            dutils::EnumArray<TSubTextureEnum, typename Image::View> views_;
+        };
+
         ImageData(dutils::EnumArray<TSubTextureEnum, Image> images)
             : images_((ensureSameSize(images), std::move(images)))
         {}
 
+        explicit ImageData(const dmath::svec2& size)
+            : images_(sizedImages(size, dutils::makeEnumSequence<TSubTextureEnum>()))
+        {}
+
+        static ImageData placeholder(const dmath::svec2& size)
+        {
+            return placeholderHelper(size, dutils::makeEnumSequence<TSubTextureEnum>());
+        }
+
         Image& operator[](TSubTextureEnum sub_texture) { return images_[sub_texture]; }
 
         const Image& operator[](TSubTextureEnum sub_texture) const { return images_[sub_texture]; }
@@ -42,17 +64,51 @@ public:
                 image.free();
         }
 
-        ImageData operator[](const dmath::sbounds2& bounds) const
+        View view(const dmath::sbounds2& bounds) const
         {
-            return subsectionHelper(bounds, dutils::makeEnumSequence<TSubTextureEnum>());
+            return viewHelper(bounds, dutils::makeEnumSequence<TSubTextureEnum>());
+        }
+
+        void setSubImage(const dmath::svec2& offset, const View& view)
+        {
+            for (auto sub_texture : dutils::enumerate<TSubTextureEnum>)
+                images_[sub_texture].setSubImage(offset, view[sub_texture]);
+        }
+
+        ImageData downsample(bool wrap) const
+        {
+            return downsampleHelper(wrap, dutils::makeEnumSequence<TSubTextureEnum>());
         }
 
     private:
+        ImageData() = default;
+
         template <TSubTextureEnum... v_sub_textures>
-        ImageData subsectionHelper(const dmath::sbounds2& bounds,
-                                   dutils::EnumSequence<TSubTextureEnum, v_sub_textures...>) const
+        static dutils::EnumArray<TSubTextureEnum, Image> sizedImages(
+            const dmath::svec2& size, dutils::EnumSequence<TSubTextureEnum, v_sub_textures...>)
         {
-            return {{images_[v_sub_textures][bounds]...}};
+            return {((void)v_sub_textures, Image(size))...};
+        }
+
+        template <TSubTextureEnum... v_sub_textures>
+        static ImageData placeholderHelper(const dmath::svec2& size,
+                                           dutils::EnumSequence<TSubTextureEnum, v_sub_textures...>)
+        {
+            ImageData result;
+            result.images_ = {((void)v_sub_textures, Image::placeholder(size))...};
+            return result;
+        }
+
+        template <TSubTextureEnum... v_sub_textures>
+        View viewHelper(const dmath::sbounds2& bounds, dutils::EnumSequence<TSubTextureEnum, v_sub_textures...>) const
+        {
+            return {{images_[v_sub_textures].view(bounds)...}};
+        }
+
+        template <TSubTextureEnum... v_sub_textures>
+        ImageData downsampleHelper(bool wrap, dutils::EnumSequence<TSubTextureEnum, v_sub_textures...>) const
+        {
+            return {{images_[v_sub_textures].downsample(wrap)...}};
         }
 
         void ensureSameSize(const dutils::EnumArray<TSubTextureEnum, Image>& images)
@@ -79,22 +135,27 @@ public:
     Texture2DArray& texture(TSubTextureEnum sub_texture) { return textures_[sub_texture]; }
 
 protected:
-    bool resize(GLsizei required_size, GLsizei layers, GLsizei mipmap_levels)
+    void resize(GLsizei required_size, GLsizei layers, GLsizei mipmap_levels)
     {
         assert(textures_.front().size().x() == textures_.front().size().y());
         if (required_size == textures_.front().size().x() && layers == textures_.front().size().z())
-            return false;
+            return;
         // /!\ Resets all texture parameters!
         for (auto& texture : textures_)
-            texture = Texture2DArray(
-                {required_size, required_size, layers}, mipmap_levels, pixel_format_internal_v<v_pixel_format>);
-        return true;
+            texture = TextureAtlasUtils::resizeTexture(
+                texture, required_size, layers, mipmap_levels, pixel_format_internal_v<v_pixel_format>);
     };
 
-    void modify(const ImageData& image_data, ivec3 offset, GLint mipmap_level)
+    void modify(const typename ImageData::View& image_view, ivec3 offset, GLint mipmap_level)
     {
         for (auto sub_texture : dutils::enumerate<TSubTextureEnum>)
-            textures_[sub_texture].modify(image_data[sub_texture], offset, mipmap_level);
+            textures_[sub_texture].modify(image_view[sub_texture], offset, mipmap_level);
+    };
+
+    void copy(ivec3 src_offset, ivec3 dst_offset, svec2 size, GLint mipmap_level)
+    {
+        for (auto& texture : textures_)
+            texture.copyFrom(texture, src_offset, dst_offset, {size.x(), size.y(), 1}, mipmap_level, mipmap_level);
     };
 
 private:
@@ -123,8 +184,10 @@ public:
         detail::TextureAtlasMultiTexture<TSubTextureEnum, v_pixel_format, v_pixel_type, v_row_alignment>>;
 
     explicit MultiTextureAtlas(std::optional<GLsizei> max_texture_size = std::nullopt,
-                               std::optional<GLsizei> max_layer_count = std::nullopt)
-        : Base(TextureAtlasUtils::checkLimits(max_texture_size, max_layer_count))
+                               std::optional<GLsizei> max_layer_count = std::nullopt,
+                               TextureAtlasPacking packing = TextureAtlasPacking::Grid,
+                               GLsizei mipmap_levels = 1)
+        : Base(TextureAtlasUtils::checkLimits(max_texture_size, max_layer_count), packing, mipmap_levels)
     {}
 };
 
@@ -27,20 +27,24 @@ public:
     Texture2DArray& texture() { return texture_; }
 
 protected:
-    bool resize(GLsizei required_size, GLsizei layers, GLsizei mipmap_levels)
+    void resize(GLsizei required_size, GLsizei layers, GLsizei mipmap_levels)
     {
         assert(texture_.size().x() == texture_.size().y());
         if (required_size == texture_.size().x() && layers == texture_.size().z())
-            return false;
+            return;
         // /!\ Resets all texture parameters!
-        texture_ = Texture2DArray(
-            {required_size, required_size, layers}, mipmap_levels, pixel_format_internal_v<v_pixel_format>);
-        return true;
+        texture_ = TextureAtlasUtils::resizeTexture(
+            texture_, required_size, layers, mipmap_levels, pixel_format_internal_v<v_pixel_format>);
     };
 
-    void modify(const ImageData& image, ivec3 offset, GLint mipmap_level)
+    void modify(const typename ImageData::View& image_view, ivec3 offset, GLint mipmap_level)
     {
-        texture_.modify(image, offset, mipmap_level);
+        texture_.modify(image_view, offset, mipmap_level);
+    };
+
+    void copy(ivec3 src_offset, ivec3 dst_offset, svec2 size, GLint mipmap_level)
+    {
+        texture_.copyFrom(texture_, src_offset, dst_offset, {size.x(), size.y(), 1}, mipmap_level, mipmap_level);
     };
 
 private:
@@ -58,8 +62,10 @@ public:
     using Base = TextureAtlasBase<detail::TextureAtlasSingleTexture<v_pixel_format, v_pixel_type, v_row_alignment>>;
 
     explicit TextureAtlas(std::optional<GLsizei> max_texture_size = std::nullopt,
-                          std::optional<GLsizei> max_layer_count = std::nullopt)
-        : Base(TextureAtlasUtils::checkLimits(max_texture_size, max_layer_count))
+                          std::optional<GLsizei> max_layer_count = std::nullopt,
+                          TextureAtlasPacking packing = TextureAtlasPacking::Grid,
+                          GLsizei mipmap_levels = 1)
+        : Base(TextureAtlasUtils::checkLimits(max_texture_size, max_layer_count), packing, mipmap_levels)
     {}
 };
 
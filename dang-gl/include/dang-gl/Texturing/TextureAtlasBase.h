@@ -12,10 +12,12 @@ The TextureBase concept:
 
 - Move-constructible
 - using ImageData = ...;
-- bool resize(GLsizei required_size, GLsizei layers, GLsizei mipmap_levels)
-    -> protected, resizes the texture
-- void modify(const ImageData& image, ivec3 offset, GLint mipmap_level)
+- void resize(GLsizei required_size, GLsizei layers, GLsizei mipmap_levels)
+    -> protected, resizes the texture, keeping the contents of all layers that still fit
+- void modify(const typename ImageData::View& image_view, ivec3 offset, GLint mipmap_level)
     -> protected, modifies the texture at a given spot
+- void copy(ivec3 src_offset, ivec3 dst_offset, svec2 size, GLint mipmap_level)
+    -> protected, copies a region of the texture to another spot without involving the CPU
 
 */
 
@@ -28,12 +30,16 @@ public:
     using ImageData = typename TTextureBase::ImageData;
     using Tiles = TextureAtlasTiles<ImageData>;
     using TileHandle = typename Tiles::TileHandle;
+    using TileInfo = typename Tiles::TileInfo;
     using Frozen = BasicFrozenTextureAtlas<TTextureBase>;
 
-    TextureAtlasBase(const TextureAtlasLimits& limits)
-        : tiles_(limits)
+    TextureAtlasBase(const TextureAtlasLimits& limits, TextureAtlasPacking packing, GLsizei mipmap_levels)
+        : tiles_(limits, packing, mipmap_levels)
     {}
 
+    TextureAtlasPacking packing() const { return tiles_.packing(); }
+    GLsizei mipmapLevels() const { return tiles_.mipmapLevels(); }
+
     TextureAtlasTileBorderGeneration guessTileBorderGeneration(GLsizei size) const
     {
         return tiles_.guessTileBorderGeneration(size);
@@ -71,6 +77,11 @@ public:
         return tiles_.addWithHandle(std::move(name), std::move(image_data), border);
     }
 
+    std::vector<TileHandle> addBatch(std::vector<TileInfo> tile_infos)
+    {
+        return tiles_.addBatch(std::move(tile_infos));
+    }
+
     [[nodiscard]] bool exists(const TileHandle& tile_handle) const { return tiles_.exists(tile_handle); }
     [[nodiscard]] bool exists(const std::string& name) const { return tiles_.exists(name); }
     [[nodiscard]] TileHandle operator[](const std::string& name) const { return tiles_[name]; }
@@ -83,6 +94,18 @@ public:
     void updateTexture() { return updateTextureHelper<false>(); }
     Frozen freeze() && { return updateTextureHelper<true>(); }
 
+    TextureAtlasOccupancy occupancy() const { return tiles_.occupancy(); }
+
+    std::size_t defragment(std::size_t max_moves)
+    {
+        // TODO: C++20 replace with std::bind_front
+        using namespace std::placeholders;
+
+        auto resize = std::bind(&TextureAtlasBase::resize, this, _1, _2, _3);
+        auto copy = std::bind(&TextureAtlasBase::copy, this, _1, _2, _3, _4);
+        return tiles_.defragment(resize, copy, max_moves);
+    }
+
 private:
     template <bool v_freeze>
     std::conditional_t<v_freeze, Frozen, void> updateTextureHelper()
@@ -92,11 +115,12 @@ private:
 
         auto resize = std::bind(&TextureAtlasBase::resize, this, _1, _2, _3);
         auto modify = std::bind(&TextureAtlasBase::modify, this, _1, _2, _3);
+        auto copy = std::bind(&TextureAtlasBase::copy, this, _1, _2, _3, _4);
 
         if constexpr (v_freeze)
-            return Frozen(std::move(tiles_).freeze(resize, modify), std::move(*this));
+            return Frozen(std::move(tiles_).freeze(resize, modify, copy), std::move(*this));
         else
-            tiles_.updateTexture(resize, modify);
+            tiles_.updateTexture(resize, modify, copy);
     }
 
     Tiles tiles_;
@@ -111,10 +135,36 @@ public:
 
     friend class TextureAtlasBase<TTextureBase>;
 
+    /// @brief Restores a frozen atlas from restored tiles and uploads the pixels of each layer with a single call.
+    /// @remark Views are ordered by mipmap level first and layer second.
+    /// @remark Without any views, the texture is left empty, so that it can be filled by other means, e.g. with block
+    /// compressed layers.
+    BasicFrozenTextureAtlas(Tiles&& tiles, const std::vector<typename ImageData::View>& layer_views)
+        : tiles_(std::move(tiles))
+    {
+        if (layer_views.empty())
+            return;
+        auto layer_count = tiles_.layerCount();
+        auto mipmap_levels = tiles_.mipmapLevels();
+        assert(layer_views.size() == static_cast<std::size_t>(layer_count) * mipmap_levels);
+        this->resize(tiles_.atlasSize(), layer_count, mipmap_levels);
+        auto view = layer_views.begin();
+        for (GLint mipmap_level = 0; mipmap_level < mipmap_levels; mipmap_level++) {
+            for (GLsizei layer = 0; layer < layer_count; layer++)
+                this->modify(*view++, {0, 0, layer}, mipmap_level);
+        }
+    }
+
     [[nodiscard]] bool exists(const TileHandle& tile_handle) const { return tiles_.exists(tile_handle); }
     [[nodiscard]] bool exists(const std::string& name) const { return tiles_.exists(name); }
     [[nodiscard]] TileHandle operator[](const std::string& name) const { return tiles_[name]; }
 
+    TextureAtlasPacking packing() const { return tiles_.packing(); }
+    GLsizei mipmapLevels() const { return tiles_.mipmapLevels(); }
+    GLsizei atlasSize() const { return tiles_.atlasSize(); }
+    GLsizei layerCount() const { return tiles_.layerCount(); }
+    std::vector<TextureAtlasTileLayout> layout() const { return tiles_.layout(); }
+
 private:
     BasicFrozenTextureAtlas(Tiles&& tiles, TTextureBase&& texture)
         : TTextureBase(std::move(texture))
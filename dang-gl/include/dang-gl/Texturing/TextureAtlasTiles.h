@@ -1,10 +1,14 @@
 #pragma once
 
 #include "dang-gl/Math/MathTypes.h"
+#include "dang-gl/Texturing/MaxRectsPacker.h"
 #include "dang-gl/global.h"
 
 #include "dang-utils/utils.h"
 
+#include <future>
+#include <thread>
+
 namespace dang::gl {
 
 template <typename TImageData>
@@ -21,35 +25,108 @@ The ImageData concept:
     -> image size
 - void free()
     -> frees all data, but leaves the size
-- ImageData operator[](const dmath::sbounds2&) const
-    -> returns a subsection of the image
+- using View = ...
+    -> a cheap to copy, non-owning view on (a subsection of) the image
+- View view(const dmath::sbounds2&) const
+    -> returns a view on a subsection of the image, without copying any pixels
+- explicit TImageData(const dmath::svec2& size)
+    -> creates new image data of the given size, used for staging
+- static TImageData placeholder(const dmath::svec2& size)
+    -> creates image data of the given size without any pixels, as if free() had been called
+- void setSubImage(const dmath::svec2& offset, const View& view)
+    -> copies the pixels of the view to the given offset
+- TImageData downsample(bool wrap) const
+    -> returns the next smaller mipmap level with half the size (rounded up)
+    -> if wrap is set, odd sizes take the missing pixels from the opposite side
 
 */
 
 /// @brief On which sides of a texture to copy the opposite side for better tilling.
 enum class TextureAtlasTileBorderGeneration { None, Positive, All };
 
+/// @brief How tiles are arranged on the layers of a texture atlas.
+enum class TextureAtlasPacking {
+    /// @brief Tiles are rounded up to a power of two and each layer is a grid for a single tile size.
+    /// @remark Adding and removing tiles is very fast and layers can be defragmented, but non power of two tiles waste
+    /// a lot of space.
+    Grid,
+    /// @brief Tiles of any size share layers, which are packed using MaxRects.
+    /// @remark Wastes a lot less space for non power of two tiles, but adding tiles is slower.
+    MaxRects
+};
+
 /// @brief Holds maximum size restrictions of the texture atlas.
 struct TextureAtlasLimits {
     GLsizei max_texture_size;
     GLsizei max_layer_count;
 };
 
+/// @brief Describes how well the layers of a texture atlas are filled, e.g. to decide when to defragment it.
+struct TextureAtlasOccupancy {
+    /// @brief The number of layers in use.
+    std::size_t layer_count = 0;
+    /// @brief The number of tiles over all layers.
+    std::size_t tile_count = 0;
+    /// @brief The number of tiles that all layers can hold without growing.
+    std::size_t capacity = 0;
+    /// @brief The number of layers that could be freed by moving their tiles into holes of other layers.
+    std::size_t reclaimable_layer_count = 0;
+    /// @brief The number of pixels covered by tiles, including their borders.
+    std::size_t tile_pixel_count = 0;
+    /// @brief The number of pixels of all layers of the texture.
+    std::size_t texture_pixel_count = 0;
+
+    /// @brief The fraction of the capacity that is filled with tiles.
+    float ratio() const { return capacity == 0 ? 1.0f : static_cast<float>(tile_count) / capacity; }
+
+    /// @brief The fraction of texture pixels that are covered by tiles.
+    float pixelRatio() const
+    {
+        return texture_pixel_count == 0 ? 1.0f : static_cast<float>(tile_pixel_count) / texture_pixel_count;
+    }
+};
+
+/// @brief Where a single named tile is placed in a texture atlas, e.g. to store the layout in a file.
+struct TextureAtlasTileLayout {
+    std::string name;
+    /// @brief The pixel position, including the border, and the layer of the tile.
+    svec3 position;
+    /// @brief The size of the tile, excluding its border.
+    svec2 size;
+    TextureAtlasTileBorderGeneration border = TextureAtlasTileBorderGeneration::None;
+};
+
 /// @brief Can store a large number of named textures in multiple layers of grids.
 /// @remark Meant for use with a 2D array texture, but has no hard dependency on it.
 /// @remark Supports automatic border generation on only positive or all sides.
+/// @remark Mipmaps are generated for each tile separately, so that neighboring tiles do not bleed into each other.
 template <typename TImageData>
 class TextureAtlasTiles {
 public:
     /// @brief A function that is called with required size (width and height), layers and mipmap levels.
-    /// @remarks Returns whether actual resizing occurred.
-    using TextureResizeFunction = std::function<bool(GLsizei, GLsizei, GLsizei)>;
+    /// @remarks The contents of all layers that still fit must be kept, since tiles are only written once.
+    using TextureResizeFunction = std::function<void(GLsizei, GLsizei, GLsizei)>;
 
-    /// @brief A function that uploads the image to a specific position and mipmap level of a texture.
-    using TextureModifyFunction = std::function<void(const TImageData&, ivec3, GLint)>;
+    /// @brief A view on (a subsection of) the image data.
+    using ImageDataView = typename TImageData::View;
+
+    /// @brief A function that uploads the image view to a specific position and mipmap level of a texture.
+    using TextureModifyFunction = std::function<void(const ImageDataView&, ivec3, GLint)>;
+
+    /// @brief A function that copies a region with the given size from a source to a destination offset of a specific
+    /// mipmap level, without involving the CPU.
+    using TextureCopyFunction = std::function<void(ivec3, ivec3, svec2, GLint)>;
 
     class TileHandle;
 
+    /// @brief Describes a single tile for addBatch.
+    /// @remark Tiles with an empty name are added unnamed.
+    struct TileInfo {
+        std::string name;
+        TImageData image_data;
+        std::optional<TextureAtlasTileBorderGeneration> border;
+    };
+
 private:
     /// @brief Information about the placement of a tile, including whether it has been written to the texture yet.
     struct TilePlacement {
@@ -73,14 +150,15 @@ private:
 
     /// @brief Contains data about a single texture tile on a layer.
     struct TileData {
-        using TileHandles = std::vector<TileHandle*>;
-
-        mutable TileHandles handles;
+        /// @brief The head of an intrusive linked list of all handles to this tile.
+        mutable TileHandle* handles = nullptr;
         const std::string* name = nullptr;
         TImageData image_data;
         TextureAtlasTileBorderGeneration border;
         TilePlacement placement;
         const GLsizei* atlas_size;
+        /// @brief The index of this tile in the list of all tiles of the atlas, allowing for O(1) lookup and removal.
+        std::size_t atlas_index = 0;
 
         TileData(TImageData&& image_data, TextureAtlasTileBorderGeneration border, const GLsizei* atlas_size)
             : image_data(std::move(image_data))
@@ -88,12 +166,20 @@ private:
             , atlas_size(atlas_size)
         {}
 
+        /// @brief The size of the tile including its border.
+        svec2 paddedSize() const { return sizeWithBorder(static_cast<svec2>(image_data.size()), border); }
+
         ~TileData()
         {
-            for (auto& handle : handles)
+            // handle->reset() would also unlink each handle one by one
+            // just clear all of them manually instead
+            auto handle = handles;
+            while (handle) {
+                auto next = std::exchange(handle->next_, nullptr);
+                handle->prev_ = nullptr;
                 handle->data_ = nullptr;
-            // handle->reset() also removes the entry from "handles"
-            // just set data_ to nullptr instead manually
+                handle = next;
+            }
         }
 
         // Delete copy AND move, as pointers to TileData need to remain valid (TileHandle relies on this).
@@ -104,24 +190,44 @@ private:
     };
 
     /// @brief A single layer in the array texture, storing a list of references to tiles.
+    /// @remark Tiles are either placed in a grid of a single tile size or packed using MaxRects.
     class Layer {
     public:
-        /// @brief Creates a new layer with the given tile size, specified as log2.
+        /// @brief Creates a new grid layer with the given tile size, specified as log2.
         explicit Layer(const svec2& tile_size_log2, std::size_t max_texture_size)
             : tile_size_log2_(tile_size_log2)
             , max_tiles_(calculateMaxTiles(max_texture_size))
         {}
 
+        /// @brief Creates a new layer, which packs tiles of any size using MaxRects.
+        /// @remark Tiles are rounded up to a multiple of the given alignment, so that they stay apart on all mipmaps.
+        explicit Layer(GLsizei max_texture_size, GLsizei alignment_log2)
+            : alignment_log2_(alignment_log2)
+            , max_tiles_(std::numeric_limits<std::size_t>::max())
+            , packer_(std::in_place, svec2(max_texture_size))
+        {}
+
         Layer(const Layer&) = delete;
         Layer(Layer&&) = default;
         Layer& operator=(const Layer&) = delete;
         Layer& operator=(Layer&&) = default;
 
+        /// @brief Whether the layer packs tiles of any size instead of using a grid.
+        bool packed() const { return packer_.has_value(); }
+
         /// @brief Returns the log2 of the pixel size of a tile.
         svec2 tileSizeLog2() const { return tile_size_log2_; }
         /// @brief Returns the pixel size of a single tile.
         svec2 tileSize() const { return {GLsizei{1} << tile_size_log2_.x(), GLsizei{1} << tile_size_log2_.y()}; }
 
+        /// @brief Returns the size of the area, that is reserved for the given tile on this layer.
+        svec2 reservedSize(const TileData& tile) const
+        {
+            if (!packer_)
+                return tileSize();
+            return alignSize(tile.paddedSize(), alignment_log2_);
+        }
+
         /// @brief Calculates the required grid size (for the longer side) to fit all tiles.
         GLsizei requiredGridSizeLog2() const
         {
@@ -133,128 +239,237 @@ private:
         }
 
         /// @brief Calculates the required texture size to fit all tiles.
-        GLsizei requiredTextureSize() const { return tileSize().maxValue() << requiredGridSizeLog2(); }
+        GLsizei requiredTextureSize() const
+        {
+            if (packer_)
+                return packer_->usedSize().maxValue();
+            return tileSize().maxValue() << requiredGridSizeLog2();
+        }
+
+        /// @brief The number of tiles that can fit in the grid without growing it.
+        /// @remark Packed layers do not have a fixed number of tiles and never report any holes.
+        std::size_t capacity() const
+        {
+            if (packer_)
+                return tile_count_;
+            auto diff_log2 = std::abs(tile_size_log2_.x() - tile_size_log2_.y());
+            return std::min(max_tiles_, (std::size_t{1} << (requiredGridSizeLog2() * 2)) << diff_log2);
+        }
+
+        /// @brief The number of tiles in the grid.
+        std::size_t tileCount() const { return tile_count_; }
+
+        /// @brief The number of tiles that can still be added without growing the grid.
+        std::size_t holeCount() const { return capacity() - tile_count_; }
 
         /// @brief Whether the grid is empty.
-        bool empty() const { return tiles_.empty(); }
+        bool empty() const { return tile_count_ == 0; }
 
         /// @brief Whether the grid is filled completely.
-        bool full() const { return first_free_tile_ == max_tiles_; }
+        bool full() const { return tile_count_ == max_tiles_; }
+
+        /// @brief The number of tiles that can still be added to the grid.
+        std::size_t freeTileCount() const { return max_tiles_ - tile_count_; }
+
+        /// @brief Reserves memory, so that adding the given number of tiles cannot throw.
+        void reserve(std::size_t count) { tiles_.reserve(tiles_.size() + count); }
 
         /// @brief Places a single tile in the grid, filling potential gaps that appeared after removing tiles.
         void addTile(TileData& tile, GLsizei layer)
         {
-            assert(!full());
-            tile.placement = TilePlacement(first_free_tile_, tileSize() * indexToPosition(first_free_tile_), layer);
-
-            // find next free tile
-            if (first_free_tile_ < tiles_.size()) {
-                auto first = begin(tiles_) + first_free_tile_ + 1;
-                auto iter = std::find(first, end(tiles_), &tile);
-                first_free_tile_ = static_cast<std::size_t>(std::distance(begin(tiles_), iter));
-            }
-            else {
-                tiles_.push_back(&tile);
-                first_free_tile_++;
-            }
+            assert(!packer_ && !full());
+            auto index = insertTile(tile);
+            tile.placement = TilePlacement(index, tileSize() * indexToPosition(index), layer);
+        }
+
+        /// @brief Packs a single tile into a free spot of the layer or returns false if there is no spot big enough.
+        bool tryPackTile(TileData& tile, GLsizei layer)
+        {
+            assert(packer_);
+            auto position = packer_->insert(reservedSize(tile));
+            if (!position)
+                return false;
+            auto index = insertTile(tile);
+            tile.placement = TilePlacement(index, *position, layer);
+            return true;
         }
 
         /// @brief Removes a single tile, opening a gap, as all other tiles stay untouched.
         void removeTile(TileData& tile)
         {
+            if (packer_) {
+                auto low = ivec2(tile.placement.position.xy());
+                packer_->remove(ibounds2(low, low + ivec2(reservedSize(tile))));
+            }
             auto index = tile.placement.index;
-            first_free_tile_ = std::min(first_free_tile_, index);
             tiles_[index] = nullptr;
-            auto last_not_null = std::find_if(rbegin(tiles_), rend(tiles_), [](auto tile) { return tile != nullptr; });
-            tiles_.erase(last_not_null.base(), end(tiles_));
+            tile_count_--;
+            free_indices_.push_back(index);
+            std::push_heap(free_indices_.begin(), free_indices_.end(), std::greater<>());
+            while (!tiles_.empty() && tiles_.back() == nullptr)
+                tiles_.pop_back();
         }
 
-        /// @brief Draws all tiles that haven't been written yet and optionally frees their resources.
-        void drawTiles(const TextureModifyFunction& modify, bool freeze) const
+        /// @brief Appends all tiles that haven't been written yet to the given list.
+        void collectUnwrittenTiles(std::vector<TileData*>& tiles) const
         {
-            for (auto tile : tiles_) {
-                if (tile == nullptr)
-                    continue;
-                if (!tile->placement.written) {
-                    drawTile(*tile, modify);
-                    assert(tile->placement.written);
-                }
-                if (freeze)
-                    tile->image_data.free();
+            for (auto tile : tiles_)
+                if (tile && !tile->placement.written)
+                    tiles.push_back(tile);
+        }
+
+        /// @brief Draws a single tile and the given mipmaps of it onto the texture, using one upload per level.
+        /// @remark Smaller mipmap levels fall back to smaller borders, once the tile has no room left for them.
+        void drawTile(TileData& tile,
+                      const std::vector<TImageData>& mipmaps,
+                      std::optional<TImageData>& staging,
+                      const TextureModifyFunction& modify) const
+        {
+            assert(tile.image_data);
+            drawImage(tile.image_data, tile.placement.position, tile.border, 0, staging, modify);
+            auto reserved_size = reservedSize(tile);
+            for (std::size_t index = 0; index < mipmaps.size(); index++) {
+                auto level = static_cast<GLint>(index + 1);
+                const auto& mipmap = mipmaps[index];
+                auto size = svec2(reserved_size.x() >> level, reserved_size.y() >> level);
+                auto border = fittingBorder(static_cast<svec2>(mipmap.size()), size, tile.border);
+                drawImage(mipmap, mipmapPosition(tile.placement.position, level), border, level, staging, modify);
             }
+            tile.placement.written = true;
         }
 
-        /// @brief Shifts all tiles in the layer down by one.
-        void shiftDown()
+        /// @brief Returns the tile with the highest index in the grid.
+        TileData& lastTile() const
+        {
+            assert(!tiles_.empty());
+            return *tiles_.back();
+        }
+
+        /// @brief Moves all tiles in the layer to the layer with the given index, keeping whether they were written.
+        void moveTo(GLsizei layer)
         {
             for (auto tile : tiles_)
                 if (tile)
-                    tile->placement.position.z()--;
+                    tile->placement.position.z() = layer;
         }
 
     private:
-        /// @brief Draws a single tile onto the texture, also taking the tiles border generation into account.
-        void drawTile(TileData& tile, const TextureModifyFunction& modify) const
+        /// @brief Stores the tile in the first free slot, filling potential gaps, and returns its index.
+        std::size_t insertTile(TileData& tile)
         {
-            const auto& image_data = tile.image_data;
-            assert(image_data);
+            auto index = nextFreeIndex();
+            if (index == tiles_.size())
+                tiles_.push_back(&tile);
+            else
+                tiles_[index] = &tile;
+            tile_count_++;
+            return index;
+        }
 
-            const auto& position = tile.placement.position;
+        /// @brief Pops indices from the free-list until it finds an actual gap, otherwise returns the end of the grid.
+        /// @remark The free-list is a min-heap, so that the lowest gap is filled first, which keeps tiles towards the
+        /// start of the Z-order curve.
+        /// @remark The free-list is not updated when trailing gaps are trimmed or a gap is filled by a new tile at the
+        /// end of the grid, so outdated entries are simply skipped here.
+        std::size_t nextFreeIndex()
+        {
+            while (!free_indices_.empty()) {
+                std::pop_heap(free_indices_.begin(), free_indices_.end(), std::greater<>());
+                auto index = free_indices_.back();
+                free_indices_.pop_back();
+                if (index < tiles_.size() && tiles_[index] == nullptr)
+                    return index;
+            }
+            return tiles_.size();
+        }
 
+        /// @brief Draws an image onto a mipmap level of the texture, also taking border generation into account.
+        /// @remark Images with a border are composed in the staging image first, which is only reallocated if it is too
+        /// small, so that the whole tile can be uploaded using a single call.
+        static void drawImage(const TImageData& image_data,
+                              const svec3& position,
+                              TextureAtlasTileBorderGeneration border,
+                              GLint level,
+                              std::optional<TImageData>& staging,
+                              const TextureModifyFunction& modify)
+        {
             auto width = image_data.size().x();
             auto height = image_data.size().y();
 
-            auto s_width = static_cast<GLsizei>(width);
-            auto s_height = static_cast<GLsizei>(height);
+            if (border == TextureAtlasTileBorderGeneration::None) {
+                modify(image_data.view(dmath::sbounds2(dmath::svec2(width, height))), position, level);
+                return;
+            }
+
+            auto padded_size = static_cast<dmath::svec2>(sizeWithBorder(static_cast<svec2>(image_data.size()), border));
+            if (!staging || staging->size().lessThan(padded_size).any()) {
+                auto staging_size = staging ? staging->size() : dmath::svec2();
+                staging.emplace(dmath::svec2(std::max(staging_size.x(), padded_size.x()),
+                                             std::max(staging_size.y(), padded_size.y())));
+            }
+
+            auto copy = [&](dmath::svec2 low, dmath::svec2 high, dmath::svec2 offset) {
+                staging->setSubImage(offset, image_data.view(dmath::sbounds2(low, high)));
+            };
 
-            switch (tile.border) {
+            switch (border) {
             case TextureAtlasTileBorderGeneration::Positive: {
+                // full image
+                copy({0, 0}, {width, height}, {0, 0});
+
                 // left top -> right bottom
-                modify(image_data[dmath::sbounds2({0, 0}, {1, 1})], position + svec3{s_width, s_height, 0}, 0);
+                copy({0, 0}, {1, 1}, {width, height});
                 // left -> right
-                modify(image_data[dmath::sbounds2({0, 0}, {1, height})], position + svec3{s_width, 0, 0}, 0);
+                copy({0, 0}, {1, height}, {width, 0});
                 // top -> bottom
-                modify(image_data[dmath::sbounds2({0, 0}, {width, 1})], position + svec3{0, s_height, 0}, 0);
+                copy({0, 0}, {width, 1}, {0, height});
 
-                [[fallthrough]];
-            }
-            case TextureAtlasTileBorderGeneration::None: {
-                // full image
-                modify(image_data, position, 0);
                 break;
             }
             case TextureAtlasTileBorderGeneration::All: {
                 // full image (offset by 1)
-                modify(image_data, position + svec3{1, 1, 0}, 0);
+                copy({0, 0}, {width, height}, {1, 1});
 
                 // left top -> right bottom
-                modify(image_data[dmath::sbounds2({0, 0}, {1, 1})], position + svec3{s_width + 1, s_height + 1, 0}, 0);
+                copy({0, 0}, {1, 1}, {width + 1, height + 1});
                 // right top -> left bottom
-                modify(
-                    image_data[dmath::sbounds2({width - 1, 0}, {width, 1})], position + svec3{0, s_height + 1, 0}, 0);
+                copy({width - 1, 0}, {width, 1}, {0, height + 1});
                 // left bottom -> right top
-                modify(
-                    image_data[dmath::sbounds2({0, height - 1}, {1, height})], position + svec3{s_width + 1, 0, 0}, 0);
+                copy({0, height - 1}, {1, height}, {width + 1, 0});
                 // right bottom -> left top
-                modify(image_data[dmath::sbounds2({width - 1, height - 1}, {width, height})],
-                       position + svec3{0, 0, 0},
-                       0);
+                copy({width - 1, height - 1}, {width, height}, {0, 0});
 
                 // left -> right
-                modify(image_data[dmath::sbounds2({0, 0}, {1, height})], position + svec3{s_width + 1, 1, 0}, 0);
+                copy({0, 0}, {1, height}, {width + 1, 1});
                 // right -> left
-                modify(image_data[dmath::sbounds2({width - 1, 0}, {width, height})], position + svec3{0, 1, 0}, 0);
+                copy({width - 1, 0}, {width, height}, {0, 1});
                 // top -> bottom
-                modify(image_data[dmath::sbounds2({0, 0}, {width, 1})], position + svec3{1, s_height + 1, 0}, 0);
+                copy({0, 0}, {width, 1}, {1, height + 1});
                 // bottom -> top
-                modify(image_data[dmath::sbounds2({0, height - 1}, {width, height})], position + svec3{1, 0, 0}, 0);
+                copy({0, height - 1}, {width, height}, {1, 0});
 
                 break;
             }
             default:
                 assert(false);
             }
-            tile.placement.written = true;
+
+            modify(staging->view(dmath::sbounds2(padded_size)), position, level);
+        }
+
+        /// @brief Returns the biggest border, that still fits into the given size together with the image.
+        static TextureAtlasTileBorderGeneration fittingBorder(svec2 image_size,
+                                                              svec2 size,
+                                                              TextureAtlasTileBorderGeneration border)
+        {
+            auto fits = [&](TextureAtlasTileBorderGeneration border) {
+                return !sizeWithBorder(image_size, border).greaterThan(size).any();
+            };
+            if (border == TextureAtlasTileBorderGeneration::All && !fits(border))
+                border = TextureAtlasTileBorderGeneration::Positive;
+            if (border == TextureAtlasTileBorderGeneration::Positive && !fits(border))
+                border = TextureAtlasTileBorderGeneration::None;
+            return border;
         }
 
         /// @brief Returns the maximum number of tiles, that can fit in a square texture of the given size.
@@ -292,13 +507,18 @@ private:
         }
 
         svec2 tile_size_log2_;
+        GLsizei alignment_log2_ = 0;
         std::vector<TileData*> tiles_;
-        std::size_t first_free_tile_ = 0;
+        std::vector<std::size_t> free_indices_;
+        std::size_t tile_count_ = 0;
         std::size_t max_tiles_;
+        std::optional<MaxRectsPacker> packer_;
     };
 
 public:
     /// @brief A smart handle to a tile, which is invalidated when the tile is removed.
+    /// @remark All handles to a tile form an intrusive linked list, so copying, moving and destroying handles is O(1)
+    /// and never allocates.
     class TileHandle {
     public:
         friend TextureAtlasTiles;
@@ -316,30 +536,32 @@ public:
         {
             if (!tile_handle)
                 return;
-            // Just replace the existing entry.
-            *tile_handle.find() = this;
-            tile_handle.data_ = nullptr;
+            // Just take over the existing entry.
+            replace(tile_handle);
         }
 
         TileHandle& operator=(const TileHandle& tile_handle)
         {
+            if (this == &tile_handle)
+                return *this;
             reset();
             if (!tile_handle)
                 return *this;
             data_ = tile_handle.data_;
-            data_->handles.push_back(this);
+            link();
             return *this;
         }
 
         TileHandle& operator=(TileHandle&& tile_handle) noexcept
         {
+            if (this == &tile_handle)
+                return *this;
             reset();
             if (!tile_handle)
                 return *this;
             data_ = tile_handle.data_;
-            // Just replace the existing entry.
-            *tile_handle.find() = this;
-            tile_handle.data_ = nullptr;
+            // Just take over the existing entry.
+            replace(tile_handle);
             return *this;
         }
 
@@ -347,9 +569,7 @@ public:
         {
             if (!*this)
                 return;
-            auto iter = find();
-            assert(iter != end(data_->handles));
-            data_->handles.erase(iter);
+            unlink();
             data_ = nullptr;
         }
 
@@ -357,8 +577,15 @@ public:
 
         [[nodiscard]] const std::string* name() const noexcept { return data_->name; }
 
-        friend bool operator==(const TileHandle& lhs, const TileHandle& rhs) noexcept;
-        friend bool operator!=(const TileHandle& lhs, const TileHandle& rhs) noexcept;
+        [[nodiscard]] friend bool operator==(const TileHandle& lhs, const TileHandle& rhs) noexcept
+        {
+            return lhs.data_ == rhs.data_;
+        }
+
+        [[nodiscard]] friend bool operator!=(const TileHandle& lhs, const TileHandle& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
 
         auto atlasPixelSize() const { return *data_->atlas_size; }
         auto pixelPos() const { return data_->placement.position.xy(); }
@@ -388,30 +615,72 @@ public:
         auto layer() const { return data_->placement.position.z(); }
 
     private:
-        typename TileData::TileHandles::iterator find() const
-        {
-            return std::find(begin(data_->handles), end(data_->handles), this);
-        }
-
         TileHandle(const TileData* data)
             : data_(data)
         {
             if (data)
-                data->handles.push_back(this);
+                link();
+        }
+
+        /// @brief Inserts the handle at the front of the list of its tile.
+        void link() noexcept
+        {
+            next_ = data_->handles;
+            if (next_)
+                next_->prev_ = this;
+            data_->handles = this;
+        }
+
+        /// @brief Removes the handle from the list of its tile.
+        void unlink() noexcept
+        {
+            (prev_ ? prev_->next_ : data_->handles) = next_;
+            if (next_)
+                next_->prev_ = prev_;
+            prev_ = nullptr;
+            next_ = nullptr;
+        }
+
+        /// @brief Takes the place of the given handle in the list of its tile, leaving it empty.
+        void replace(TileHandle& tile_handle) noexcept
+        {
+            prev_ = std::exchange(tile_handle.prev_, nullptr);
+            next_ = std::exchange(tile_handle.next_, nullptr);
+            (prev_ ? prev_->next_ : data_->handles) = this;
+            if (next_)
+                next_->prev_ = this;
+            tile_handle.data_ = nullptr;
         }
 
         const TileData* data_ = nullptr;
+        TileHandle* prev_ = nullptr;
+        TileHandle* next_ = nullptr;
     };
 
-    /// @brief Creates a new instance of TextureAtlasTiles with the given maximum dimensions.
+    /// @brief Creates a new instance of TextureAtlasTiles with the given maximum dimensions, packing method and number
+    /// of mipmap levels.
+    /// @remark With more than one mipmap level, tiles are aligned to the size of a single pixel on the smallest level.
     /// @exception std::invalid_argument if either maximum is less than zero.
-    TextureAtlasTiles(const TextureAtlasLimits& limits)
+    /// @exception std::invalid_argument if the mipmap levels are less than one or do not fit the maximum texture size.
+    TextureAtlasTiles(const TextureAtlasLimits& limits,
+                      TextureAtlasPacking packing = TextureAtlasPacking::Grid,
+                      GLsizei mipmap_levels = 1)
         : limits_(limits)
+        , packing_(packing)
+        , mipmap_levels_(mipmap_levels)
     {
         if (limits.max_texture_size < 0)
             throw std::invalid_argument("Maximum texture size cannot be negative.");
         if (limits.max_layer_count < 0)
             throw std::invalid_argument("Maximum layer count cannot be negative.");
+        if (mipmap_levels < 1)
+            throw std::invalid_argument("Mipmap levels must be at least one.");
+        auto max_mipmap_levels =
+            dutils::ilog2(static_cast<std::make_unsigned_t<GLsizei>>(std::max(limits.max_texture_size, 1))) + 1;
+        if (mipmap_levels > max_mipmap_levels)
+            throw std::invalid_argument("Too many mipmap levels for the maximum texture size. (" +
+                                        std::to_string(mipmap_levels) + " > " + std::to_string(max_mipmap_levels) +
+                                        ")");
     }
 
     TextureAtlasTiles(const TextureAtlasTiles&) = delete;
@@ -466,6 +735,38 @@ public:
         return {sizeWithBorder(size.x(), border), sizeWithBorder(size.y(), border)};
     }
 
+    /// @brief Rounds both components of the size up to a multiple of the given alignment, specified as log2.
+    static svec2 alignSize(svec2 size, GLsizei alignment_log2)
+    {
+        auto align = [&](GLsizei value) { return (((value - 1) >> alignment_log2) + 1) << alignment_log2; };
+        return {align(size.x()), align(size.y())};
+    }
+
+    /// @brief How tiles are arranged on the layers.
+    TextureAtlasPacking packing() const { return packing_; }
+
+    /// @brief The number of mipmap levels of the texture, which are all generated on the CPU.
+    GLsizei mipmapLevels() const { return mipmap_levels_; }
+
+    /// @brief The size of all layers of the texture.
+    GLsizei atlasSize() const { return *atlas_size_; }
+
+    /// @brief The number of layers of the texture.
+    GLsizei layerCount() const { return static_cast<GLsizei>(layers_.size()); }
+
+    /// @brief Returns the placement of all named tiles.
+    /// @remark Unnamed tiles are skipped, as they could not be looked up again anyway.
+    std::vector<TextureAtlasTileLayout> layout() const
+    {
+        std::vector<TextureAtlasTileLayout> result;
+        result.reserve(named_tiles_.size());
+        for (const auto& [name, tile] : named_tiles_) {
+            auto size = static_cast<svec2>(tile->image_data.size());
+            result.push_back({name, tile->placement.position, size, tile->border});
+        }
+        return result;
+    }
+
     /// @brief The current default border generation method.
     TextureAtlasTileBorderGeneration defaultBorderGeneration() const { return default_border_; }
     /// @brief Sets the default border generation method.
@@ -505,13 +806,165 @@ public:
         return TileHandle(emplaceNamedTile(std::move(name), std::move(image_data), border));
     }
 
-    /// @brief Checks if a tile with the given name exists.
+    /// @brief Adds a whole batch of tiles at once and returns handles to them in the same order.
+    /// @remark All tiles are validated before anything is added, tiles of the same size are placed together and the
+    /// atlas size is only updated once at the end.
+    /// @remark Provides the strong exception guarantee, leaving the atlas unchanged if anything throws.
+    /// @exception std::invalid_argument if a name already exists or appears multiple times in the batch.
+    /// @exception std::invalid_argument if an image does not contain any data.
+    /// @exception std::invalid_argument if an image is too big.
+    /// @exception std::length_error if new layers would exceed the maximum layer count.
+    std::vector<TileHandle> addBatch(std::vector<TileInfo> tile_infos)
+    {
+        auto count = tile_infos.size();
+
+        // Validate all tiles and find their size class.
+        struct BatchEntry {
+            std::size_t info_index;
+            TextureAtlasTileBorderGeneration border;
+            svec2 tile_size_log2;
+            std::size_t layer_index = 0;
+        };
+
+        std::vector<BatchEntry> entries;
+        entries.reserve(count);
+        std::size_t named_count = 0;
+        for (std::size_t i = 0; i < count; i++) {
+            const auto& info = tile_infos[i];
+            checkImage(info.image_data);
+            auto size = static_cast<svec2>(info.image_data.size());
+            auto border = info.border ? *info.border : guessTileBorderGeneration(size);
+            entries.push_back({i, border, tileSizeLog2(sizeWithBorder(size, border))});
+            named_count += !info.name.empty();
+        }
+
+        // Allocate everything up front, so that nothing can throw once the atlas is modified.
+        std::vector<std::unique_ptr<TileData>> new_tiles;
+        new_tiles.reserve(count);
+        for (std::size_t i = 0; i < count; i++) {
+            new_tiles.push_back(
+                std::make_unique<TileData>(std::move(tile_infos[i].image_data), entries[i].border, atlas_size_.get()));
+        }
+
+        std::vector<Layer> new_layers;
+        std::vector<std::size_t> layer_additions(layers_.size());
+        if (packing_ == TextureAtlasPacking::Grid) {
+            // Group tiles by size class and distribute them over existing and new layers.
+            std::sort(entries.begin(), entries.end(), [](const BatchEntry& lhs, const BatchEntry& rhs) {
+                return std::tuple(lhs.tile_size_log2.x(), lhs.tile_size_log2.y(), lhs.info_index) <
+                       std::tuple(rhs.tile_size_log2.x(), rhs.tile_size_log2.y(), rhs.info_index);
+            });
+
+            auto entry = entries.begin();
+            while (entry != entries.end()) {
+                auto tile_size_log2 = entry->tile_size_log2;
+                auto group_end = std::find_if(entry, entries.end(), [&](const BatchEntry& other) {
+                    return other.tile_size_log2 != tile_size_log2;
+                });
+
+                auto assign = [&](const Layer& layer, std::size_t layer_index) {
+                    auto free_tiles = layer.freeTileCount() - layer_additions[layer_index];
+                    for (; free_tiles > 0 && entry != group_end; free_tiles--, entry++) {
+                        entry->layer_index = layer_index;
+                        layer_additions[layer_index]++;
+                    }
+                };
+
+                for (std::size_t layer_index = 0; layer_index < layers_.size() && entry != group_end;
+                     layer_index++) {
+                    if (layers_[layer_index].tileSizeLog2() == tile_size_log2)
+                        assign(layers_[layer_index], layer_index);
+                }
+
+                while (entry != group_end) {
+                    auto layer_index = layers_.size() + new_layers.size();
+                    if (layer_index >= static_cast<std::size_t>(limits_.max_layer_count))
+                        throw std::length_error("Too many texture atlas layers. (max " +
+                                                std::to_string(limits_.max_layer_count) + ")");
+                    new_layers.emplace_back(tile_size_log2, limits_.max_texture_size);
+                    layer_additions.push_back(0);
+                    assign(new_layers.back(), layer_index);
+                }
+            }
+        }
+        else {
+            // Packing big tiles first leaves less unusable space.
+            auto packing_order = [&](const BatchEntry& entry) {
+                auto size = new_tiles[entry.info_index]->paddedSize();
+                return std::tuple(-size.maxValue(), -size.product(), entry.info_index);
+            };
+            std::sort(entries.begin(), entries.end(), [&](const BatchEntry& lhs, const BatchEntry& rhs) {
+                return packing_order(lhs) < packing_order(rhs);
+            });
+        }
+
+        std::vector<TileHandle> result;
+        result.reserve(count);
+        tiles_.reserve(tiles_.size() + count);
+        layers_.reserve(layers_.size() + new_layers.size());
+        for (std::size_t layer_index = 0; layer_index < layers_.size(); layer_index++)
+            layers_[layer_index].reserve(layer_additions[layer_index]);
+        for (std::size_t i = 0; i < new_layers.size(); i++)
+            new_layers[i].reserve(layer_additions[layers_.size() + i]);
+
+        // Names and packed tiles are the only things that have to be rolled back, which also checks for duplicates.
+        named_tiles_.reserve(named_tiles_.size() + named_count);
+        std::size_t packed_count = 0;
+        try {
+            for (std::size_t i = 0; i < count; i++) {
+                auto& name = tile_infos[i].name;
+                if (name.empty())
+                    continue;
+                auto [iter, ok] = named_tiles_.try_emplace(std::move(name), new_tiles[i].get());
+                if (!ok)
+                    throw std::invalid_argument("Tile with name \"" + iter->first + "\" already exists.");
+                new_tiles[i]->name = &iter->first;
+            }
+            if (packing_ == TextureAtlasPacking::MaxRects) {
+                for (; packed_count < count; packed_count++)
+                    packTile(*new_tiles[entries[packed_count].info_index]);
+            }
+        }
+        catch (...) {
+            for (std::size_t i = 0; i < packed_count; i++) {
+                auto& tile = *new_tiles[entries[i].info_index];
+                layers_[tile.placement.position.z()].removeTile(tile);
+            }
+            // Only newly created layers can end up empty.
+            while (!layers_.empty() && layers_.back().empty())
+                layers_.pop_back();
+            for (const auto& tile : new_tiles) {
+                if (tile->name)
+                    named_tiles_.erase(named_tiles_.find(*tile->name));
+            }
+            throw;
+        }
+
+        // Finally place all tiles, which only uses already reserved memory.
+        for (auto& layer : new_layers)
+            layers_.push_back(std::move(layer));
+        if (packing_ == TextureAtlasPacking::Grid) {
+            for (const auto& batch_entry : entries) {
+                auto& layer = layers_[batch_entry.layer_index];
+                layer.addTile(*new_tiles[batch_entry.info_index], static_cast<GLsizei>(batch_entry.layer_index));
+            }
+        }
+        for (auto& tile : new_tiles) {
+            tile->atlas_index = tiles_.size();
+            result.push_back(TileHandle(tile.get()));
+            tiles_.push_back(std::move(tile));
+        }
+        *atlas_size_ = maxLayerSize();
+        return result;
+    }
+
+    /// @brief Checks if the tile of the given handle exists in this atlas.
     /// @exception std::invalid_argument if the handle is empty.
     [[nodiscard]] bool exists(const TileHandle& tile_handle) const
     {
         if (!tile_handle)
             throw std::invalid_argument("Tile handle is empty.");
-        return std::find(tiles_.begin(), tiles_.end(), tile_handle.data_) != tiles_.end();
+        return owns(tile_handle.data_);
     }
 
     /// @brief Checks if a tile with the given name exists.
@@ -520,7 +973,7 @@ public:
     {
         if (name.empty())
             throw std::invalid_argument("Tile name is empty.");
-        return named_tiles_.find(name) != tiles_.end();
+        return named_tiles_.find(name) != named_tiles_.end();
     }
 
     /// @brief Returns a (possibly empty) handle to the tile with the given name.
@@ -564,7 +1017,6 @@ public:
             return false;
         [[maybe_unused]] bool ok = removeTile(iter->second);
         assert(ok);
-        named_tiles_.erase(iter);
         return true;
     }
 
@@ -578,33 +1030,188 @@ public:
     }
 
     /// @brief Calls "resize" with the current size and uses "modify" to upload the texture data.
-    void updateTexture(const TextureResizeFunction& resize, const TextureModifyFunction& modify)
+    /// @remark Layers, that were left empty by removed tiles, are first filled with the last layer using "copy", so
+    /// that tiles, which have already been written, never have to be uploaded again.
+    /// @remark Mipmaps of new tiles are generated in parallel, while all uploads happen on the calling thread.
+    void updateTexture(const TextureResizeFunction& resize,
+                       const TextureModifyFunction& modify,
+                       const TextureCopyFunction& copy)
     {
+        eraseEmptyLayers(resize, copy);
         ensureTextureSize(resize);
-        for (auto& layer : layers_)
-            layer.drawTiles(modify, false);
+        drawTiles(modify);
     }
 
     /// @brief Similar to updateTexture, but also frees image data and returns a frozen atlas.
     [[nodiscard]] FrozenTextureAtlasTiles<TImageData> freeze(const TextureResizeFunction& resize,
-                                                             const TextureModifyFunction& modify) &&
+                                                             const TextureModifyFunction& modify,
+                                                             const TextureCopyFunction& copy) &&
     {
+        eraseEmptyLayers(resize, copy);
         ensureTextureSize(resize);
-        for (auto& layer : layers_)
-            layer.drawTiles(modify, true);
+        drawTiles(modify);
+        for (auto& tile : tiles_)
+            tile->image_data.free();
         return FrozenTextureAtlasTiles<TImageData>(std::move(*this));
     }
 
+    /// @brief Restores a frozen atlas from a previously stored layout, without touching any pixels.
+    /// @remark Tiles only store their size, so the texture has to be filled with the stored layers separately.
+    /// @exception std::invalid_argument if a tile name is empty or appears more than once.
+    /// @exception std::invalid_argument if a tile lies outside of the given atlas size or layer count.
+    [[nodiscard]] static FrozenTextureAtlasTiles<TImageData> restore(const TextureAtlasLimits& limits,
+                                                                     TextureAtlasPacking packing,
+                                                                     GLsizei mipmap_levels,
+                                                                     GLsizei atlas_size,
+                                                                     GLsizei layer_count,
+                                                                     const std::vector<TextureAtlasTileLayout>& layout)
+    {
+        TextureAtlasTiles tiles(limits, packing, mipmap_levels);
+        if (atlas_size < 0 || atlas_size > limits.max_texture_size)
+            throw std::invalid_argument("Atlas size exceeds the maximum texture size.");
+        if (layer_count < 0 || layer_count > limits.max_layer_count)
+            throw std::invalid_argument("Layer count exceeds the maximum layer count.");
+        *tiles.atlas_size_ = atlas_size;
+        // Frozen atlases never place any tiles, so empty layers are enough to keep the layer count.
+        for (GLsizei layer = 0; layer < layer_count; layer++)
+            tiles.layers_.emplace_back(atlas_size, mipmap_levels - 1);
+        tiles.tiles_.reserve(layout.size());
+        for (const auto& tile_layout : layout)
+            tiles.restoreTile(tile_layout);
+        return FrozenTextureAtlasTiles<TImageData>(std::move(tiles));
+    }
+
+    /// @brief Returns statistics about how well the layers are filled.
+    TextureAtlasOccupancy occupancy() const
+    {
+        TextureAtlasOccupancy result;
+        result.layer_count = layers_.size();
+        result.tile_count = tiles_.size();
+        for (const auto& layer : layers_)
+            result.capacity += layer.capacity();
+        for (const auto& tile : tiles_)
+            result.tile_pixel_count += static_cast<std::size_t>(tile->paddedSize().product());
+        auto layer_size = static_cast<std::size_t>(maxLayerSize());
+        result.texture_pixel_count = layer_size * layer_size * layers_.size();
+
+        auto holes = holesPerTileSize();
+        for (auto& [tile_size_log2, available_holes] : holes) {
+            // Greedily empty the sparsest layers first, whose holes are then no longer available.
+            std::vector<const Layer*> layers;
+            for (const auto& layer : layers_)
+                if (layer.tileSizeLog2() == tile_size_log2)
+                    layers.push_back(&layer);
+            std::sort(layers.begin(), layers.end(), [](const Layer* lhs, const Layer* rhs) {
+                return lhs->tileCount() < rhs->tileCount();
+            });
+            for (auto layer : layers) {
+                if (available_holes < layer->capacity())
+                    break;
+                available_holes -= layer->capacity();
+                result.reclaimable_layer_count++;
+            }
+        }
+        return result;
+    }
+
+    /// @brief Moves up to the given number of tiles from sparse layers into holes of other layers and frees layers once
+    /// they are empty, returning the number of moved tiles.
+    /// @remark Calls "resize" first, so that the texture contains all layers, and uses "copy" to move tiles that have
+    /// already been written, so that no image data is required.
+    /// @remark Handles of moved tiles stay valid, but their bounds and layer change.
+    /// @remark Only grid layers are defragmented, as packed layers do not keep track of their holes.
+    std::size_t defragment(const TextureResizeFunction& resize, const TextureCopyFunction& copy, std::size_t max_moves)
+    {
+        ensureTextureSize(resize);
+        if (packing_ != TextureAtlasPacking::Grid)
+            return 0;
+        std::size_t moves = 0;
+        while (moves < max_moves) {
+            auto source = defragmentSource();
+            if (!source)
+                break;
+            auto& layer = layers_[*source];
+            while (moves < max_moves && !layer.empty()) {
+                moveTile(layer.lastTile(), defragmentDestination(*source), copy);
+                moves++;
+            }
+            if (!layer.empty())
+                break;
+            eraseLayer(*source, copy);
+        }
+        *atlas_size_ = maxLayerSize();
+        return moves;
+    }
+
 private:
-    /// @brief Calls "resize" to resize the texture and invalidates all tiles if a resize occurred.
+    /// @brief Calls "resize" to resize the texture, which keeps all tiles that have already been written.
     void ensureTextureSize(const TextureResizeFunction& resize)
     {
         auto required_size = maxLayerSize();
         auto layers = static_cast<GLsizei>(layers_.size());
-        if (!resize(required_size, layers, 1))
-            return;
-        for (const auto& tile : tiles_)
-            tile->placement.written = false;
+        resize(required_size, layers, mipmap_levels_);
+    }
+
+    /// @brief Draws all tiles that haven't been written yet, including all of their mipmaps.
+    /// @remark A single staging image is shared by all tiles to compose their borders.
+    void drawTiles(const TextureModifyFunction& modify)
+    {
+        std::vector<TileData*> tiles;
+        for (const auto& layer : layers_)
+            layer.collectUnwrittenTiles(tiles);
+        auto mipmaps = generateMipmaps(tiles);
+        std::optional<TImageData> staging;
+        for (std::size_t index = 0; index < tiles.size(); index++) {
+            auto& tile = *tiles[index];
+            layers_[tile.placement.position.z()].drawTile(tile, mipmaps[index], staging, modify);
+        }
+    }
+
+    /// @brief Generates all mipmaps apart from the base level for each of the given tiles.
+    /// @remark Tiles are distributed over multiple threads, as each mipmap chain only depends on its own tile.
+    /// @remark Tiles with a border wrap around when downsampling, which keeps them seamless on all levels.
+    std::vector<std::vector<TImageData>> generateMipmaps(const std::vector<TileData*>& tiles) const
+    {
+        std::vector<std::vector<TImageData>> result(tiles.size());
+        if (mipmap_levels_ == 1 || tiles.empty())
+            return result;
+
+        auto thread_count = std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u), tiles.size());
+        auto generate = [&](std::size_t first) {
+            for (auto index = first; index < tiles.size(); index += thread_count) {
+                const auto& tile = *tiles[index];
+                auto wrap = tile.border != TextureAtlasTileBorderGeneration::None;
+                auto& mipmaps = result[index];
+                mipmaps.reserve(static_cast<std::size_t>(mipmap_levels_ - 1));
+                const auto* previous = &tile.image_data;
+                for (GLsizei level = 1; level < mipmap_levels_; level++)
+                    previous = &mipmaps.emplace_back(previous->downsample(wrap));
+            }
+        };
+
+        std::vector<std::future<void>> workers;
+        workers.reserve(thread_count - 1);
+        for (std::size_t first = 1; first < thread_count; first++)
+            workers.push_back(std::async(std::launch::async, generate, first));
+        generate(0);
+        for (auto& worker : workers)
+            worker.get();
+        return result;
+    }
+
+    /// @brief Scales the x and y coordinates of a position on the base level down to the given mipmap level.
+    static svec3 mipmapPosition(const svec3& position, GLint level)
+    {
+        return {position.x() >> level, position.y() >> level, position.z()};
+    }
+
+    /// @brief Copies a region of the base level and the matching regions of all other mipmap levels.
+    void copyMipmaps(const svec3& source, const svec3& destination, svec2 size, const TextureCopyFunction& copy) const
+    {
+        for (GLint level = 0; level < mipmap_levels_; level++) {
+            auto level_size = svec2(std::max(size.x() >> level, 1), std::max(size.y() >> level, 1));
+            copy(ivec3(mipmapPosition(source, level)), ivec3(mipmapPosition(destination, level)), level_size, level);
+        }
     }
 
     /// @brief Finds the maximum layer size.
@@ -616,16 +1223,130 @@ private:
         return result;
     }
 
+    /// @brief Sums up the holes of all layers with the same tile size.
+    std::vector<std::pair<svec2, std::size_t>> holesPerTileSize() const
+    {
+        std::vector<std::pair<svec2, std::size_t>> result;
+        for (const auto& layer : layers_) {
+            auto iter = std::find_if(result.begin(), result.end(), [&](const auto& entry) {
+                return entry.first == layer.tileSizeLog2();
+            });
+            if (iter == result.end())
+                result.emplace_back(layer.tileSizeLog2(), layer.holeCount());
+            else
+                iter->second += layer.holeCount();
+        }
+        return result;
+    }
+
+    /// @brief Finds the layer with the fewest tiles, which all fit into holes of other layers with the same tile size.
+    std::optional<std::size_t> defragmentSource() const
+    {
+        auto holes = holesPerTileSize();
+        std::optional<std::size_t> result;
+        for (std::size_t index = 0; index < layers_.size(); index++) {
+            const auto& layer = layers_[index];
+            auto iter = std::find_if(holes.begin(), holes.end(), [&](const auto& entry) {
+                return entry.first == layer.tileSizeLog2();
+            });
+            // The holes of all other layers have to fit the tiles of this layer.
+            if (iter->second < layer.capacity())
+                continue;
+            if (!result || layer.tileCount() < layers_[*result].tileCount())
+                result = index;
+        }
+        return result;
+    }
+
+    /// @brief Finds the fullest layer with holes, that has the same tile size as the given source layer.
+    std::size_t defragmentDestination(std::size_t source) const
+    {
+        std::optional<std::size_t> result;
+        for (std::size_t index = 0; index < layers_.size(); index++) {
+            const auto& layer = layers_[index];
+            if (index == source || layer.tileSizeLog2() != layers_[source].tileSizeLog2() || layer.holeCount() == 0)
+                continue;
+            if (!result || layer.tileCount() > layers_[*result].tileCount())
+                result = index;
+        }
+        assert(result);
+        return *result;
+    }
+
+    /// @brief Moves a tile into a hole of the given layer, copying it on the texture if it has already been written.
+    void moveTile(TileData& tile, std::size_t destination, const TextureCopyFunction& copy)
+    {
+        auto old_placement = tile.placement;
+        auto& destination_layer = layers_[destination];
+        layers_[old_placement.position.z()].removeTile(tile);
+        destination_layer.addTile(tile, static_cast<GLsizei>(destination));
+        if (!old_placement.written)
+            return;
+        copyMipmaps(old_placement.position, tile.placement.position, destination_layer.tileSize(), copy);
+        tile.placement.written = true;
+    }
+
+    /// @brief Erases an empty layer by moving the last layer into its place, which only requires a single copy.
+    void eraseLayer(std::size_t index, const TextureCopyFunction& copy)
+    {
+        assert(layers_[index].empty());
+        auto last_index = layers_.size() - 1;
+        if (index != last_index) {
+            auto& last_layer = layers_.back();
+            copyMipmaps(svec3(0, 0, static_cast<GLsizei>(last_index)),
+                        svec3(0, 0, static_cast<GLsizei>(index)),
+                        svec2(last_layer.requiredTextureSize()),
+                        copy);
+            last_layer.moveTo(static_cast<GLsizei>(index));
+            layers_[index] = std::move(last_layer);
+        }
+        layers_.pop_back();
+    }
+
+    /// @brief Erases all layers, that were left empty by removed tiles, using a single layer copy each.
+    /// @remark Calls "resize" first, so that the texture contains the layers, which are moved into the empty ones.
+    void eraseEmptyLayers(const TextureResizeFunction& resize, const TextureCopyFunction& copy)
+    {
+        if (std::none_of(layers_.begin(), layers_.end(), [](const Layer& layer) { return layer.empty(); }))
+            return;
+        ensureTextureSize(resize);
+        // Going backwards ensures, that the last layer, which is moved into a gap, is never empty itself.
+        for (auto index = layers_.size(); index-- > 0;) {
+            if (layers_[index].empty())
+                eraseLayer(index, copy);
+        }
+        *atlas_size_ = maxLayerSize();
+    }
+
+    /// @brief Returns the log2 of the tile size, that can fit the given size.
+    /// @remark Tiles are never smaller than a single pixel of the smallest mipmap level.
+    svec2 tileSizeLog2(const svec2& size) const
+    {
+        auto unsigned_width = static_cast<std::make_unsigned_t<GLsizei>>(size.x());
+        auto unsigned_height = static_cast<std::make_unsigned_t<GLsizei>>(size.y());
+        return svec2(std::max(static_cast<GLsizei>(dutils::ilog2ceil(unsigned_width)), mipmap_levels_ - 1),
+                     std::max(static_cast<GLsizei>(dutils::ilog2ceil(unsigned_height)), mipmap_levels_ - 1));
+    }
+
+    /// @brief Checks whether the image can be added to the atlas.
+    /// @exception std::invalid_argument if the image does not contain any data.
+    /// @exception std::invalid_argument if the image is too big.
+    void checkImage(const TImageData& image_data) const
+    {
+        if (!image_data)
+            throw std::invalid_argument("Image does not contain data.");
+        if (image_data.size().greaterThan(limits_.max_texture_size).any())
+            throw std::invalid_argument("Image is too big for texture atlas. (" + image_data.size().format() + " > " +
+                                        std::to_string(limits_.max_texture_size) + ")");
+    }
+
     using LayerResult = std::pair<TextureAtlasTiles<TImageData>::Layer*, std::size_t>;
 
     /// @brief Returns a pointer to a (possibly newly created) layer for the given tile size and its index.
     /// @remark The pointer can be null, in which case a new layer would have exceeded the maximum layer count.
     LayerResult layerForTile(const svec2& size)
     {
-        auto unsigned_width = static_cast<std::make_unsigned_t<GLsizei>>(size.x());
-        auto unsigned_height = static_cast<std::make_unsigned_t<GLsizei>>(size.y());
-        auto tile_size_log2 = svec2(static_cast<GLsizei>(dutils::ilog2ceil(unsigned_width)),
-                                    static_cast<GLsizei>(dutils::ilog2ceil(unsigned_height)));
+        auto tile_size_log2 = tileSizeLog2(size);
         auto layer_iter = std::find_if(begin(layers_), end(layers_), [&](const Layer& layer) {
             return !layer.full() && layer.tileSizeLog2() == tile_size_log2;
         });
@@ -637,6 +1358,43 @@ private:
         return {&layers_.emplace_back(tile_size_log2, limits_.max_texture_size), layer_index};
     }
 
+    /// @brief Places the tile on a (possibly newly created) layer and returns that layer.
+    /// @exception std::invalid_argument if the tile including its border does not fit on a layer.
+    /// @exception std::length_error if a new layer would exceed the maximum layer count.
+    Layer& placeTile(TileData& tile)
+    {
+        if (packing_ == TextureAtlasPacking::MaxRects)
+            return packTile(tile);
+        auto [layer, index] = layerForTile(tile.paddedSize());
+        if (!layer)
+            throw std::length_error("Too many texture atlas layers. (max " + std::to_string(limits_.max_layer_count) +
+                                    ")");
+        layer->addTile(tile, static_cast<GLsizei>(index));
+        return *layer;
+    }
+
+    /// @brief Packs the tile into the first layer with enough free space, creating a new layer if necessary.
+    /// @exception std::invalid_argument if the tile including its border does not fit on a layer.
+    /// @exception std::length_error if a new layer would exceed the maximum layer count.
+    Layer& packTile(TileData& tile)
+    {
+        auto size = alignSize(tile.paddedSize(), mipmap_levels_ - 1);
+        if (size.greaterThan(limits_.max_texture_size).any())
+            throw std::invalid_argument("Image with border is too big for texture atlas. (" + size.format() + " > " +
+                                        std::to_string(limits_.max_texture_size) + ")");
+        for (std::size_t index = 0; index < layers_.size(); index++) {
+            if (layers_[index].tryPackTile(tile, static_cast<GLsizei>(index)))
+                return layers_[index];
+        }
+        if (layers_.size() >= static_cast<std::size_t>(limits_.max_layer_count))
+            throw std::length_error("Too many texture atlas layers. (max " + std::to_string(limits_.max_layer_count) +
+                                    ")");
+        auto& layer = layers_.emplace_back(limits_.max_texture_size, mipmap_levels_ - 1);
+        [[maybe_unused]] bool packed = layer.tryPackTile(tile, static_cast<GLsizei>(layers_.size() - 1));
+        assert(packed);
+        return layer;
+    }
+
     /// @brief Creates a new unnamed tile and adds it to a (possibly newly created) layer.
     /// @exception std::invalid_argument if the image does not contain any data.
     /// @exception std::invalid_argument if the image is too big.
@@ -644,22 +1402,22 @@ private:
     TileData* emplaceTile(TImageData&& image_data,
                           std::optional<TextureAtlasTileBorderGeneration> border = std::nullopt)
     {
-        if (!image_data)
-            throw std::invalid_argument("Image does not contain data.");
-        if (image_data.size().greaterThan(limits_.max_texture_size).any())
-            throw std::invalid_argument("Image is too big for texture atlas. (" + image_data.size().format() + " > " +
-                                        std::to_string(limits_.max_texture_size) + ")");
+        checkImage(image_data);
 
         auto actual_border = border ? *border : guessTileBorderGeneration(static_cast<svec2>(image_data.size()));
-        auto [layer, index] = layerForTile(sizeWithBorder(static_cast<svec2>(image_data.size()), actual_border));
-        if (!layer)
-            throw std::length_error("Too many texture atlas layers. (max " + std::to_string(limits_.max_layer_count) +
-                                    ")");
-
         auto& tile =
             *tiles_.emplace_back(std::make_unique<TileData>(std::move(image_data), actual_border, atlas_size_.get()));
-        layer->addTile(tile, index);
-        *atlas_size_ = maxLayerSize();
+        tile.atlas_index = tiles_.size() - 1;
+        Layer* layer = nullptr;
+        try {
+            layer = &placeTile(tile);
+        }
+        catch (...) {
+            tiles_.pop_back();
+            throw;
+        }
+        // Adding a tile can only grow the atlas.
+        *atlas_size_ = std::max(*atlas_size_, layer->requiredTextureSize());
         return &tile;
     }
 
@@ -682,33 +1440,77 @@ private:
         const auto& key = iter->first;
         auto& tile = iter->second;
 
-        tile = emplaceTile(std::move(image_data), border);
+        try {
+            tile = emplaceTile(std::move(image_data), border);
+        }
+        catch (...) {
+            named_tiles_.erase(iter);
+            throw;
+        }
         tile->name = &key;
 
         return tile;
     }
 
+    /// @brief Creates a named tile at the stored position, whose image data is only a placeholder.
+    /// @exception std::invalid_argument if the name is empty or already exists.
+    /// @exception std::invalid_argument if the tile lies outside of the atlas.
+    void restoreTile(const TextureAtlasTileLayout& tile_layout)
+    {
+        if (tile_layout.name.empty())
+            throw std::invalid_argument("Tile name is empty.");
+        auto padded_size = sizeWithBorder(tile_layout.size, tile_layout.border);
+        const auto& position = tile_layout.position;
+        if (position.lessThan(0).any() || position.x() + padded_size.x() > *atlas_size_ ||
+            position.y() + padded_size.y() > *atlas_size_ || position.z() >= layerCount())
+            throw std::invalid_argument("Tile \"" + tile_layout.name + "\" lies outside of the atlas.");
+
+        auto [iter, ok] = named_tiles_.try_emplace(tile_layout.name, nullptr);
+        if (!ok)
+            throw std::invalid_argument("Tile with name \"" + iter->first + "\" already exists.");
+
+        auto image_data = TImageData::placeholder(static_cast<dmath::svec2>(tile_layout.size));
+        auto& tile = *tiles_.emplace_back(
+            std::make_unique<TileData>(std::move(image_data), tile_layout.border, atlas_size_.get()));
+        tile.atlas_index = tiles_.size() - 1;
+        tile.name = &iter->first;
+        tile.placement.position = position;
+        tile.placement.written = true;
+        iter->second = &tile;
+    }
+
+    /// @brief Whether the given tile belongs to this atlas.
+    bool owns(const TileData* tile_data) const
+    {
+        return tile_data->atlas_index < tiles_.size() && tiles_[tile_data->atlas_index].get() == tile_data;
+    }
+
     /// @brief Removes a tile from the atlas and returns true if it existed.
-    /// @remark Does not remove the tile from the named tile map.
+    /// @remark Also removes the tile from the named tile map.
+    /// @remark Empty layers at the end are dropped right away, while all other empty layers are only erased on the next
+    /// update of the texture, which can move the last layer into their place without uploading it again.
     bool removeTile(const TileData* tile_data)
     {
-        auto iter = std::find(tiles_.begin(), tiles_.end(), tile_data);
-        if (iter == tiles_.end())
+        if (!owns(tile_data))
             return false;
-        auto layer_index = iter->placement.position.z();
-        auto& layer = layers_[layer_index];
-        layer.removeTile(*iter);
-        tiles_.erase(iter);
-        if (layer.empty()) {
-            layers_.erase(begin(layers_) + layer_index);
-            for (auto layer_iter = begin(layers_) + layer_index; layer_iter != end(layers_); layer_iter++)
-                layer_iter->shiftDown();
-        }
+        auto atlas_index = tile_data->atlas_index;
+        auto& tile = *tiles_[atlas_index];
+        if (tile.name)
+            named_tiles_.erase(named_tiles_.find(*tile.name));
+        layers_[tile.placement.position.z()].removeTile(tile);
+        // Swap with the last tile, so that nothing needs to be shifted.
+        std::swap(tiles_[atlas_index], tiles_.back());
+        tiles_[atlas_index]->atlas_index = atlas_index;
+        tiles_.pop_back();
+        while (!layers_.empty() && layers_.back().empty())
+            layers_.pop_back();
         *atlas_size_ = maxLayerSize();
         return true;
     }
 
     TextureAtlasLimits limits_;
+    TextureAtlasPacking packing_;
+    GLsizei mipmap_levels_;
     std::unique_ptr<GLsizei> atlas_size_ = std::make_unique<GLsizei>(0);
     std::vector<std::unique_ptr<TileData>> tiles_;
     std::unordered_map<std::string, TileData*> named_tiles_;
@@ -733,6 +1535,12 @@ public:
     [[nodiscard]] bool exists(const std::string& name) const { return tiles_.exists(name); }
     [[nodiscard]] TileHandle operator[](const std::string& name) const { return tiles_[name]; }
 
+    TextureAtlasPacking packing() const { return tiles_.packing(); }
+    GLsizei mipmapLevels() const { return tiles_.mipmapLevels(); }
+    GLsizei atlasSize() const { return tiles_.atlasSize(); }
+    GLsizei layerCount() const { return tiles_.layerCount(); }
+    std::vector<TextureAtlasTileLayout> layout() const { return tiles_.layout(); }
+
 private:
     FrozenTextureAtlasTiles(TextureAtlasTiles<TImageData>&& tiles)
         : tiles_(std::move(tiles))
@@ -741,18 +1549,4 @@ private:
     TextureAtlasTiles<TImageData> tiles_;
 };
 
-template <typename TImageData>
-[[nodiscard]] bool operator==(const typename TextureAtlasTiles<TImageData>::TileHandle& lhs,
-                              const typename TextureAtlasTiles<TImageData>::TileHandle& rhs) noexcept
-{
-    return lhs.data_ == rhs.data_;
-}
-
-template <typename TImageData>
-[[nodiscard]] bool operator!=(const typename TextureAtlasTiles<TImageData>::TileHandle& lhs,
-                              const typename TextureAtlasTiles<TImageData>::TileHandle& rhs) noexcept
-{
-    return !(lhs == rhs);
-}
-
 } // namespace dang::gl
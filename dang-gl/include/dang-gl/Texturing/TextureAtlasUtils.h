@@ -1,5 +1,7 @@
 #pragma once
 
+#include "dang-gl/Image/PixelInternalFormat.h"
+#include "dang-gl/Objects/Texture.h"
 #include "dang-gl/Texturing/TextureAtlasTiles.h"
 #include "dang-gl/global.h"
 
@@ -10,4 +12,13 @@ GLsizei checkMaxLayerCount(std::optional<GLsizei> max_layer_count);
 
 TextureAtlasLimits checkLimits(std::optional<GLsizei> max_texture_size, std::optional<GLsizei> max_layer_count);
 
+/// @brief Creates a new array texture of the given size and copies all still fitting layers over on the GPU.
+/// @remark Tiles keep their position when the atlas grows, so none of them have to be uploaded again.
+/// @remark The old texture is expected to have the same number of mipmap levels.
+Texture2DArray resizeTexture(const Texture2DArray& texture,
+                             GLsizei required_size,
+                             GLsizei layers,
+                             GLsizei mipmap_levels,
+                             PixelInternalFormat internal_format);
+
 } // namespace dang::gl::TextureAtlasUtils
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "dang-gl/Image/Image.h"
+#include "dang-gl/Image/ImageView.h"
+#include "dang-gl/Math/MathTypes.h"
+#include "dang-gl/Objects/PBO.h"
+#include "dang-gl/Objects/Texture.h"
+#include "dang-gl/global.h"
+
+namespace dang::gl {
+
+/// @brief Uploads pixel data to textures through a ring of pixel buffer segments, so that uploads do not stall.
+/// @remark Pixels are copied into mapped buffer memory, from which the driver transfers them to the texture in the
+/// background. Once a segment is full, a fence is placed, which is only waited on when the ring wraps around to it.
+/// @remark Uploads, that do not fit into a single segment, fall back to a regular upload from client memory.
+class TextureUploadQueue {
+public:
+    /// @brief Creates a ring of the given number of segments, with a size in bytes each.
+    /// @exception std::invalid_argument if either the segment size or count is zero.
+    explicit TextureUploadQueue(std::size_t segment_size = std::size_t{16} << 20, std::size_t segment_count = 3);
+
+    /// @brief Deletes all remaining fences.
+    ~TextureUploadQueue();
+
+    TextureUploadQueue(const TextureUploadQueue&) = delete;
+    TextureUploadQueue(TextureUploadQueue&&) = default;
+    TextureUploadQueue& operator=(const TextureUploadQueue&) = delete;
+    /// @brief Deletes the remaining fences of the replaced queue, before taking over the other one.
+    TextureUploadQueue& operator=(TextureUploadQueue&& other) noexcept;
+
+    /// @brief Returns the size of a single segment in bytes.
+    std::size_t segmentSize() const { return segment_size_; }
+
+    /// @brief Returns the number of segments in the ring.
+    std::size_t segmentCount() const { return fences_.size(); }
+
+    /// @brief Copies the pixels of the view into the ring and uploads them to the texture from there.
+    /// @remark The view can be released right away, as the pixels are no longer needed once this returns.
+    template <std::size_t v_dim,
+              TextureTarget v_target,
+              std::size_t v_image_dim,
+              PixelFormat v_pixel_format,
+              PixelType v_pixel_type,
+              std::size_t v_row_alignment>
+    void upload(detail::TextureBaseTyped<v_dim, v_target>& texture,
+                const ImageView<v_image_dim, v_pixel_format, v_pixel_type, v_row_alignment>& image_view,
+                ivec<v_dim> offset = {},
+                GLint mipmap_level = 0)
+    {
+        using View = ImageView<v_image_dim, v_pixel_format, v_pixel_type, v_row_alignment>;
+
+        if (image_view.count() == 0)
+            return;
+
+        // The pixels are packed tightly in the buffer, only keeping the row alignment.
+        auto size = image_view.size();
+        auto row_stride = View(nullptr, size).rowStride();
+        auto row_count = image_view.count() / size[0];
+        auto buffer_offset = allocate(row_stride * row_count);
+        if (!buffer_offset) {
+            texture.modify(image_view, offset, mipmap_level);
+            return;
+        }
+
+        auto data = pbo_.mapRange(*buffer_offset, row_stride * row_count);
+        for (std::size_t row = 0; row < row_count; row++) {
+            typename View::Size pos;
+            auto index = row;
+            for (std::size_t d = 1; d < v_image_dim; d++) {
+                pos[d] = index % size[d];
+                index /= size[d];
+            }
+            std::memcpy(data + row * row_stride, &image_view[pos], image_view.byteWidth());
+        }
+        pbo_.unmap();
+
+        // With the buffer bound, the data pointer of the view is the offset into the buffer.
+        texture.modify(View(reinterpret_cast<const void*>(*buffer_offset), size), offset, mipmap_level);
+        pbo_.release();
+    }
+
+    /// @brief Copies the pixels of the image into the ring and uploads them to the texture from there.
+    template <std::size_t v_dim,
+              TextureTarget v_target,
+              std::size_t v_image_dim,
+              PixelFormat v_pixel_format,
+              PixelType v_pixel_type,
+              std::size_t v_row_alignment>
+    void upload(detail::TextureBaseTyped<v_dim, v_target>& texture,
+                const Image<v_image_dim, v_pixel_format, v_pixel_type, v_row_alignment>& image,
+                ivec<v_dim> offset = {},
+                GLint mipmap_level = 0)
+    {
+        upload(texture, image.view(), offset, mipmap_level);
+    }
+
+private:
+    /// @brief Reserves the given number of bytes in the current segment and returns their offset in the buffer.
+    /// @remark Moves on to the next segment if the current one is full and returns std::nullopt if the size exceeds a
+    /// whole segment.
+    std::optional<std::size_t> allocate(std::size_t size);
+
+    /// @brief Deletes all fences, that were not waited on yet.
+    void deleteFences();
+
+    /// @brief Places a fence behind all uploads from the current segment and waits until the next one is free.
+    void nextSegment();
+
+    std::size_t segment_size_;
+    PBO pbo_;
+    std::vector<GLsync> fences_;
+    std::size_t segment_ = 0;
+    std::size_t segment_offset_ = 0;
+};
+
+} // namespace dang::gl
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "dang-gl/Image/Image.h"
+#include "dang-gl/Image/PixelInternalFormat.h"
+#include "dang-gl/Math/MathTypes.h"
+#include "dang-gl/Objects/Texture.h"
+#include "dang-gl/Texturing/TextureUploadQueue.h"
+#include "dang-gl/Texturing/VirtualTexturePageTable.h"
+#include "dang-gl/Texturing/VirtualTextureResidency.h"
+#include "dang-gl/global.h"
+
+#include <future>
+
+namespace dang::gl {
+
+/// @brief Streams the pages of a texture, which is too big to fit into memory, into a fixed number of physical slots.
+/// @remark Physical slots are the layers of a single array texture, while a mipmapped indirection texture maps each
+/// page to the slot of the finest resident page covering it.
+/// @remark Which pages are needed is usually found out by a feedback pass, which renders page coordinates into a small
+/// framebuffer, that is then read back and decoded with decodeFeedback.
+class VirtualTexture {
+public:
+    using PageImage = Image2D;
+    /// @brief Starts loading the pixels of a page, e.g. from ImageLoader or a cooked atlas.
+    using PageLoader = std::function<std::future<PageImage>(const VirtualTexturePage&)>;
+    /// @brief Holds page position, level and a one for every pixel that sampled the virtual texture.
+    using FeedbackImage = Image<2, PixelFormat::RGBA_INTEGER, PixelType::UNSIGNED_SHORT>;
+
+    /// @brief Creates a virtual texture with the given number of pages on the finest level, each of which is a square
+    /// of page_size pixels.
+    /// @remark The slot count is limited by the maximum number of array texture layers.
+    /// @exception std::invalid_argument if the page count is not a power of two.
+    /// @exception std::invalid_argument if the level count is less than one or more than a full mipmap chain.
+    /// @exception std::invalid_argument if the page size is less than one.
+    /// @exception std::invalid_argument if the slot count is zero.
+    VirtualTexture(svec2 page_count,
+                   GLsizei level_count,
+                   GLsizei page_size,
+                   std::size_t slot_count,
+                   PageLoader page_loader,
+                   PixelInternalFormat internal_format = PixelInternalFormat::RGBA8);
+
+    /// @brief The size of a single page in pixels.
+    GLsizei pageSize() const { return page_size_; }
+
+    /// @brief The array texture, which holds one resident page in each layer.
+    const Texture2DArray& pages() const { return pages_; }
+
+    /// @brief The indirection texture with one texel per page, which should be sampled without filtering.
+    const Texture2D& pageTable() const { return page_table_texture_; }
+
+    /// @brief The residency manager, deciding which pages are kept in which slot.
+    const VirtualTextureResidency& residency() const { return residency_; }
+
+    /// @brief The number of pages, that are still being loaded.
+    std::size_t pendingCount() const;
+
+    /// @brief Requests the given pages including all of their coarser ancestors and starts loading up to max_loads
+    /// missing pages.
+    /// @remark Pages that finished loading are uploaded through the queue and the page table is updated accordingly.
+    /// @remark If a load failed, its exception is rethrown and the page is evicted, so that the next update, which
+    /// requests it, tries to load it again.
+    /// @exception std::invalid_argument if a loaded page does not have the size of a page.
+    void update(const std::vector<VirtualTexturePage>& requested,
+                std::size_t max_loads,
+                TextureUploadQueue& upload_queue);
+
+    /// @brief Returns every page, which appears in the feedback image, exactly once.
+    /// @remark Pages outside of the virtual texture are ignored.
+    std::vector<VirtualTexturePage> decodeFeedback(const FeedbackImage& feedback) const;
+
+private:
+    struct PendingLoad {
+        VirtualTexturePage page;
+        std::future<PageImage> image;
+    };
+
+    /// @brief Adds all coarser ancestors of the requested pages and removes duplicates.
+    std::vector<VirtualTexturePage> withAncestors(const std::vector<VirtualTexturePage>& requested) const;
+
+    /// @brief Uploads the pages of all loads, that finished in the meantime.
+    void finishLoads(TextureUploadQueue& upload_queue);
+
+    GLsizei page_size_;
+    PageLoader page_loader_;
+    VirtualTextureResidency residency_;
+    VirtualTexturePageTable page_table_;
+    std::vector<std::optional<PendingLoad>> pending_loads_;
+    /// @brief Loads of pages, which were evicted before they finished, as the future of std::async blocks on
+    /// destruction.
+    std::vector<std::future<PageImage>> abandoned_loads_;
+    Texture2DArray pages_;
+    Texture2D page_table_texture_;
+};
+
+} // namespace dang::gl
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "dang-gl/Image/Image.h"
+#include "dang-gl/Image/PixelFormat.h"
+#include "dang-gl/Image/PixelType.h"
+#include "dang-gl/Math/MathTypes.h"
+#include "dang-gl/Texturing/VirtualTextureResidency.h"
+#include "dang-gl/global.h"
+
+namespace dang::gl {
+
+/// @brief Maps every page of a virtual texture to the slot of the finest resident page, that covers it.
+/// @remark Each level is stored as an image, which can be uploaded as the matching mipmap level of an indirection
+/// texture.
+/// @remark An entry holds the lower and upper 16 bits of the slot, the level it resolved to and a one if any page
+/// covering it is resident at all.
+class VirtualTexturePageTable {
+public:
+    using IndirectionImage = Image<2, PixelFormat::RGBA_INTEGER, PixelType::UNSIGNED_SHORT>;
+
+    /// @brief The slot and level of the resident page, which a page resolved to.
+    struct Entry {
+        std::size_t slot;
+        GLint level;
+
+        friend bool operator==(const Entry& lhs, const Entry& rhs)
+        {
+            return lhs.slot == rhs.slot && lhs.level == rhs.level;
+        }
+
+        friend bool operator!=(const Entry& lhs, const Entry& rhs) { return !(lhs == rhs); }
+    };
+
+    /// @brief Creates a page table, where no page is resident, for the given number of pages on the finest level.
+    /// @remark Coarser levels have half as many pages, but at least one, which matches the mipmap levels of a texture.
+    /// Page counts have to be powers of two, as every page needs a parent on the next level.
+    /// @exception std::invalid_argument if the page count is not a power of two.
+    /// @exception std::invalid_argument if the level count is less than one or more than a full mipmap chain.
+    VirtualTexturePageTable(svec2 page_count, GLsizei level_count);
+
+    /// @brief The number of mipmap levels.
+    GLsizei levelCount() const { return static_cast<GLsizei>(slots_.size()); }
+
+    /// @brief The number of pages on the given level.
+    svec2 pageCount(GLint level) const;
+
+    /// @brief Whether the page lies inside of the virtual texture.
+    bool contains(const VirtualTexturePage& page) const;
+
+    /// @brief Marks the page as resident in the given slot.
+    /// @exception std::out_of_range if the page lies outside of the virtual texture.
+    void setResident(const VirtualTexturePage& page, std::size_t slot);
+
+    /// @brief Marks the page as no longer resident.
+    /// @exception std::out_of_range if the page lies outside of the virtual texture.
+    void setMissing(const VirtualTexturePage& page);
+
+    /// @brief Returns the entry of the finest resident page covering the given page or std::nullopt if there is none.
+    /// @exception std::out_of_range if the page lies outside of the virtual texture.
+    std::optional<Entry> resolve(const VirtualTexturePage& page) const;
+
+    /// @brief Whether pages changed since the images have been built the last time.
+    bool dirty() const { return dirty_; }
+
+    /// @brief Returns one image per level, which are rebuilt first if any page changed.
+    /// @remark Rebuilding walks each level from the coarsest to the finest, so that every entry only needs to look at
+    /// the entry of its parent.
+    const std::vector<IndirectionImage>& images();
+
+private:
+    static constexpr auto no_slot = std::numeric_limits<std::uint32_t>::max();
+
+    /// @brief Returns the index of the page into the slots of its level.
+    /// @exception std::out_of_range if the page lies outside of the virtual texture.
+    std::size_t pageIndex(const VirtualTexturePage& page) const;
+
+    svec2 page_count_;
+    std::vector<std::vector<std::uint32_t>> slots_;
+    std::vector<IndirectionImage> images_;
+    bool dirty_ = true;
+};
+
+} // namespace dang::gl
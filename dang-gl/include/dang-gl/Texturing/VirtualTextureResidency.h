@@ -0,0 +1,98 @@
+#pragma once
+
+#include "dang-gl/Math/MathTypes.h"
+#include "dang-gl/global.h"
+
+#include <list>
+#include <unordered_map>
+
+namespace dang::gl {
+
+/// @brief Identifies a single page of a virtual texture by its position in pages on a specific mipmap level.
+struct VirtualTexturePage {
+    svec2 position;
+    GLint level = 0;
+
+    /// @brief Returns the page on the next coarser level, which covers this page.
+    VirtualTexturePage parent() const { return {svec2(position.x() >> 1, position.y() >> 1), level + 1}; }
+
+    friend bool operator==(const VirtualTexturePage& lhs, const VirtualTexturePage& rhs)
+    {
+        return lhs.position == rhs.position && lhs.level == rhs.level;
+    }
+
+    friend bool operator!=(const VirtualTexturePage& lhs, const VirtualTexturePage& rhs) { return !(lhs == rhs); }
+};
+
+/// @brief Combines position and level of a page into a single hash.
+struct VirtualTexturePageHash {
+    std::size_t operator()(const VirtualTexturePage& page) const
+    {
+        auto x = static_cast<std::size_t>(page.position.x());
+        auto y = static_cast<std::size_t>(page.position.y());
+        auto level = static_cast<std::size_t>(page.level);
+        return (x * 0x9e3779b1) ^ (y * 0x85ebca6b) ^ (level * 0xc2b2ae35);
+    }
+};
+
+/// @brief Decides, which pages of a virtual texture are resident in a fixed number of physical slots.
+/// @remark Pages are kept in least recently used order, so that the page, which went unused the longest, is evicted
+/// first.
+/// @remark Contains no GL calls at all, so that the residency logic can be simulated without a GPU.
+class VirtualTextureResidency {
+public:
+    /// @brief A page, that has been assigned a slot and now needs to be loaded into it.
+    struct Load {
+        VirtualTexturePage page;
+        std::size_t slot;
+        /// @brief The page, that previously occupied the slot and is no longer resident.
+        std::optional<VirtualTexturePage> evicted;
+    };
+
+    /// @brief Creates a residency manager with the given number of initially free slots.
+    /// @exception std::invalid_argument if the slot count is zero.
+    explicit VirtualTextureResidency(std::size_t slot_count);
+
+    /// @brief The total number of physical slots.
+    std::size_t slotCount() const { return slot_count_; }
+
+    /// @brief The number of slots, that are occupied by a page.
+    std::size_t residentCount() const { return pages_.size(); }
+
+    /// @brief Returns the slot of the given page or std::nullopt if the page is not resident.
+    std::optional<std::size_t> slot(const VirtualTexturePage& page) const;
+
+    /// @brief Marks all requested pages as recently used and assigns slots to up to max_loads missing pages.
+    /// @remark Missing pages on coarser levels are assigned first, as they act as a fallback for finer levels.
+    /// @remark Pages, which are requested in the same call, are never evicted. If more pages are requested than there
+    /// are slots, the remaining pages simply stay missing.
+    std::vector<Load> update(const std::vector<VirtualTexturePage>& requested, std::size_t max_loads);
+
+    /// @brief Evicts a single page, e.g. because loading it failed, and returns whether it was resident.
+    /// @remark The freed slot is handed out again by the next update.
+    bool evict(const VirtualTexturePage& page);
+
+    /// @brief Evicts all pages, e.g. when the content of the virtual texture changed.
+    void clear();
+
+private:
+    struct Entry {
+        VirtualTexturePage page;
+        std::size_t slot;
+        std::size_t last_update;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    /// @brief Returns a free slot or evicts the least recently used page, unless it was requested in this update.
+    std::optional<std::size_t> acquireSlot(std::optional<VirtualTexturePage>& evicted);
+
+    std::size_t slot_count_;
+    std::vector<std::size_t> free_slots_;
+    /// @brief All resident pages, with the most recently used page at the front.
+    EntryList entries_;
+    std::unordered_map<VirtualTexturePage, EntryList::iterator, VirtualTexturePageHash> pages_;
+    std::size_t update_count_ = 0;
+};
+
+} // namespace dang::gl
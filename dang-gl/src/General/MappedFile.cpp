@@ -0,0 +1,96 @@
+#include "General/MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dang::gl {
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const fs::path& path)
+{
+    auto file = CreateFileW(path.c_str(),
+                            GENERIC_READ,
+                            FILE_SHARE_READ,
+                            nullptr,
+                            OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                            nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return;
+
+    LARGE_INTEGER file_size;
+    if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0) {
+        // The view keeps the mapping alive, so both handles can be closed right away.
+        if (auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr)) {
+            if (auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)) {
+                data_ = static_cast<const std::byte*>(view);
+                size_ = static_cast<std::size_t>(file_size.QuadPart);
+            }
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+}
+
+void MappedFile::unmap() noexcept
+{
+    if (data_)
+        UnmapViewOfFile(data_);
+}
+
+#else
+
+MappedFile::MappedFile(const fs::path& path)
+{
+    auto file = open(path.c_str(), O_RDONLY);
+    if (file == -1)
+        return;
+
+    struct stat file_stat;
+    if (fstat(file, &file_stat) == 0 && file_stat.st_size > 0) {
+        auto size = static_cast<std::size_t>(file_stat.st_size);
+        // The mapping stays valid after closing the file descriptor.
+        auto view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (view != MAP_FAILED) {
+            data_ = static_cast<const std::byte*>(view);
+            size_ = size;
+        }
+    }
+    close(file);
+}
+
+void MappedFile::unmap() noexcept
+{
+    if (data_)
+        munmap(const_cast<std::byte*>(data_), size_);
+}
+
+#endif
+
+MappedFile::~MappedFile() { unmap(); }
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr))
+    , size_(std::exchange(other.size_, 0))
+{}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this == &other)
+        return *this;
+    unmap();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    return *this;
+}
+
+} // namespace dang::gl
@@ -0,0 +1,613 @@
+#include "dang-gl/Image/BlockCompression.h"
+
+namespace dang::gl {
+
+namespace {
+
+using detail::BlockCompressionPixel;
+using detail::BlockCompressionPixels;
+
+constexpr std::size_t block_pixel_count = std::tuple_size_v<BlockCompressionPixels>;
+
+using BlockColors = std::array<dmath::vec4, block_pixel_count>;
+using BlockChannel = std::array<int, block_pixel_count>;
+using BlockIndices = std::array<int, block_pixel_count>;
+
+/// @brief Writes values into a block, starting at the least significant bit of the first byte.
+/// @remark The block has to be cleared first, as bits are only ever set.
+class BlockBitWriter {
+public:
+    explicit BlockBitWriter(std::byte* block)
+        : block_(block)
+    {}
+
+    void write(std::uint32_t value, std::size_t bit_count)
+    {
+        for (std::size_t bit = 0; bit < bit_count; bit++, offset_++) {
+            if ((value >> bit) & 1)
+                block_[offset_ / 8] |= std::byte{1} << (offset_ % 8);
+        }
+    }
+
+private:
+    std::byte* block_;
+    std::size_t offset_ = 0;
+};
+
+/// @brief Reads values from a block, starting at the least significant bit of the first byte.
+class BlockBitReader {
+public:
+    explicit BlockBitReader(const std::byte* block)
+        : block_(block)
+    {}
+
+    int read(std::size_t bit_count)
+    {
+        int result = 0;
+        for (std::size_t bit = 0; bit < bit_count; bit++, offset_++) {
+            if (std::to_integer<int>(block_[offset_ / 8] >> (offset_ % 8)) & 1)
+                result |= 1 << bit;
+        }
+        return result;
+    }
+
+private:
+    const std::byte* block_;
+    std::size_t offset_ = 0;
+};
+
+dmath::vec4 clampColor(dmath::vec4 color)
+{
+    for (std::size_t i = 0; i < 4; i++)
+        color[i] = std::clamp(color[i], 0.0f, 255.0f);
+    return color;
+}
+
+/// @brief Returns the ends of the line along the principal axis of the colors, which covers all of them.
+/// @remark The principal axis is found using power iteration on the covariance matrix.
+std::pair<dmath::vec4, dmath::vec4> fitEndpoints(const BlockColors& colors, std::size_t count)
+{
+    dmath::vec4 mean;
+    auto low = colors[0];
+    auto high = colors[0];
+    for (std::size_t i = 0; i < count; i++) {
+        mean += colors[i];
+        low = low.min(colors[i]);
+        high = high.max(colors[i]);
+    }
+    mean /= static_cast<float>(count);
+
+    std::array<dmath::vec4, 4> covariance{};
+    for (std::size_t i = 0; i < count; i++) {
+        auto offset = colors[i] - mean;
+        for (std::size_t row = 0; row < 4; row++)
+            covariance[row] += offset * offset[row];
+    }
+
+    auto axis = high - low;
+    for (int iteration = 0; iteration < 8; iteration++) {
+        dmath::vec4 next(
+            covariance[0].dot(axis), covariance[1].dot(axis), covariance[2].dot(axis), covariance[3].dot(axis));
+        auto length = next.length();
+        if (length < 1e-6f)
+            break;
+        axis = next / length;
+    }
+    if (axis.sqrdot() < 1e-12f)
+        return {mean, mean};
+    axis = axis.normalize();
+
+    auto min_t = std::numeric_limits<float>::max();
+    auto max_t = std::numeric_limits<float>::lowest();
+    for (std::size_t i = 0; i < count; i++) {
+        auto t = (colors[i] - mean).dot(axis);
+        min_t = std::min(min_t, t);
+        max_t = std::max(max_t, t);
+    }
+    return {clampColor(mean + axis * min_t), clampColor(mean + axis * max_t)};
+}
+
+/// @brief Solves for the two endpoints, which minimize the squared error for the given weights of the second endpoint.
+std::optional<std::pair<dmath::vec4, dmath::vec4>> refineEndpoints(const BlockColors& colors,
+                                                                   std::size_t count,
+                                                                   const std::array<float, block_pixel_count>& weights)
+{
+    float aa = 0.0f;
+    float ab = 0.0f;
+    float bb = 0.0f;
+    dmath::vec4 ax;
+    dmath::vec4 bx;
+    for (std::size_t i = 0; i < count; i++) {
+        auto b = weights[i];
+        auto a = 1.0f - b;
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+        ax += colors[i] * a;
+        bx += colors[i] * b;
+    }
+    auto determinant = aa * bb - ab * ab;
+    if (std::abs(determinant) < 1e-6f)
+        return std::nullopt;
+    return std::pair{clampColor((ax * bb - bx * ab) / determinant), clampColor((bx * aa - ax * ab) / determinant)};
+}
+
+int squaredDistance(const BlockCompressionPixel& lhs, const BlockCompressionPixel& rhs, std::size_t components)
+{
+    int result = 0;
+    for (std::size_t i = 0; i < components; i++) {
+        auto difference = static_cast<int>(lhs[i]) - static_cast<int>(rhs[i]);
+        result += difference * difference;
+    }
+    return result;
+}
+
+// --- BC1 and BC3 color blocks
+
+std::uint16_t packRGB565(const dmath::vec4& color)
+{
+    auto quantize = [](float value, int max) { return static_cast<int>(std::lround(value * max / 255.0f)); };
+    return static_cast<std::uint16_t>(quantize(color.x(), 31) << 11 | quantize(color.y(), 63) << 5 |
+                                      quantize(color.z(), 31));
+}
+
+BlockCompressionPixel unpackRGB565(std::uint16_t color)
+{
+    auto r = (color >> 11) & 0x1F;
+    auto g = (color >> 5) & 0x3F;
+    auto b = color & 0x1F;
+    return BlockCompressionPixel(static_cast<GLubyte>(r << 3 | r >> 2),
+                                 static_cast<GLubyte>(g << 2 | g >> 4),
+                                 static_cast<GLubyte>(b << 3 | b >> 2),
+                                 GLubyte{255});
+}
+
+/// @brief Returns the four colors of a color block, where the last color is transparent black in three color mode.
+std::array<BlockCompressionPixel, 4> colorPalette(std::uint16_t color0, std::uint16_t color1, bool four_colors)
+{
+    auto first = unpackRGB565(color0);
+    auto second = unpackRGB565(color1);
+    std::array<BlockCompressionPixel, 4> result{first, second, first, BlockCompressionPixel()};
+    for (std::size_t i = 0; i < 3; i++) {
+        if (four_colors) {
+            result[2][i] = static_cast<GLubyte>((2 * first[i] + second[i]) / 3);
+            result[3][i] = static_cast<GLubyte>((first[i] + 2 * second[i]) / 3);
+        }
+        else {
+            result[2][i] = static_cast<GLubyte>((first[i] + second[i]) / 2);
+        }
+    }
+    if (four_colors)
+        result[3][3] = 255;
+    return result;
+}
+
+struct ColorBlock {
+    std::uint16_t color0 = 0;
+    std::uint16_t color1 = 0;
+    BlockIndices indices{};
+    int error = std::numeric_limits<int>::max();
+};
+
+/// @brief Quantizes the endpoints and finds the closest palette color for each pixel.
+/// @remark Four color mode requires the first color to be bigger, while three color mode requires the opposite.
+ColorBlock encodeColorBlock(const BlockCompressionPixels& pixels,
+                            const std::array<bool, block_pixel_count>& transparent,
+                            const dmath::vec4& endpoint0,
+                            const dmath::vec4& endpoint1,
+                            bool four_colors)
+{
+    ColorBlock result;
+    result.color0 = packRGB565(endpoint0);
+    result.color1 = packRGB565(endpoint1);
+    if ((result.color0 < result.color1) == four_colors)
+        std::swap(result.color0, result.color1);
+
+    auto palette = colorPalette(result.color0, result.color1, four_colors);
+    auto palette_size = four_colors ? 4 : 3;
+    result.error = 0;
+    for (std::size_t i = 0; i < block_pixel_count; i++) {
+        if (transparent[i]) {
+            result.indices[i] = 3;
+            continue;
+        }
+        auto best_error = std::numeric_limits<int>::max();
+        for (int index = 0; index < palette_size; index++) {
+            auto error = squaredDistance(pixels[i], palette[index], 3);
+            if (error < best_error) {
+                best_error = error;
+                result.indices[i] = index;
+            }
+        }
+        result.error += best_error;
+    }
+    return result;
+}
+
+/// @brief Encodes the color of a block in 8 bytes, using three color mode with transparency if allowed and needed.
+void compressColorBlock(const BlockCompressionPixels& pixels, bool allow_transparent, std::byte* block)
+{
+    BlockColors colors;
+    std::array<bool, block_pixel_count> transparent{};
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < block_pixel_count; i++) {
+        transparent[i] = allow_transparent && pixels[i].w() < 128;
+        if (!transparent[i])
+            colors[count++] = dmath::vec4(pixels[i].x(), pixels[i].y(), pixels[i].z(), 0.0f);
+    }
+    auto four_colors = count == block_pixel_count;
+
+    ColorBlock best;
+    if (count == 0) {
+        // Equal colors select three color mode, where the last index is transparent.
+        best.indices.fill(3);
+    }
+    else {
+        auto [endpoint0, endpoint1] = fitEndpoints(colors, count);
+        best = encodeColorBlock(pixels, transparent, endpoint0, endpoint1, four_colors);
+
+        // Improve the endpoints once using the weights of the chosen indices, which refer to the quantized colors.
+        constexpr std::array<float, 4> four_color_weights = {0.0f, 1.0f, 1 / 3.0f, 2 / 3.0f};
+        constexpr std::array<float, 3> three_color_weights = {0.0f, 1.0f, 0.5f};
+        std::array<float, block_pixel_count> weights{};
+        for (std::size_t i = 0, color = 0; i < block_pixel_count; i++) {
+            if (!transparent[i])
+                weights[color++] = four_colors ? four_color_weights[best.indices[i]]
+                                               : three_color_weights[best.indices[i]];
+        }
+        if (auto refined = refineEndpoints(colors, count, weights)) {
+            auto candidate = encodeColorBlock(pixels, transparent, refined->first, refined->second, four_colors);
+            if (candidate.error < best.error)
+                best = candidate;
+        }
+    }
+
+    BlockBitWriter writer(block);
+    writer.write(best.color0, 16);
+    writer.write(best.color1, 16);
+    for (auto index : best.indices)
+        writer.write(static_cast<std::uint32_t>(index), 2);
+}
+
+/// @brief Decodes a color block, which always uses four colors for BC3, regardless of the endpoint order.
+void decompressColorBlock(const std::byte* block, bool always_four_colors, BlockCompressionPixels& pixels)
+{
+    BlockBitReader reader(block);
+    auto color0 = static_cast<std::uint16_t>(reader.read(16));
+    auto color1 = static_cast<std::uint16_t>(reader.read(16));
+    auto palette = colorPalette(color0, color1, always_four_colors || color0 > color1);
+    for (auto& pixel : pixels) {
+        auto alpha = pixel.w();
+        pixel = palette[reader.read(2)];
+        if (always_four_colors)
+            pixel.w() = alpha;
+    }
+}
+
+// --- BC4 and BC5 channel blocks
+
+/// @brief Returns all eight values of a channel block, which only interpolates six values if the first is not bigger.
+std::array<int, 8> channelPalette(int value0, int value1)
+{
+    std::array<int, 8> result{value0, value1};
+    if (value0 > value1) {
+        for (int i = 2; i < 8; i++)
+            result[i] = ((8 - i) * value0 + (i - 1) * value1 + 3) / 7;
+    }
+    else {
+        for (int i = 2; i < 6; i++)
+            result[i] = ((6 - i) * value0 + (i - 1) * value1 + 2) / 5;
+        result[6] = 0;
+        result[7] = 255;
+    }
+    return result;
+}
+
+struct ChannelBlock {
+    int value0 = 0;
+    int value1 = 0;
+    BlockIndices indices{};
+    int error = std::numeric_limits<int>::max();
+};
+
+ChannelBlock encodeChannelBlock(const BlockChannel& values, int value0, int value1)
+{
+    ChannelBlock result{value0, value1};
+    auto palette = channelPalette(value0, value1);
+    result.error = 0;
+    for (std::size_t i = 0; i < block_pixel_count; i++) {
+        auto best_error = std::numeric_limits<int>::max();
+        for (int index = 0; index < 8; index++) {
+            auto error = (values[i] - palette[index]) * (values[i] - palette[index]);
+            if (error < best_error) {
+                best_error = error;
+                result.indices[i] = index;
+            }
+        }
+        result.error += best_error;
+    }
+    return result;
+}
+
+/// @brief Encodes a single channel in 8 bytes, choosing between eight interpolated values or six values plus the
+/// extremes zero and one.
+void compressChannelBlock(const BlockChannel& values, std::byte* block)
+{
+    auto [min, max] = std::minmax_element(values.begin(), values.end());
+    auto best = encodeChannelBlock(values, *max, *min);
+
+    // Six value mode represents zero and one exactly, so only the remaining values need to be interpolated.
+    auto inner_min = 255;
+    auto inner_max = 0;
+    for (auto value : values) {
+        if (value == 0 || value == 255)
+            continue;
+        inner_min = std::min(inner_min, value);
+        inner_max = std::max(inner_max, value);
+    }
+    if (inner_min <= inner_max) {
+        auto candidate = encodeChannelBlock(values, inner_min, inner_max);
+        if (candidate.error < best.error)
+            best = candidate;
+    }
+
+    BlockBitWriter writer(block);
+    writer.write(static_cast<std::uint32_t>(best.value0), 8);
+    writer.write(static_cast<std::uint32_t>(best.value1), 8);
+    for (auto index : best.indices)
+        writer.write(static_cast<std::uint32_t>(index), 3);
+}
+
+BlockChannel decompressChannelBlock(const std::byte* block)
+{
+    BlockBitReader reader(block);
+    auto value0 = reader.read(8);
+    auto value1 = reader.read(8);
+    auto palette = channelPalette(value0, value1);
+    BlockChannel result;
+    for (auto& value : result)
+        value = palette[reader.read(3)];
+    return result;
+}
+
+BlockChannel channelOf(const BlockCompressionPixels& pixels, std::size_t channel)
+{
+    BlockChannel result;
+    for (std::size_t i = 0; i < block_pixel_count; i++)
+        result[i] = pixels[i][channel];
+    return result;
+}
+
+// --- BC7 blocks using mode 6
+
+constexpr std::array<int, 16> bc7_weights = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+/// @brief An endpoint of mode 6, which stores seven bits per channel and shares the lowest bit between all channels.
+struct Bc7Endpoint {
+    std::array<int, 4> values{};
+    int p_bit = 0;
+
+    BlockCompressionPixel color() const
+    {
+        BlockCompressionPixel result;
+        for (std::size_t i = 0; i < 4; i++)
+            result[i] = static_cast<GLubyte>(values[i] << 1 | p_bit);
+        return result;
+    }
+};
+
+/// @brief Quantizes the endpoint with whichever shared lowest bit gives the smaller error.
+Bc7Endpoint quantizeBc7Endpoint(const dmath::vec4& endpoint)
+{
+    Bc7Endpoint best;
+    auto best_error = std::numeric_limits<float>::max();
+    for (int p_bit = 0; p_bit < 2; p_bit++) {
+        Bc7Endpoint candidate;
+        candidate.p_bit = p_bit;
+        auto error = 0.0f;
+        for (std::size_t i = 0; i < 4; i++) {
+            candidate.values[i] = std::clamp(static_cast<int>(std::lround((endpoint[i] - p_bit) / 2.0f)), 0, 127);
+            auto difference = static_cast<float>(candidate.values[i] << 1 | p_bit) - endpoint[i];
+            error += difference * difference;
+        }
+        if (error < best_error) {
+            best_error = error;
+            best = candidate;
+        }
+    }
+    return best;
+}
+
+std::array<BlockCompressionPixel, 16> bc7Palette(const Bc7Endpoint& endpoint0, const Bc7Endpoint& endpoint1)
+{
+    auto first = endpoint0.color();
+    auto second = endpoint1.color();
+    std::array<BlockCompressionPixel, 16> result;
+    for (std::size_t index = 0; index < 16; index++) {
+        auto weight = bc7_weights[index];
+        for (std::size_t i = 0; i < 4; i++)
+            result[index][i] = static_cast<GLubyte>(((64 - weight) * first[i] + weight * second[i] + 32) >> 6);
+    }
+    return result;
+}
+
+struct Bc7Block {
+    Bc7Endpoint endpoint0;
+    Bc7Endpoint endpoint1;
+    BlockIndices indices{};
+    int error = std::numeric_limits<int>::max();
+};
+
+Bc7Block encodeBc7Block(const BlockCompressionPixels& pixels,
+                        const dmath::vec4& endpoint0,
+                        const dmath::vec4& endpoint1)
+{
+    Bc7Block result{quantizeBc7Endpoint(endpoint0), quantizeBc7Endpoint(endpoint1)};
+    auto palette = bc7Palette(result.endpoint0, result.endpoint1);
+    result.error = 0;
+    for (std::size_t i = 0; i < block_pixel_count; i++) {
+        auto best_error = std::numeric_limits<int>::max();
+        for (int index = 0; index < 16; index++) {
+            auto error = squaredDistance(pixels[i], palette[index], 4);
+            if (error < best_error) {
+                best_error = error;
+                result.indices[i] = index;
+            }
+        }
+        result.error += best_error;
+    }
+    return result;
+}
+
+/// @brief Encodes a block in mode 6, which uses a single pair of RGBA endpoints with 16 interpolation steps.
+void compressBc7Block(const BlockCompressionPixels& pixels, std::byte* block)
+{
+    BlockColors colors;
+    for (std::size_t i = 0; i < block_pixel_count; i++)
+        colors[i] = dmath::vec4(pixels[i].x(), pixels[i].y(), pixels[i].z(), pixels[i].w());
+
+    auto [endpoint0, endpoint1] = fitEndpoints(colors, block_pixel_count);
+    auto best = encodeBc7Block(pixels, endpoint0, endpoint1);
+
+    std::array<float, block_pixel_count> weights;
+    for (std::size_t i = 0; i < block_pixel_count; i++)
+        weights[i] = bc7_weights[best.indices[i]] / 64.0f;
+    if (auto refined = refineEndpoints(colors, block_pixel_count, weights)) {
+        auto candidate = encodeBc7Block(pixels, refined->first, refined->second);
+        if (candidate.error < best.error)
+            best = candidate;
+    }
+
+    // The highest bit of the first index is implicitly zero.
+    if (best.indices[0] >= 8) {
+        std::swap(best.endpoint0, best.endpoint1);
+        for (auto& index : best.indices)
+            index = 15 - index;
+    }
+
+    BlockBitWriter writer(block);
+    writer.write(1 << 6, 7);
+    for (std::size_t i = 0; i < 4; i++) {
+        writer.write(static_cast<std::uint32_t>(best.endpoint0.values[i]), 7);
+        writer.write(static_cast<std::uint32_t>(best.endpoint1.values[i]), 7);
+    }
+    writer.write(static_cast<std::uint32_t>(best.endpoint0.p_bit), 1);
+    writer.write(static_cast<std::uint32_t>(best.endpoint1.p_bit), 1);
+    writer.write(static_cast<std::uint32_t>(best.indices[0]), 3);
+    for (std::size_t i = 1; i < block_pixel_count; i++)
+        writer.write(static_cast<std::uint32_t>(best.indices[i]), 4);
+}
+
+BlockCompressionPixels decompressBc7Block(const std::byte* block)
+{
+    BlockBitReader reader(block);
+    if (reader.read(7) != 1 << 6)
+        throw std::invalid_argument("Only BC7 blocks using mode 6 can be decoded.");
+
+    Bc7Endpoint endpoint0;
+    Bc7Endpoint endpoint1;
+    for (std::size_t i = 0; i < 4; i++) {
+        endpoint0.values[i] = reader.read(7);
+        endpoint1.values[i] = reader.read(7);
+    }
+    endpoint0.p_bit = reader.read(1);
+    endpoint1.p_bit = reader.read(1);
+
+    auto palette = bc7Palette(endpoint0, endpoint1);
+    BlockCompressionPixels result;
+    result[0] = palette[reader.read(3)];
+    for (std::size_t i = 1; i < block_pixel_count; i++)
+        result[i] = palette[reader.read(4)];
+    return result;
+}
+
+} // namespace
+
+namespace detail {
+
+void compressBlock(const BlockCompressionPixels& pixels, BlockCompression compression, std::byte* block)
+{
+    std::memset(block, 0, block_compression_block_sizes[compression]);
+    switch (compression) {
+    case BlockCompression::BC1:
+        compressColorBlock(pixels, true, block);
+        return;
+    case BlockCompression::BC3:
+        compressChannelBlock(channelOf(pixels, 3), block);
+        compressColorBlock(pixels, false, block + 8);
+        return;
+    case BlockCompression::BC4:
+        compressChannelBlock(channelOf(pixels, 0), block);
+        return;
+    case BlockCompression::BC5:
+        compressChannelBlock(channelOf(pixels, 0), block);
+        compressChannelBlock(channelOf(pixels, 1), block + 8);
+        return;
+    case BlockCompression::BC7:
+        compressBc7Block(pixels, block);
+        return;
+    default:
+        assert(false);
+    }
+}
+
+BlockCompressionPixels decompressBlock(const std::byte* block, BlockCompression compression)
+{
+    BlockCompressionPixels result;
+    result.fill(BlockCompressionPixel(0, 0, 0, 255));
+    switch (compression) {
+    case BlockCompression::BC1:
+        decompressColorBlock(block, false, result);
+        break;
+    case BlockCompression::BC3: {
+        auto alpha = decompressChannelBlock(block);
+        for (std::size_t i = 0; i < block_pixel_count; i++)
+            result[i].w() = static_cast<GLubyte>(alpha[i]);
+        decompressColorBlock(block + 8, true, result);
+        break;
+    }
+    case BlockCompression::BC4: {
+        auto red = decompressChannelBlock(block);
+        for (std::size_t i = 0; i < block_pixel_count; i++)
+            result[i].x() = static_cast<GLubyte>(red[i]);
+        break;
+    }
+    case BlockCompression::BC5: {
+        auto red = decompressChannelBlock(block);
+        auto green = decompressChannelBlock(block + 8);
+        for (std::size_t i = 0; i < block_pixel_count; i++) {
+            result[i].x() = static_cast<GLubyte>(red[i]);
+            result[i].y() = static_cast<GLubyte>(green[i]);
+        }
+        break;
+    }
+    case BlockCompression::BC7:
+        return decompressBc7Block(block);
+    default:
+        assert(false);
+    }
+    return result;
+}
+
+} // namespace detail
+
+Image2D decompressImage(const CompressedImage& image)
+{
+    constexpr auto block_size = CompressedImage::block_size;
+
+    Image2D result(image.size());
+    auto size = image.size();
+    for (const auto& block_pos : dmath::sbounds2(image.blockCount())) {
+        auto pixels = detail::decompressBlock(image.block(block_pos), image.compression());
+        for (std::size_t y = 0; y < block_size; y++) {
+            for (std::size_t x = 0; x < block_size; x++) {
+                dmath::svec2 pos(block_pos.x() * block_size + x, block_pos.y() * block_size + y);
+                if (pos.lessThan(size).all())
+                    result[pos] = pixels[y * block_size + x];
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace dang::gl
@@ -20,6 +20,12 @@ PNGLoader::PNGLoader(std::istream& stream)
     init(stream);
 }
 
+PNGLoader::PNGLoader(const std::byte* data, std::size_t size)
+    : PNGLoader()
+{
+    init(data, size);
+}
+
 PNGLoader::~PNGLoader() { cleanup(); }
 
 void PNGLoader::init(std::istream& stream)
@@ -30,6 +36,26 @@ void PNGLoader::init(std::istream& stream)
     initialized_ = true;
 
     png_set_read_fn(png_ptr_, &stream, readCallback);
+    readInfo();
+}
+
+void PNGLoader::init(const std::byte* data, std::size_t size)
+{
+    if (initialized_)
+        throw PNGError("PNG already initialized.");
+
+    initialized_ = true;
+
+    memory_ = data;
+    memory_end_ = data + size;
+    png_set_read_fn(png_ptr_, this, memoryReadCallback);
+    readInfo();
+}
+
+dmath::svec2 PNGLoader::size() const { return size_; }
+
+void PNGLoader::readInfo()
+{
     png_read_info(png_ptr_, info_ptr_);
 
     size_.x() = png_get_image_width(png_ptr_, info_ptr_);
@@ -38,8 +64,6 @@ void PNGLoader::init(std::istream& stream)
     png_set_interlace_handling(png_ptr_);
 }
 
-dmath::svec2 PNGLoader::size() const { return size_; }
-
 void PNGLoader::handleBitDepth()
 {
     if (color_type_ == PNG_COLOR_TYPE_PALETTE) {
@@ -71,11 +95,20 @@ void PNGLoader::warningCallback(png_structp png_ptr, png_const_charp message)
 
 void PNGLoader::readCallback(png_structp png_ptr, png_bytep bytes, png_size_t size)
 {
-    auto& stream = *static_cast<std::ifstream*>(png_get_io_ptr(png_ptr));
+    auto& stream = *static_cast<std::istream*>(png_get_io_ptr(png_ptr));
     if (!stream.read(reinterpret_cast<char*>(bytes), size))
         throw PNGError("Unexpected eof while reading PNG.");
 }
 
+void PNGLoader::memoryReadCallback(png_structp png_ptr, png_bytep bytes, png_size_t size)
+{
+    auto& png_loader = *static_cast<PNGLoader*>(png_get_io_ptr(png_ptr));
+    if (static_cast<std::size_t>(png_loader.memory_end_ - png_loader.memory_) < size)
+        throw PNGError("Unexpected eof while reading PNG.");
+    std::memcpy(bytes, png_loader.memory_, size);
+    png_loader.memory_ += size;
+}
+
 void PNGLoader::cleanup() { png_destroy_read_struct(&png_ptr_, &info_ptr_, nullptr); }
 
 } // namespace dang::gl
@@ -157,8 +157,14 @@ void FBO::blitFrom(const FBO& other, BufferMask mask, BlitFilter filter)
 {
     if (!size_ || !other.size_)
         return;
-    ibounds2 src_rect(ivec2{*size_});
-    ibounds2 dst_rect(ivec2{*other.size_});
+    ibounds2 src_rect(ivec2{*other.size_});
+    ibounds2 dst_rect(ivec2{*size_});
+    blit(objectContext(), other.handle(), handle(), src_rect, dst_rect, mask, filter);
+}
+
+void FBO::blitFrom(
+    const FBO& other, const ibounds2& src_rect, const ibounds2& dst_rect, BufferMask mask, BlitFilter filter)
+{
     blit(objectContext(), other.handle(), handle(), src_rect, dst_rect, mask, filter);
 }
 
@@ -216,16 +222,14 @@ void FBO::blit(ObjectContext<ObjectType::Framebuffer>& context,
 {
     context.bind(FramebufferTarget::ReadFramebuffer, read_framebuffer);
     context.bind(FramebufferTarget::DrawFramebuffer, draw_framebuffer);
-    const auto& src_size = src_rect.size();
-    const auto& dst_size = dst_rect.size();
     glBlitFramebuffer(src_rect.low.x(),
                       src_rect.low.y(),
-                      src_size.x(),
-                      src_size.y(),
+                      src_rect.high.x(),
+                      src_rect.high.y(),
                       dst_rect.low.x(),
                       dst_rect.low.y(),
-                      dst_size.x(),
-                      dst_size.y(),
+                      dst_rect.high.x(),
+                      dst_rect.high.y(),
                       static_cast<GLbitfield>(mask),
                       toGLConstant(filter));
 }
@@ -0,0 +1,29 @@
+#include "dang-gl/Objects/PBO.h"
+
+namespace dang::gl {
+
+PBO::PBO(std::size_t size)
+    : size_(size)
+{
+    bind();
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_DRAW);
+}
+
+std::byte* PBO::mapRange(std::size_t offset, std::size_t size)
+{
+    assert(offset + size <= size_);
+    bind();
+    return static_cast<std::byte*>(
+        glMapBufferRange(GL_PIXEL_UNPACK_BUFFER,
+                         static_cast<GLintptr>(offset),
+                         static_cast<GLsizeiptr>(size),
+                         GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+}
+
+void PBO::unmap()
+{
+    bind();
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+}
+
+} // namespace dang::gl
@@ -91,9 +91,19 @@ void Program::loadUniformLocations()
     if (active_uniforms == 0)
         return;
 
+    std::vector<GLuint> indices(static_cast<std::size_t>(active_uniforms));
+    for (std::size_t i = 0; i < indices.size(); i++)
+        indices[i] = static_cast<GLuint>(i);
+    std::vector<GLint> block_indices(indices.size());
+    glGetActiveUniformsiv(
+        handle().unwrap(), active_uniforms, indices.data(), GL_UNIFORM_BLOCK_INDEX, block_indices.data());
+
     GLint max_length;
     glGetProgramiv(handle().unwrap(), GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length);
     for (GLint i = 0; i < active_uniforms; i++) {
+        if (block_indices[static_cast<std::size_t>(i)] != -1)
+            continue;
+
         std::string name(static_cast<std::size_t>(max_length) - 1, '\0');
         GLsizei actual_length;
         GLint data_size;
@@ -106,6 +116,76 @@ void Program::loadUniformLocations()
     }
 }
 
+void Program::loadUniformBlocks()
+{
+    GLint active_blocks;
+    glGetProgramiv(handle().unwrap(), GL_ACTIVE_UNIFORM_BLOCKS, &active_blocks);
+    if (active_blocks == 0)
+        return;
+
+    GLint max_length;
+    glGetProgramiv(handle().unwrap(), GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &max_length);
+    GLint max_member_length;
+    glGetProgramiv(handle().unwrap(), GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_member_length);
+    for (GLuint index = 0; index < static_cast<GLuint>(active_blocks); index++) {
+        std::string name(static_cast<std::size_t>(max_length) - 1, '\0');
+        GLsizei actual_length;
+        glGetActiveUniformBlockName(handle().unwrap(), index, max_length, &actual_length, &name[0]);
+        name.resize(static_cast<std::size_t>(actual_length));
+
+        GLint data_size;
+        glGetActiveUniformBlockiv(handle().unwrap(), index, GL_UNIFORM_BLOCK_DATA_SIZE, &data_size);
+        GLint member_count;
+        glGetActiveUniformBlockiv(handle().unwrap(), index, GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS, &member_count);
+        std::vector<GLint> member_indices(static_cast<std::size_t>(member_count));
+        glGetActiveUniformBlockiv(
+            handle().unwrap(), index, GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES, member_indices.data());
+        std::vector<GLuint> uniform_indices(member_indices.begin(), member_indices.end());
+
+        auto query = [&](GLenum property) {
+            std::vector<GLint> values(uniform_indices.size());
+            glGetActiveUniformsiv(handle().unwrap(), member_count, uniform_indices.data(), property, values.data());
+            return values;
+        };
+        auto types = query(GL_UNIFORM_TYPE);
+        auto counts = query(GL_UNIFORM_SIZE);
+        auto offsets = query(GL_UNIFORM_OFFSET);
+        auto array_strides = query(GL_UNIFORM_ARRAY_STRIDE);
+        auto matrix_strides = query(GL_UNIFORM_MATRIX_STRIDE);
+
+        std::vector<ShaderUniformBlockMember> members;
+        for (std::size_t i = 0; i < uniform_indices.size(); i++) {
+            auto& member = members.emplace_back();
+            member.name.resize(static_cast<std::size_t>(max_member_length) - 1);
+            GLsizei member_length;
+            glGetActiveUniformName(
+                handle().unwrap(), uniform_indices[i], max_member_length, &member_length, &member.name[0]);
+            member.name.resize(static_cast<std::size_t>(member_length));
+
+            auto& layout = member.layout;
+            layout.type = static_cast<DataType>(types[i]);
+            layout.count = static_cast<std::size_t>(counts[i]);
+            layout.offset = static_cast<std::size_t>(offsets[i]);
+            layout.array_stride = static_cast<std::size_t>(array_strides[i]);
+            layout.matrix_stride = static_cast<std::size_t>(matrix_strides[i]);
+            if (layout.array_stride != 0)
+                layout.size = layout.count * layout.array_stride;
+            else if (layout.matrix_stride != 0)
+                layout.size = static_cast<std::size_t>(getDataTypeColumnCount(layout.type)) * layout.matrix_stride;
+            else
+                layout.size = static_cast<std::size_t>(getDataTypeSize(layout.type));
+        }
+        std::sort(members.begin(), members.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.layout.offset < rhs.layout.offset;
+        });
+
+        uniform_blocks_.emplace(std::piecewise_construct,
+                                std::forward_as_tuple(name),
+                                std::forward_as_tuple(
+                                    *this, index, name, static_cast<std::size_t>(data_size), std::move(members)));
+    }
+}
+
 void Program::setAttributeOrder(const AttributeNames& attribute_order,
                                 const InstancedAttributeNames& instanced_attribute_order)
 {
@@ -179,6 +259,7 @@ void Program::link(const AttributeNames& attribute_order, const InstancedAttribu
     postLinkCleanup();
     loadAttributeLocations();
     loadUniformLocations();
+    loadUniformBlocks();
     setAttributeOrder(attribute_order, instanced_attribute_order);
 }
 
@@ -201,8 +282,14 @@ ShaderUniformSampler& Program::uniformSampler(const std::string& name, GLint cou
     return uniform<GLint>(name, count);
 }
 
+ShaderUniformBlock* Program::uniformBlock(const std::string& name)
+{
+    auto pos = uniform_blocks_.find(name);
+    return pos != uniform_blocks_.end() ? &pos->second : nullptr;
+}
+
 ShaderVariable::ShaderVariable(const Program& program, GLint count, DataType type, std::string name, GLint location)
-    : context_(&program.objectContext())
+    : context_(program ? &program.objectContext() : nullptr)
     , program_(program.handle())
     , count_(count)
     , type_(type)
@@ -226,6 +313,14 @@ ShaderUniformBase::ShaderUniformBase(const Program& program, GLint count, DataTy
     : ShaderVariable(program, count, type, name, glGetUniformLocation(program.handle().unwrap(), name.c_str()))
 {}
 
+ShaderUniformBase::ShaderUniformBase(const Program& program,
+                                     GLint count,
+                                     DataType type,
+                                     std::string name,
+                                     GLint location)
+    : ShaderVariable(program, count, type, std::move(name), location)
+{}
+
 std::unique_ptr<ShaderUniformBase> ShaderUniformBase::create(const Program& program,
                                                              GLint count,
                                                              DataType type,
@@ -394,6 +489,60 @@ std::unique_ptr<ShaderUniformBase> ShaderUniformBase::create(const Program& prog
     }
 }
 
+ShaderUniformBlock::ShaderUniformBlock(const Program& program,
+                                       GLuint index,
+                                       std::string name,
+                                       std::size_t data_size,
+                                       std::vector<ShaderUniformBlockMember> members)
+    : program_(program.handle())
+    , index_(index)
+    , name_(std::move(name))
+    , data_size_(data_size)
+    , members_(std::move(members))
+{
+    GLint binding_point;
+    glGetActiveUniformBlockiv(program_.unwrap(), index_, GL_UNIFORM_BLOCK_BINDING, &binding_point);
+    binding_point_ = static_cast<GLuint>(binding_point);
+}
+
+GLuint ShaderUniformBlock::index() const { return index_; }
+
+const std::string& ShaderUniformBlock::name() const { return name_; }
+
+std::size_t ShaderUniformBlock::dataSize() const { return data_size_; }
+
+const std::vector<ShaderUniformBlockMember>& ShaderUniformBlock::members() const { return members_; }
+
+void ShaderUniformBlock::validate(const BufferLayoutMember* members, std::size_t member_count, std::size_t size) const
+{
+    if (member_count != members_.size())
+        throw ShaderUniformError("Shader-Uniform-Block member count does not match: " + name_);
+    if (size < data_size_)
+        throw ShaderUniformError("Shader-Uniform-Block size does not match: " + name_);
+
+    for (std::size_t i = 0; i < member_count; i++) {
+        const auto& expected = members_[i].layout;
+        const auto& actual = members[i];
+        if (actual.type != expected.type || actual.count != expected.count)
+            throw ShaderUniformError("Shader-Uniform-Block member type does not match: " + name_ + "." +
+                                     members_[i].name);
+        if (actual.offset != expected.offset || actual.array_stride != expected.array_stride ||
+            actual.matrix_stride != expected.matrix_stride)
+            throw ShaderUniformError("Shader-Uniform-Block member layout does not match: " + name_ + "." +
+                                     members_[i].name);
+    }
+}
+
+GLuint ShaderUniformBlock::bindingPoint() const { return binding_point_; }
+
+void ShaderUniformBlock::setBindingPoint(GLuint binding_point)
+{
+    if (binding_point_ == binding_point)
+        return;
+    glUniformBlockBinding(program_.unwrap(), index_, binding_point);
+    binding_point_ = binding_point;
+}
+
 ShaderAttribute::ShaderAttribute(const Program& program, GLint count, DataType type, std::string name)
     : ShaderVariable(program, count, type, name, glGetAttribLocation(program.handle().unwrap(), name.c_str()))
 {}
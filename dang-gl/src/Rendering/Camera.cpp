@@ -134,6 +134,7 @@ mat4 OrthoProjection::calculateMatrix()
 
 CameraUniforms::CameraUniforms(Program& program, const CameraUniformNames& names)
     : program_(program)
+    , block_(program.uniformBlock(names.block))
     , projection_uniform_(program.uniform<mat4>(names.projection_matrix))
     , transform_uniforms_{program.uniform<mat2x4>(names.model_transform),
                           program.uniform<mat2x4>(names.view_transform),
@@ -142,6 +143,8 @@ CameraUniforms::CameraUniforms(Program& program, const CameraUniformNames& names
 
 Program& CameraUniforms::program() const { return program_; }
 
+ShaderUniformBlock* CameraUniforms::block() const { return block_; }
+
 void CameraUniforms::updateProjectionMatrix(const mat4& projection_matrix) const
 {
     ShaderUniform<mat4>& uniform = projection_uniform_;
@@ -181,15 +184,44 @@ const SharedProjectionProvider& Camera::projectionProvider() const { return proj
 
 const SharedTransform& Camera::transform() const { return transform_; }
 
+const RenderQueueStats& Camera::renderStats() const { return render_queue_.stats(); }
+
 void Camera::setCustomUniforms(Program& program, const CameraUniformNames& names)
 {
-    auto program_matches = [&](const CameraUniforms& uniforms) { return &uniforms.program() != &program; };
+    auto program_matches = [&](const CameraUniforms& uniforms) { return &uniforms.program() == &program; };
 
     auto uniforms = std::find_if(uniforms_.begin(), uniforms_.end(), program_matches);
     if (uniforms == uniforms_.end())
-        uniforms_.emplace_back(program, names);
+        initUniforms(uniforms_.emplace_back(program, names));
     else
-        *uniforms = CameraUniforms(program, names);
+        initUniforms(*uniforms = CameraUniforms(program, names));
+}
+
+const CameraUniforms& Camera::uniformsFor(Program& program) const
+{
+    auto program_matches = [&](const CameraUniforms& uniforms) { return &uniforms.program() == &program; };
+
+    auto uniforms = std::find_if(uniforms_.begin(), uniforms_.end(), program_matches);
+    if (uniforms != uniforms_.end())
+        return *uniforms;
+    const auto& new_uniforms = uniforms_.emplace_back(program);
+    initUniforms(new_uniforms);
+    return new_uniforms;
+}
+
+void Camera::initUniforms(const CameraUniforms& uniforms) const
+{
+    if (auto block = uniforms.block()) {
+        if (!buffer_) {
+            buffer_.emplace();
+            buffer_->write(block_);
+        }
+        buffer_->attach(*block);
+    }
+    else {
+        uniforms.updateProjectionMatrix(block_.projection_matrix);
+        uniforms.updateTransform(CameraTransformType::View, view_transform_);
+    }
 }
 
 } // namespace dang::gl
@@ -0,0 +1,139 @@
+#include "Rendering/RenderQueue.h"
+
+namespace dang::gl {
+
+namespace {
+
+constexpr unsigned radix_bits = 8;
+constexpr std::size_t radix_size = std::size_t{1} << radix_bits;
+constexpr std::uint64_t radix_mask = radix_size - 1;
+constexpr std::size_t radix_passes = 64 / radix_bits;
+
+} // namespace
+
+void RenderQueue::clear()
+{
+    items_.clear();
+    program_numbers_.clear();
+    texture_set_numbers_.clear();
+    vertex_array_numbers_.clear();
+}
+
+void RenderQueue::push(const Renderable& renderable, float depth)
+{
+    auto key = makeKey(renderable.renderPass(),
+                       stateNumber(program_numbers_, &renderable.program()),
+                       stateNumber(texture_set_numbers_, renderable.textureSet()),
+                       stateNumber(vertex_array_numbers_, renderable.vertexArray()),
+                       quantizeDepth(depth));
+    items_.push_back({key, &renderable});
+}
+
+void RenderQueue::sort()
+{
+    if (items_.size() < 2)
+        return;
+
+    // Count all digits up front, which only requires a single pass over the keys.
+    std::array<std::array<std::size_t, radix_size>, radix_passes> counts{};
+    for (const auto& item : items_) {
+        for (std::size_t pass = 0; pass < radix_passes; pass++)
+            counts[pass][(item.key >> (pass * radix_bits)) & radix_mask]++;
+    }
+
+    sort_buffer_.resize(items_.size());
+    for (std::size_t pass = 0; pass < radix_passes; pass++) {
+        auto shift = pass * radix_bits;
+        auto& offsets = counts[pass];
+
+        // Skip digits, which are the same for all keys, e.g. unused passes or the upper bits of state numbers.
+        if (offsets[(items_.front().key >> shift) & radix_mask] == items_.size())
+            continue;
+
+        std::size_t offset = 0;
+        for (auto& count : offsets)
+            offset += std::exchange(count, offset);
+
+        for (const auto& item : items_)
+            sort_buffer_[offsets[(item.key >> shift) & radix_mask]++] = item;
+        items_.swap(sort_buffer_);
+    }
+}
+
+const std::vector<RenderQueueItem>& RenderQueue::items() const { return items_; }
+
+const RenderQueueStats& RenderQueue::stats() const { return stats_; }
+
+void RenderQueue::makeBatches(const std::vector<RenderQueueItem>& items, std::vector<RenderQueueBatch>& batches)
+{
+    batches.clear();
+    for (std::size_t first = 0; first < items.size();) {
+        const auto& renderable = *items[first].renderable;
+        auto last = first + 1;
+        bool instanced = renderable.instanceTransforms() != nullptr;
+        if (instanced) {
+            while (last < items.size() && sameBatch(renderable, *items[last].renderable))
+                last++;
+        }
+        batches.push_back({first, last - first, instanced});
+        first = last;
+    }
+}
+
+std::uint64_t RenderQueue::makeKey(RenderPass pass,
+                                   std::uint64_t program,
+                                   std::uint64_t texture_set,
+                                   std::uint64_t vertex_array,
+                                   std::uint64_t depth)
+{
+    auto key = static_cast<std::uint64_t>(pass);
+    if (pass == RenderPass::Transparent) {
+        key = (key << depth_bits) | (((std::uint64_t{1} << depth_bits) - 1) - depth);
+        key = (key << state_bits) | program;
+        key = (key << state_bits) | texture_set;
+        key = (key << state_bits) | vertex_array;
+    }
+    else {
+        key = (key << state_bits) | program;
+        key = (key << state_bits) | texture_set;
+        key = (key << state_bits) | vertex_array;
+        key = (key << depth_bits) | depth;
+    }
+    return key;
+}
+
+std::uint64_t RenderQueue::quantizeDepth(float depth)
+{
+    // Bit patterns of positive floats have the same order as their values and never use the sign bit.
+    if (!(depth > 0.0f))
+        return 0;
+    std::uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    return bits >> (31 - depth_bits);
+}
+
+bool RenderQueue::sameBatch(const Renderable& first, const Renderable& other)
+{
+    return other.instanceTransforms() == first.instanceTransforms() && &other.program() == &first.program() &&
+           other.vertexArray() == first.vertexArray() && other.textureSet() == first.textureSet();
+}
+
+void RenderQueue::writeInstanceTransforms(std::vector<RenderQueueItem>::const_iterator first,
+                                          std::vector<RenderQueueItem>::const_iterator last)
+{
+    instance_transforms_.clear();
+    for (auto item = first; item != last; ++item) {
+        const auto& transform = item->renderable->transform();
+        instance_transforms_.push_back(transform ? transform->fullTransform().toMatrix2x4() : dquat().toMatrix2x4());
+    }
+    // Respecifying the whole buffer lets the driver hand out new storage, instead of waiting for previous draws.
+    first->renderable->instanceTransforms()->generate(instance_transforms_, BufferUsageHint::StreamDraw);
+}
+
+std::uint64_t RenderQueue::stateNumber(StateNumbers& numbers, const void* state)
+{
+    constexpr std::uint64_t max_number = (std::uint64_t{1} << state_bits) - 1;
+    return numbers.try_emplace(state, std::min(std::uint64_t{numbers.size()}, max_number)).first->second;
+}
+
+} // namespace dang::gl
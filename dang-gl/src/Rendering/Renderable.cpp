@@ -6,4 +6,14 @@ bool Renderable::isVisible() const { return true; }
 
 SharedTransform Renderable::transform() const { return nullptr; }
 
+RenderPass Renderable::renderPass() const { return RenderPass::Opaque; }
+
+const VAOBase* Renderable::vertexArray() const { return nullptr; }
+
+const void* Renderable::textureSet() const { return nullptr; }
+
+void Renderable::bindTextures() const {}
+
+VBO<mat2x4>* Renderable::instanceTransforms() const { return nullptr; }
+
 } // namespace dang::gl
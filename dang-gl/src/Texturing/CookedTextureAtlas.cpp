@@ -0,0 +1,191 @@
+#include "dang-gl/Texturing/CookedTextureAtlas.h"
+
+namespace dang::gl {
+
+namespace {
+
+constexpr std::array<char, 8> cooked_atlas_magic = {'D', 'G', 'L', 'A', 'T', 'L', 'A', 'S'};
+
+/// @brief Images start at a multiple of this, so that the pixels of any type are properly aligned in the mapping.
+constexpr std::size_t cooked_atlas_image_alignment = 16;
+
+/// @brief Position, size, border and name length of a tile, followed by the name itself.
+constexpr std::size_t cooked_atlas_min_tile_size = 7 * sizeof(std::uint32_t);
+/// @brief Offset and size of an image.
+constexpr std::size_t cooked_atlas_image_entry_size = 2 * sizeof(std::uint64_t);
+
+std::size_t alignImageOffset(std::size_t offset)
+{
+    return (offset + cooked_atlas_image_alignment - 1) / cooked_atlas_image_alignment * cooked_atlas_image_alignment;
+}
+
+template <typename T>
+void writeValue(std::ostream& stream, const T& value)
+{
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/// @brief Reads values from the mapped file, making sure that it is never read past its end.
+class CookedAtlasReader {
+public:
+    CookedAtlasReader(const MappedFile& file)
+        : data_(file.data())
+        , size_(file.size())
+    {}
+
+    template <typename T>
+    T read()
+    {
+        T result;
+        std::memcpy(&result, skip(sizeof(T)), sizeof(T));
+        return result;
+    }
+
+    std::string readString(std::size_t length)
+    {
+        auto data = skip(length);
+        return std::string(reinterpret_cast<const char*>(data), length);
+    }
+
+    /// @brief Makes sure, that a table with the given number of entries fits into the remaining bytes, before any
+    /// memory is reserved for it.
+    void checkCount(std::size_t count, std::size_t min_entry_size) const
+    {
+        if (count > (size_ - offset_) / min_entry_size)
+            throw CookedTextureAtlasError("Cooked texture atlas is truncated.");
+    }
+
+    /// @brief Returns a pointer to the given number of bytes at the offset.
+    const std::byte* at(std::size_t offset, std::size_t size) const
+    {
+        if (offset > size_ || size > size_ - offset)
+            throw CookedTextureAtlasError("Cooked texture atlas is truncated.");
+        return data_ + offset;
+    }
+
+private:
+    const std::byte* skip(std::size_t size)
+    {
+        auto result = at(offset_, size);
+        offset_ += size;
+        return result;
+    }
+
+    const std::byte* data_;
+    std::size_t size_;
+    std::size_t offset_ = 0;
+};
+
+} // namespace
+
+CookedTextureAtlasFile::CookedTextureAtlasFile(const fs::path& path)
+    : file_(path)
+{
+    if (!file_)
+        throw CookedTextureAtlasError("Cannot map cooked texture atlas \"" + path.string() + "\".");
+
+    CookedAtlasReader reader(file_);
+    if (reader.read<std::array<char, 8>>() != cooked_atlas_magic)
+        throw CookedTextureAtlasError("\"" + path.string() + "\" is not a cooked texture atlas.");
+    auto file_version = reader.read<std::uint32_t>();
+    if (file_version != version)
+        throw CookedTextureAtlasError("Cooked texture atlas \"" + path.string() + "\" has an unsupported version. (" +
+                                      std::to_string(file_version) + " != " + std::to_string(version) + ")");
+
+    info_.pixel_format = reader.read<std::uint32_t>();
+    info_.pixel_type = reader.read<std::uint32_t>();
+    info_.row_alignment = reader.read<std::uint32_t>();
+    if (auto compression = reader.read<std::uint32_t>(); compression != 0) {
+        if (compression > dutils::enum_count_v<BlockCompression>)
+            throw CookedTextureAtlasError("Cooked texture atlas has an invalid compression.");
+        info_.compression = static_cast<BlockCompression>(compression - 1);
+    }
+    auto packing = reader.read<std::uint32_t>();
+    if (packing > static_cast<std::uint32_t>(TextureAtlasPacking::MaxRects))
+        throw CookedTextureAtlasError("Cooked texture atlas has an invalid packing.");
+    info_.packing = static_cast<TextureAtlasPacking>(packing);
+    info_.atlas_size = reader.read<std::int32_t>();
+    info_.layer_count = reader.read<std::int32_t>();
+    info_.mipmap_levels = reader.read<std::int32_t>();
+    if (info_.atlas_size < 0 || info_.layer_count < 0 || info_.mipmap_levels < 1 ||
+        info_.mipmap_levels > dutils::ilog2(static_cast<std::uint32_t>(std::max(info_.atlas_size, 1))) + 1)
+        throw CookedTextureAtlasError("Cooked texture atlas has an invalid size.");
+
+    auto tile_count = reader.read<std::uint32_t>();
+    reader.checkCount(tile_count, cooked_atlas_min_tile_size);
+    info_.tiles.reserve(tile_count);
+    for (std::uint32_t i = 0; i < tile_count; i++) {
+        auto& tile = info_.tiles.emplace_back();
+        tile.position = {reader.read<std::int32_t>(), reader.read<std::int32_t>(), reader.read<std::int32_t>()};
+        tile.size = {reader.read<std::int32_t>(), reader.read<std::int32_t>()};
+        auto border = reader.read<std::uint32_t>();
+        if (border > static_cast<std::uint32_t>(TextureAtlasTileBorderGeneration::All))
+            throw CookedTextureAtlasError("Cooked texture atlas has an invalid tile border.");
+        tile.border = static_cast<TextureAtlasTileBorderGeneration>(border);
+        tile.name = reader.readString(reader.read<std::uint32_t>());
+    }
+
+    auto image_count = static_cast<std::size_t>(info_.layer_count) * info_.mipmap_levels;
+    reader.checkCount(image_count, cooked_atlas_image_entry_size);
+    images_.reserve(image_count);
+    for (std::size_t i = 0; i < image_count; i++) {
+        auto offset = static_cast<std::size_t>(reader.read<std::uint64_t>());
+        auto size = static_cast<std::size_t>(reader.read<std::uint64_t>());
+        images_.push_back({reader.at(offset, size), size});
+    }
+}
+
+void CookedTextureAtlasFile::write(std::ostream& stream,
+                                   const CookedTextureAtlasInfo& info,
+                                   const std::vector<CookedTextureAtlasImage>& images)
+{
+    assert(images.size() == static_cast<std::size_t>(info.layer_count) * info.mipmap_levels);
+
+    writeValue(stream, cooked_atlas_magic);
+    writeValue(stream, version);
+    writeValue(stream, static_cast<std::uint32_t>(info.pixel_format));
+    writeValue(stream, static_cast<std::uint32_t>(info.pixel_type));
+    writeValue(stream, info.row_alignment);
+    // Zero means uncompressed, so that compressions are stored offset by one.
+    writeValue(stream, info.compression ? static_cast<std::uint32_t>(*info.compression) + 1 : std::uint32_t{0});
+    writeValue(stream, static_cast<std::uint32_t>(info.packing));
+    writeValue(stream, static_cast<std::int32_t>(info.atlas_size));
+    writeValue(stream, static_cast<std::int32_t>(info.layer_count));
+    writeValue(stream, static_cast<std::int32_t>(info.mipmap_levels));
+
+    writeValue(stream, static_cast<std::uint32_t>(info.tiles.size()));
+    std::size_t offset = sizeof(cooked_atlas_magic) + 10 * sizeof(std::uint32_t);
+    for (const auto& tile : info.tiles) {
+        writeValue(stream, static_cast<std::int32_t>(tile.position.x()));
+        writeValue(stream, static_cast<std::int32_t>(tile.position.y()));
+        writeValue(stream, static_cast<std::int32_t>(tile.position.z()));
+        writeValue(stream, static_cast<std::int32_t>(tile.size.x()));
+        writeValue(stream, static_cast<std::int32_t>(tile.size.y()));
+        writeValue(stream, static_cast<std::uint32_t>(tile.border));
+        writeValue(stream, static_cast<std::uint32_t>(tile.name.size()));
+        stream.write(tile.name.data(), static_cast<std::streamsize>(tile.name.size()));
+        offset += cooked_atlas_min_tile_size + tile.name.size();
+    }
+
+    // Image offsets can only be known once the size of the image table itself is known.
+    offset += images.size() * cooked_atlas_image_entry_size;
+    auto written = offset;
+    std::vector<std::size_t> image_offsets;
+    image_offsets.reserve(images.size());
+    for (const auto& image : images) {
+        offset = alignImageOffset(offset);
+        image_offsets.push_back(offset);
+        writeValue(stream, static_cast<std::uint64_t>(offset));
+        writeValue(stream, static_cast<std::uint64_t>(image.size));
+        offset += image.size;
+    }
+
+    for (std::size_t i = 0; i < images.size(); i++) {
+        static constexpr std::array<char, cooked_atlas_image_alignment> padding{};
+        stream.write(padding.data(), static_cast<std::streamsize>(image_offsets[i] - written));
+        stream.write(reinterpret_cast<const char*>(images[i].data), static_cast<std::streamsize>(images[i].size));
+        written = image_offsets[i] + images[i].size;
+    }
+}
+
+} // namespace dang::gl
@@ -0,0 +1,110 @@
+#include "dang-gl/Texturing/MaxRectsPacker.h"
+
+namespace dang::gl {
+
+MaxRectsPacker::MaxRectsPacker(svec2 size)
+    : size_(size)
+    , free_rects_{ibounds2(size)}
+{}
+
+std::optional<svec2> MaxRectsPacker::insert(svec2 size)
+{
+    // used size, used area, short side leftover, y, x
+    using Score = std::tuple<GLsizei, GLsizei, GLsizei, GLint, GLint>;
+
+    std::optional<ibounds2> best_rect;
+    Score best_score;
+    for (const auto& free_rect : free_rects_) {
+        auto free_size = free_rect.size();
+        if (size.x() > free_size.x() || size.y() > free_size.y())
+            continue;
+        auto used_size = used_size_.max(free_rect.low + size);
+        auto leftover = free_size - size;
+        Score score(used_size.maxValue(),
+                    used_size.product(),
+                    std::min(leftover.x(), leftover.y()),
+                    free_rect.low.y(),
+                    free_rect.low.x());
+        if (!best_rect || score < best_score) {
+            best_rect = ibounds2(free_rect.low, free_rect.low + size);
+            best_score = score;
+        }
+    }
+    if (!best_rect)
+        return std::nullopt;
+
+    occupy(*best_rect);
+    used_size_ = used_size_.max(best_rect->high);
+    return best_rect->low;
+}
+
+void MaxRectsPacker::remove(const ibounds2& rect)
+{
+    // Grow the freed rectangle by all free rectangles that touch it along a full edge.
+    auto merged = rect;
+    bool grown = true;
+    while (grown) {
+        grown = false;
+        for (const auto& free_rect : free_rects_) {
+            bool same_rows = free_rect.low.y() == merged.low.y() && free_rect.high.y() == merged.high.y();
+            bool same_columns = free_rect.low.x() == merged.low.x() && free_rect.high.x() == merged.high.x();
+            bool touches_x = free_rect.low.x() <= merged.high.x() && free_rect.high.x() >= merged.low.x();
+            bool touches_y = free_rect.low.y() <= merged.high.y() && free_rect.high.y() >= merged.low.y();
+            if ((same_rows && touches_x) || (same_columns && touches_y)) {
+                ibounds2 joined(merged.low.min(free_rect.low), merged.high.max(free_rect.high));
+                if (joined != merged) {
+                    merged = joined;
+                    grown = true;
+                }
+            }
+        }
+    }
+    addFreeRect(merged);
+}
+
+void MaxRectsPacker::occupy(const ibounds2& rect)
+{
+    std::vector<ibounds2> split_rects;
+    std::size_t index = 0;
+    while (index < free_rects_.size()) {
+        auto free_rect = free_rects_[index];
+        if (!rect.low.lessThan(free_rect.high).all() || !free_rect.low.lessThan(rect.high).all()) {
+            index++;
+            continue;
+        }
+        free_rects_[index] = free_rects_.back();
+        free_rects_.pop_back();
+
+        // Keep the maximal free rectangles on each side of the occupied rectangle.
+        if (rect.low.x() > free_rect.low.x())
+            split_rects.emplace_back(free_rect.low, ivec2(rect.low.x(), free_rect.high.y()));
+        if (rect.high.x() < free_rect.high.x())
+            split_rects.emplace_back(ivec2(rect.high.x(), free_rect.low.y()), free_rect.high);
+        if (rect.low.y() > free_rect.low.y())
+            split_rects.emplace_back(free_rect.low, ivec2(free_rect.high.x(), rect.low.y()));
+        if (rect.high.y() < free_rect.high.y())
+            split_rects.emplace_back(ivec2(free_rect.low.x(), rect.high.y()), free_rect.high);
+    }
+    for (const auto& split_rect : split_rects)
+        addFreeRect(split_rect);
+}
+
+bool MaxRectsPacker::containsRect(const ibounds2& outer, const ibounds2& inner)
+{
+    return outer.low.lessThanEqual(inner.low).all() && inner.high.lessThanEqual(outer.high).all();
+}
+
+void MaxRectsPacker::addFreeRect(const ibounds2& rect)
+{
+    if (std::any_of(free_rects_.begin(), free_rects_.end(), [&](const ibounds2& free_rect) {
+            return containsRect(free_rect, rect);
+        }))
+        return;
+    free_rects_.erase(std::remove_if(free_rects_.begin(),
+                                     free_rects_.end(),
+                                     [&](const ibounds2& free_rect) { return containsRect(rect, free_rect); }),
+                      free_rects_.end());
+    free_rects_.push_back(rect);
+}
+
+} // namespace dang::gl
@@ -35,4 +35,22 @@ TextureAtlasLimits checkLimits(std::optional<GLsizei> max_texture_size, std::opt
     return {checkMaxTextureSize(max_texture_size), checkMaxLayerCount(max_layer_count)};
 }
 
+Texture2DArray resizeTexture(const Texture2DArray& texture,
+                             GLsizei required_size,
+                             GLsizei layers,
+                             GLsizei mipmap_levels,
+                             PixelInternalFormat internal_format)
+{
+    Texture2DArray result({required_size, required_size, layers}, mipmap_levels, internal_format);
+    if (!texture)
+        return result;
+    auto old_size = texture.size();
+    auto copy_layers = std::min(old_size.z(), layers);
+    for (GLint level = 0; level < mipmap_levels; level++) {
+        auto copy_size = std::max(std::min(old_size.x(), required_size) >> level, 1);
+        result.copyFrom(texture, {}, {}, {copy_size, copy_size, copy_layers}, level, level);
+    }
+    return result;
+}
+
 } // namespace dang::gl::TextureAtlasUtils
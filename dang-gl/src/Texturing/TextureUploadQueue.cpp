@@ -0,0 +1,87 @@
+#include "dang-gl/Texturing/TextureUploadQueue.h"
+
+namespace dang::gl {
+
+namespace {
+
+/// @brief The alignment of each upload in the buffer, which is enough for any pixel type.
+constexpr std::size_t upload_alignment = 16;
+
+/// @brief Checks the segment size and count, before any memory is allocated.
+std::size_t checkRingSize(std::size_t segment_size, std::size_t segment_count)
+{
+    if (segment_size == 0)
+        throw std::invalid_argument("Texture upload segment size cannot be zero.");
+    if (segment_count == 0)
+        throw std::invalid_argument("Texture upload segment count cannot be zero.");
+    return segment_size * segment_count;
+}
+
+} // namespace
+
+TextureUploadQueue::TextureUploadQueue(std::size_t segment_size, std::size_t segment_count)
+    : segment_size_(segment_size)
+    , pbo_(checkRingSize(segment_size, segment_count))
+    , fences_(segment_count)
+{
+    pbo_.release();
+}
+
+TextureUploadQueue::~TextureUploadQueue() { deleteFences(); }
+
+TextureUploadQueue& TextureUploadQueue::operator=(TextureUploadQueue&& other) noexcept
+{
+    if (this == &other)
+        return *this;
+    deleteFences();
+    segment_size_ = other.segment_size_;
+    pbo_ = std::move(other.pbo_);
+    fences_ = std::exchange(other.fences_, {});
+    segment_ = other.segment_;
+    segment_offset_ = other.segment_offset_;
+    return *this;
+}
+
+std::optional<std::size_t> TextureUploadQueue::allocate(std::size_t size)
+{
+    if (size > segment_size_)
+        return std::nullopt;
+    auto offset = (segment_offset_ + upload_alignment - 1) / upload_alignment * upload_alignment;
+    if (offset + size > segment_size_) {
+        nextSegment();
+        offset = 0;
+    }
+    segment_offset_ = offset + size;
+    return segment_ * segment_size_ + offset;
+}
+
+void TextureUploadQueue::deleteFences()
+{
+    for (auto fence : fences_)
+        if (fence)
+            glDeleteSync(fence);
+}
+
+void TextureUploadQueue::nextSegment()
+{
+    fences_[segment_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    segment_ = (segment_ + 1) % fences_.size();
+    segment_offset_ = 0;
+
+    auto& fence = fences_[segment_];
+    if (!fence)
+        return;
+    // Only the first wait has to flush, so that the fence is guaranteed to be signaled eventually.
+    GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    constexpr GLuint64 timeout = 1'000'000'000;
+    while (true) {
+        auto result = glClientWaitSync(fence, flags, timeout);
+        if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED || result == GL_WAIT_FAILED)
+            break;
+        flags = 0;
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+} // namespace dang::gl
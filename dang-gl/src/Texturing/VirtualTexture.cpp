@@ -0,0 +1,121 @@
+#include "dang-gl/Texturing/VirtualTexture.h"
+
+#include <unordered_set>
+
+namespace dang::gl {
+
+VirtualTexture::VirtualTexture(svec2 page_count,
+                               GLsizei level_count,
+                               GLsizei page_size,
+                               std::size_t slot_count,
+                               PageLoader page_loader,
+                               PixelInternalFormat internal_format)
+    : page_size_(page_size)
+    , page_loader_(std::move(page_loader))
+    , residency_(slot_count)
+    , page_table_(page_count, level_count)
+    , pending_loads_(slot_count)
+{
+    if (page_size < 1)
+        throw std::invalid_argument("Virtual texture page size must be at least one.");
+
+    pages_.generate(svec3(page_size, page_size, static_cast<GLsizei>(slot_count)), 1, internal_format);
+    pages_.setMinFilter(TextureMinFilter::Linear);
+
+    page_table_texture_.generate(page_count, level_count, PixelInternalFormat::RGBA16UI);
+    page_table_texture_.setMinFilter(TextureMinFilter::NearestMipmapNearest);
+    page_table_texture_.setMagFilter(TextureMagFilter::Nearest);
+}
+
+std::size_t VirtualTexture::pendingCount() const
+{
+    return static_cast<std::size_t>(std::count_if(
+        pending_loads_.begin(), pending_loads_.end(), [](const auto& pending) { return pending.has_value(); }));
+}
+
+void VirtualTexture::update(const std::vector<VirtualTexturePage>& requested,
+                            std::size_t max_loads,
+                            TextureUploadQueue& upload_queue)
+{
+    for (auto& load : residency_.update(withAncestors(requested), max_loads)) {
+        // The slot is overwritten as soon as the new page is loaded, so the old page must no longer be referenced.
+        if (load.evicted)
+            page_table_.setMissing(*load.evicted);
+        auto& pending = pending_loads_[load.slot];
+        if (pending)
+            abandoned_loads_.push_back(std::move(pending->image));
+        pending = PendingLoad{load.page, page_loader_(load.page)};
+    }
+
+    finishLoads(upload_queue);
+
+    if (!page_table_.dirty())
+        return;
+    const auto& images = page_table_.images();
+    for (GLint level = 0; level < page_table_.levelCount(); level++)
+        upload_queue.upload(page_table_texture_, images[level], {}, level);
+}
+
+std::vector<VirtualTexturePage> VirtualTexture::decodeFeedback(const FeedbackImage& feedback) const
+{
+    std::vector<VirtualTexturePage> result;
+    std::unordered_set<VirtualTexturePage, VirtualTexturePageHash> pages;
+    for (const auto& pos : dmath::sbounds2(feedback.size())) {
+        const auto& pixel = feedback[pos];
+        if (pixel.w() == 0)
+            continue;
+        VirtualTexturePage page{svec2(pixel.x(), pixel.y()), pixel.z()};
+        if (page_table_.contains(page) && pages.insert(page).second)
+            result.push_back(page);
+    }
+    return result;
+}
+
+std::vector<VirtualTexturePage> VirtualTexture::withAncestors(const std::vector<VirtualTexturePage>& requested) const
+{
+    std::vector<VirtualTexturePage> result;
+    std::unordered_set<VirtualTexturePage, VirtualTexturePageHash> pages;
+    for (const auto& page : requested) {
+        if (!page_table_.contains(page))
+            continue;
+        // Once an ancestor is known, all further ancestors are known as well.
+        for (auto current = page; current.level < page_table_.levelCount(); current = current.parent()) {
+            if (!pages.insert(current).second)
+                break;
+            result.push_back(current);
+        }
+    }
+    return result;
+}
+
+void VirtualTexture::finishLoads(TextureUploadQueue& upload_queue)
+{
+    auto ready = [](const std::future<PageImage>& image) {
+        return image.wait_for(std::chrono::seconds::zero()) == std::future_status::ready;
+    };
+
+    abandoned_loads_.erase(std::remove_if(abandoned_loads_.begin(), abandoned_loads_.end(), ready),
+                           abandoned_loads_.end());
+
+    for (std::size_t slot = 0; slot < pending_loads_.size(); slot++) {
+        auto& pending = pending_loads_[slot];
+        if (!pending || !ready(pending->image))
+            continue;
+        // Taken out of the slot first, so that a failed load does not leave a consumed future behind.
+        auto load = std::move(*pending);
+        pending.reset();
+        try {
+            auto image = load.image.get();
+            if (image.size() != dmath::svec2(static_cast<std::size_t>(page_size_)))
+                throw std::invalid_argument("Virtual texture page has the wrong size.");
+            upload_queue.upload(pages_, image, ivec3(0, 0, static_cast<GLint>(slot)));
+        }
+        catch (...) {
+            residency_.evict(load.page);
+            throw;
+        }
+        page_table_.setResident(load.page, slot);
+    }
+}
+
+} // namespace dang::gl
@@ -0,0 +1,97 @@
+#include "dang-gl/Texturing/VirtualTexturePageTable.h"
+
+namespace dang::gl {
+
+VirtualTexturePageTable::VirtualTexturePageTable(svec2 page_count, GLsizei level_count)
+    : page_count_(page_count)
+{
+    auto is_power_of_two = [](GLsizei count) {
+        return count > 0 && dutils::popcount(static_cast<std::make_unsigned_t<GLsizei>>(count)) == 1;
+    };
+    if (!is_power_of_two(page_count.x()) || !is_power_of_two(page_count.y()))
+        throw std::invalid_argument("Virtual texture page count must be a power of two.");
+    auto max_level_count = dutils::ilog2(static_cast<std::size_t>(std::max(page_count.x(), page_count.y()))) + 1;
+    if (level_count < 1 || level_count > max_level_count)
+        throw std::invalid_argument("Virtual texture level count must be between one and a full mipmap chain.");
+    slots_.reserve(static_cast<std::size_t>(level_count));
+    images_.reserve(static_cast<std::size_t>(level_count));
+    for (GLint level = 0; level < level_count; level++) {
+        auto size = static_cast<dmath::svec2>(pageCount(level));
+        slots_.emplace_back(size.product(), no_slot);
+        images_.emplace_back(size);
+    }
+}
+
+svec2 VirtualTexturePageTable::pageCount(GLint level) const
+{
+    return {std::max(page_count_.x() >> level, 1), std::max(page_count_.y() >> level, 1)};
+}
+
+bool VirtualTexturePageTable::contains(const VirtualTexturePage& page) const
+{
+    if (page.level < 0 || page.level >= levelCount())
+        return false;
+    auto count = pageCount(page.level);
+    return page.position.greaterThanEqual(0).all() && page.position.lessThan(count).all();
+}
+
+void VirtualTexturePageTable::setResident(const VirtualTexturePage& page, std::size_t slot)
+{
+    assert(slot < no_slot);
+    slots_[page.level][pageIndex(page)] = static_cast<std::uint32_t>(slot);
+    dirty_ = true;
+}
+
+void VirtualTexturePageTable::setMissing(const VirtualTexturePage& page)
+{
+    slots_[page.level][pageIndex(page)] = no_slot;
+    dirty_ = true;
+}
+
+std::optional<VirtualTexturePageTable::Entry> VirtualTexturePageTable::resolve(const VirtualTexturePage& page) const
+{
+    if (!contains(page))
+        throw std::out_of_range("Page lies outside of the virtual texture.");
+    for (auto current = page; current.level < levelCount(); current = current.parent()) {
+        auto slot = slots_[current.level][pageIndex(current)];
+        if (slot != no_slot)
+            return Entry{slot, current.level};
+    }
+    return std::nullopt;
+}
+
+const std::vector<VirtualTexturePageTable::IndirectionImage>& VirtualTexturePageTable::images()
+{
+    if (!dirty_)
+        return images_;
+    for (auto level = levelCount() - 1; level >= 0; level--) {
+        auto& image = images_[level];
+        const auto& slots = slots_[level];
+        for (const auto& pos : dmath::sbounds2(image.size())) {
+            auto slot = slots[pos.y() * image.size().x() + pos.x()];
+            if (slot != no_slot) {
+                image[pos] = IndirectionImage::Pixel(static_cast<GLushort>(slot & 0xFFFF),
+                                                     static_cast<GLushort>(slot >> 16),
+                                                     static_cast<GLushort>(level),
+                                                     GLushort{1});
+            }
+            else if (level + 1 < levelCount())
+                image[pos] = images_[level + 1][dmath::svec2(pos.x() >> 1, pos.y() >> 1)];
+            else
+                image[pos] = IndirectionImage::Pixel();
+        }
+    }
+    dirty_ = false;
+    return images_;
+}
+
+std::size_t VirtualTexturePageTable::pageIndex(const VirtualTexturePage& page) const
+{
+    if (!contains(page))
+        throw std::out_of_range("Page lies outside of the virtual texture.");
+    auto count = pageCount(page.level);
+    return static_cast<std::size_t>(page.position.y()) * static_cast<std::size_t>(count.x()) +
+           static_cast<std::size_t>(page.position.x());
+}
+
+} // namespace dang::gl
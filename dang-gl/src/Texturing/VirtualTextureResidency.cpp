@@ -0,0 +1,98 @@
+#include "dang-gl/Texturing/VirtualTextureResidency.h"
+
+#include <unordered_set>
+
+namespace dang::gl {
+
+VirtualTextureResidency::VirtualTextureResidency(std::size_t slot_count)
+    : slot_count_(slot_count)
+{
+    if (slot_count == 0)
+        throw std::invalid_argument("Virtual texture slot count cannot be zero.");
+    clear();
+}
+
+std::optional<std::size_t> VirtualTextureResidency::slot(const VirtualTexturePage& page) const
+{
+    auto iter = pages_.find(page);
+    if (iter == pages_.end())
+        return std::nullopt;
+    return iter->second->slot;
+}
+
+std::vector<VirtualTextureResidency::Load> VirtualTextureResidency::update(
+    const std::vector<VirtualTexturePage>& requested, std::size_t max_loads)
+{
+    update_count_++;
+
+    std::vector<VirtualTexturePage> missing;
+    std::unordered_set<VirtualTexturePage, VirtualTexturePageHash> missing_set;
+    for (const auto& page : requested) {
+        auto iter = pages_.find(page);
+        if (iter == pages_.end()) {
+            if (missing_set.insert(page).second)
+                missing.push_back(page);
+            continue;
+        }
+        iter->second->last_update = update_count_;
+        entries_.splice(entries_.begin(), entries_, iter->second);
+    }
+
+    std::stable_sort(missing.begin(), missing.end(), [](const VirtualTexturePage& lhs, const VirtualTexturePage& rhs) {
+        return lhs.level > rhs.level;
+    });
+
+    std::vector<Load> result;
+    for (const auto& page : missing) {
+        if (result.size() >= max_loads)
+            break;
+        std::optional<VirtualTexturePage> evicted;
+        auto slot = acquireSlot(evicted);
+        if (!slot)
+            break;
+        entries_.push_front({page, *slot, update_count_});
+        pages_.emplace(page, entries_.begin());
+        result.push_back({page, *slot, evicted});
+    }
+    return result;
+}
+
+bool VirtualTextureResidency::evict(const VirtualTexturePage& page)
+{
+    auto iter = pages_.find(page);
+    if (iter == pages_.end())
+        return false;
+    free_slots_.push_back(iter->second->slot);
+    entries_.erase(iter->second);
+    pages_.erase(iter);
+    return true;
+}
+
+void VirtualTextureResidency::clear()
+{
+    entries_.clear();
+    pages_.clear();
+    free_slots_.resize(slot_count_);
+    // Hand out the lowest slots first.
+    for (std::size_t slot = 0; slot < slot_count_; slot++)
+        free_slots_[slot] = slot_count_ - slot - 1;
+}
+
+std::optional<std::size_t> VirtualTextureResidency::acquireSlot(std::optional<VirtualTexturePage>& evicted)
+{
+    if (!free_slots_.empty()) {
+        auto slot = free_slots_.back();
+        free_slots_.pop_back();
+        return slot;
+    }
+    auto& last = entries_.back();
+    if (last.last_update == update_count_)
+        return std::nullopt;
+    auto slot = last.slot;
+    evicted = last.page;
+    pages_.erase(last.page);
+    entries_.pop_back();
+    return slot;
+}
+
+} // namespace dang::gl
@@ -0,0 +1,32 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include "dang-gl/Image/BlockCompression.h"
+#include "dang-gl/Image/Image.h"
+
+#include "catch2/catch.hpp"
+
+namespace dgl = dang::gl;
+namespace dmath = dang::math;
+
+TEST_CASE("Block compression throughput for a 1024x1024 image.", "[image][block-compression][.benchmark]")
+{
+    constexpr dmath::svec2 size(1024, 1024);
+    dgl::Image2D image(size);
+    for (const auto& pos : dmath::sbounds2(size)) {
+        image[pos] = dgl::Image2D::Pixel(static_cast<GLubyte>(pos.x() * 7 + pos.y()),
+                                         static_cast<GLubyte>(pos.y() * 3),
+                                         static_cast<GLubyte>((pos.x() ^ pos.y()) & 0xFF),
+                                         static_cast<GLubyte>(255 - pos.x() / 4));
+    }
+
+    BENCHMARK("BC1 (single-threaded)") { return dgl::compressImage(image, dgl::BlockCompression::BC1, 1); };
+    BENCHMARK("BC1") { return dgl::compressImage(image, dgl::BlockCompression::BC1); };
+    BENCHMARK("BC3") { return dgl::compressImage(image, dgl::BlockCompression::BC3); };
+    BENCHMARK("BC4") { return dgl::compressImage(image, dgl::BlockCompression::BC4); };
+    BENCHMARK("BC5") { return dgl::compressImage(image, dgl::BlockCompression::BC5); };
+    BENCHMARK("BC7 (single-threaded)") { return dgl::compressImage(image, dgl::BlockCompression::BC7, 1); };
+    BENCHMARK("BC7") { return dgl::compressImage(image, dgl::BlockCompression::BC7); };
+
+    auto compressed = dgl::compressImage(image, dgl::BlockCompression::BC7);
+    BENCHMARK("BC7 decompression") { return dgl::decompressImage(compressed); };
+}
@@ -0,0 +1,78 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include "dang-gl/Image/Image.h"
+
+#include "catch2/catch.hpp"
+
+namespace dgl = dang::gl;
+namespace dmath = dang::math;
+
+TEST_CASE("Image operations compared to per-pixel loops.", "[image][.benchmark]")
+{
+    constexpr dmath::svec2 size(4096, 4096);
+    const dgl::Image2D::Pixel value(1, 2, 3, 4);
+    const dgl::Image2D image(size, value);
+    const dmath::sbounds2 bounds(dmath::svec2(16, 16), size - dmath::svec2(16, 16));
+    dgl::Image2D target(size);
+
+    BENCHMARK("fill (per-pixel)")
+    {
+        dgl::Image2D result(size);
+        for (const auto& pos : dmath::sbounds2(size))
+            result[pos] = value;
+        return result;
+    };
+    BENCHMARK("fill") { return dgl::Image2D(size, value); };
+    BENCHMARK("fill with zero") { return dgl::Image2D(size); };
+
+    BENCHMARK("sub-image (per-pixel)")
+    {
+        dgl::Image2D result(bounds.size());
+        for (const auto& pos : bounds)
+            result[pos - bounds.low] = image[pos];
+        return result;
+    };
+    BENCHMARK("sub-image") { return image[bounds]; };
+
+    BENCHMARK("setSubImage (per-pixel)")
+    {
+        for (const auto& pos : bounds)
+            target[pos] = image[pos];
+        return target.data();
+    };
+    BENCHMARK("setSubImage")
+    {
+        target.setSubImage({}, image, bounds);
+        return target.data();
+    };
+}
+
+TEST_CASE("Image subsection copies compared to views.", "[image][image-view][.benchmark]")
+{
+    constexpr dmath::svec2 size(64, 64);
+    const dgl::Image2D image(size, {1, 2, 3, 4});
+    const std::array borders{dmath::sbounds2(size),
+                             dmath::sbounds2(dmath::svec2(0, 0), dmath::svec2(1, 1)),
+                             dmath::sbounds2(dmath::svec2(63, 0), dmath::svec2(64, 1)),
+                             dmath::sbounds2(dmath::svec2(0, 63), dmath::svec2(1, 64)),
+                             dmath::sbounds2(dmath::svec2(63, 63), dmath::svec2(64, 64)),
+                             dmath::sbounds2(dmath::svec2(0, 0), dmath::svec2(1, 64)),
+                             dmath::sbounds2(dmath::svec2(63, 0), dmath::svec2(64, 64)),
+                             dmath::sbounds2(dmath::svec2(0, 0), dmath::svec2(64, 1)),
+                             dmath::sbounds2(dmath::svec2(0, 63), dmath::svec2(64, 64))};
+
+    BENCHMARK("tile borders (copies)")
+    {
+        std::size_t count = 0;
+        for (const auto& bounds : borders)
+            count += image[bounds].count();
+        return count;
+    };
+    BENCHMARK("tile borders (views)")
+    {
+        std::size_t count = 0;
+        for (const auto& bounds : borders)
+            count += image.view(bounds).count();
+        return count;
+    };
+}
@@ -0,0 +1,43 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include "dang-gl/Image/ImageLoader.h"
+
+#include "catch2/catch.hpp"
+
+namespace dgl = dang::gl;
+namespace fs = std::filesystem;
+
+TEST_CASE("ImageLoader throughput with different thread counts.", "[image][image-loader][.benchmark]")
+{
+    std::vector<fs::path> paths;
+    for (const auto& entry : fs::directory_iterator("PngSuite")) {
+        const auto& path = entry.path();
+        if (entry.is_regular_file() && path.extension() == ".png" && path.filename().string().find("x") != 0)
+            paths.push_back(path);
+    }
+    REQUIRE_FALSE(paths.empty());
+
+    // Repeat the corpus to get a decent amount of work.
+    std::vector<fs::path> batch;
+    for (int i = 0; i < 8; i++)
+        batch.insert(batch.end(), paths.begin(), paths.end());
+
+    BENCHMARK("synchronous")
+    {
+        std::size_t count = 0;
+        for (const auto& path : batch)
+            count += dgl::Image2D::loadFromPNG(path).count();
+        return count;
+    };
+
+    for (std::size_t thread_count : {1, 2, 4, 8}) {
+        dgl::ImageLoader loader(thread_count);
+        BENCHMARK(std::to_string(thread_count) + " threads")
+        {
+            std::size_t count = 0;
+            for (auto& future : loader.load(batch))
+                count += future.get().count();
+            return count;
+        };
+    }
+}
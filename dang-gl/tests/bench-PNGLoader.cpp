@@ -0,0 +1,50 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include "dang-gl/Image/Image.h"
+
+#include "catch2/catch.hpp"
+
+namespace dgl = dang::gl;
+namespace fs = std::filesystem;
+
+TEST_CASE("Loading the PngSuite through streams compared to memory and mapped files.", "[image][.benchmark]")
+{
+    std::vector<fs::path> paths;
+    for (const auto& entry : fs::directory_iterator("PngSuite")) {
+        const auto& path = entry.path();
+        if (entry.is_regular_file() && path.extension() == ".png" && path.filename().string().find("x") != 0)
+            paths.push_back(path);
+    }
+    REQUIRE_FALSE(paths.empty());
+
+    std::vector<std::string> files;
+    for (const auto& path : paths) {
+        std::stringstream stream;
+        stream << std::ifstream(path, std::ios::binary).rdbuf();
+        files.push_back(stream.str());
+    }
+
+    BENCHMARK("stream")
+    {
+        std::size_t count = 0;
+        for (const auto& path : paths) {
+            std::ifstream stream(path, std::ios::binary);
+            count += dgl::Image2D::loadFromPNG(stream).count();
+        }
+        return count;
+    };
+    BENCHMARK("memory")
+    {
+        std::size_t count = 0;
+        for (const auto& file : files)
+            count += dgl::Image2D::loadFromPNG(reinterpret_cast<const std::byte*>(file.data()), file.size()).count();
+        return count;
+    };
+    BENCHMARK("mapped file")
+    {
+        std::size_t count = 0;
+        for (const auto& path : paths)
+            count += dgl::Image2D::loadFromPNG(dgl::MappedFile(path)).count();
+        return count;
+    };
+}
@@ -0,0 +1,31 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include "dang-gl/Objects/Program.h"
+
+#include "catch2/catch.hpp"
+
+namespace dgl = dang::gl;
+
+TEST_CASE("Setting 1M uniforms by name compared to resolved handles.", "[program][.benchmark]")
+{
+    constexpr std::size_t count = 1'000'000;
+
+    // The uniforms of an empty program only update their cached value, which isolates the cost of the lookup.
+    dgl::Program program(dgl::empty_object);
+    for (const auto& name : {"projection_matrix", "model_transform", "view_transform", "color", "scale"})
+        program.uniform<dgl::vec4>(name);
+    auto color = program.resolve<dgl::vec4>("color");
+
+    BENCHMARK("by name")
+    {
+        for (std::size_t i = 0; i < count; i++)
+            program.uniform<dgl::vec4>("color") = dgl::vec4(static_cast<float>(i & 1));
+        return program.uniform<dgl::vec4>("color").get();
+    };
+    BENCHMARK("by handle")
+    {
+        for (std::size_t i = 0; i < count; i++)
+            program.uniform(color) = dgl::vec4(static_cast<float>(i & 1));
+        return program.uniform(color).get();
+    };
+}
@@ -0,0 +1,129 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include "dang-gl/Image/Image.h"
+#include "dang-gl/Texturing/TextureAtlasTiles.h"
+
+#include "catch2/catch.hpp"
+
+#include <cmath>
+#include <random>
+
+namespace dgl = dang::gl;
+namespace dmath = dang::math;
+
+using Tiles = dgl::TextureAtlasTiles<dgl::Image2D>;
+
+TEST_CASE("TextureAtlasTiles add and remove cycles.", "[texture-atlas][.benchmark]")
+{
+    constexpr std::size_t tile_count = 50'000;
+    constexpr std::size_t cycles = 100'000;
+
+    const dgl::Image2D image(dmath::svec2(4, 4));
+    std::mt19937 random;
+    std::uniform_int_distribution<std::size_t> random_index(0, tile_count - 1);
+
+    BENCHMARK_ADVANCED("100k add/remove cycles with 50k tiles")(Catch::Benchmark::Chronometer meter)
+    {
+        Tiles tiles({1024, 64});
+        std::vector<Tiles::TileHandle> handles;
+        handles.reserve(tile_count);
+        for (std::size_t i = 0; i < tile_count; i++)
+            handles.push_back(tiles.add(image));
+
+        meter.measure([&] {
+            for (std::size_t i = 0; i < cycles; i++) {
+                auto& handle = handles[random_index(random)];
+                tiles.remove(handle);
+                handle = tiles.add(image);
+            }
+            return tiles.exists(handles.front());
+        });
+    };
+}
+
+TEST_CASE("TextureAtlasTiles handle copies.", "[texture-atlas][.benchmark]")
+{
+    Tiles tiles({1024, 1});
+    auto handle = tiles.add(dgl::Image2D(dmath::svec2(4, 4)));
+    std::vector<Tiles::TileHandle> handles(10'000, handle);
+
+    BENCHMARK("copy and destroy a handle with 10k existing handles")
+    {
+        Tiles::TileHandle copy = handles[5'000];
+        return copy.layer();
+    };
+    BENCHMARK("copy 10k handles")
+    {
+        std::vector<Tiles::TileHandle> copies = handles;
+        return copies.size();
+    };
+}
+
+TEST_CASE("TextureAtlasTiles batch insertion compared to repeated add.", "[texture-atlas][.benchmark]")
+{
+    constexpr std::size_t tile_count = 20'000;
+
+    std::mt19937 random;
+    std::uniform_int_distribution<std::size_t> random_size(4, 32);
+    std::vector<dgl::Image2D> images;
+    for (std::size_t i = 0; i < tile_count; i++)
+        images.emplace_back(dmath::svec2(random_size(random), random_size(random)));
+
+    BENCHMARK("repeated add")
+    {
+        Tiles tiles({4096, 256});
+        for (std::size_t i = 0; i < tile_count; i++)
+            tiles.add(std::to_string(i), images[i]);
+        return tiles.exists("0");
+    };
+    BENCHMARK("addBatch")
+    {
+        Tiles tiles({4096, 256});
+        std::vector<Tiles::TileInfo> batch;
+        batch.reserve(tile_count);
+        for (std::size_t i = 0; i < tile_count; i++)
+            batch.push_back({std::to_string(i), images[i], std::nullopt});
+        tiles.addBatch(std::move(batch));
+        return tiles.exists("0");
+    };
+}
+
+TEST_CASE("TextureAtlasTiles grid packing compared to MaxRects packing.", "[texture-atlas][.benchmark]")
+{
+    constexpr std::size_t tile_count = 2'000;
+
+    // A mix of small icons, non-power-of-two sprites and a few larger backgrounds.
+    std::mt19937 random;
+    std::uniform_int_distribution<GLsizei> random_icon_size(8, 40);
+    std::uniform_int_distribution<GLsizei> random_sprite_size(24, 100);
+    std::uniform_int_distribution<GLsizei> random_background_size(150, 300);
+    std::uniform_int_distribution<int> random_kind(0, 19);
+    std::vector<dgl::Image2D> images;
+    for (std::size_t i = 0; i < tile_count; i++) {
+        auto kind = random_kind(random);
+        auto& random_size = kind == 0 ? random_background_size : kind < 8 ? random_sprite_size : random_icon_size;
+        images.emplace_back(dmath::svec2(random_size(random), random_size(random)));
+    }
+
+    auto pack = [&](dgl::TextureAtlasPacking packing) {
+        Tiles tiles({2048, 64}, packing);
+        std::vector<Tiles::TileInfo> batch;
+        batch.reserve(tile_count);
+        for (std::size_t i = 0; i < tile_count; i++)
+            batch.push_back({std::to_string(i), images[i], std::nullopt});
+        tiles.addBatch(std::move(batch));
+        return tiles;
+    };
+
+    for (auto [packing, name] : {std::pair{dgl::TextureAtlasPacking::Grid, "Grid"},
+                                 std::pair{dgl::TextureAtlasPacking::MaxRects, "MaxRects"}}) {
+        auto tiles = pack(packing);
+        auto occupancy = tiles.occupancy();
+        auto layer_size = std::sqrt(occupancy.texture_pixel_count / occupancy.layer_count);
+        WARN(name << ": " << occupancy.layer_count << " layers of " << layer_size << "x" << layer_size << ", "
+                  << occupancy.pixelRatio() * 100.0f << "% of pixels used");
+    }
+
+    BENCHMARK("Grid addBatch") { return pack(dgl::TextureAtlasPacking::Grid).occupancy().layer_count; };
+    BENCHMARK("MaxRects addBatch") { return pack(dgl::TextureAtlasPacking::MaxRects).occupancy().layer_count; };
+}
@@ -0,0 +1,181 @@
+#include "dang-gl/Image/BlockCompression.h"
+#include "dang-gl/Image/Image.h"
+
+#include "catch2/catch.hpp"
+
+namespace dgl = dang::gl;
+namespace dmath = dang::math;
+
+namespace {
+
+/// @brief Generates a smooth gradient with a bit of deterministic noise, which resembles typical texture content.
+dgl::Image2D gradientImage(dmath::svec2 size)
+{
+    dgl::Image2D result(size);
+    std::uint32_t seed = 12345;
+    auto noise = [&] {
+        seed = seed * 1664525 + 1013904223;
+        return static_cast<int>(seed >> 28) - 8;
+    };
+    for (const auto& pos : dmath::sbounds2(size)) {
+        auto channel = [&](std::size_t value) {
+            return static_cast<GLubyte>(std::clamp(static_cast<int>(value) + noise(), 0, 255));
+        };
+        result[pos] = dgl::Image2D::Pixel(channel(pos.x() * 255 / (size.x() - 1)),
+                                          channel(pos.y() * 255 / (size.y() - 1)),
+                                          channel((pos.x() + pos.y()) * 255 / (size.x() + size.y() - 2)),
+                                          channel(255 - pos.x() * 255 / (size.x() - 1)));
+    }
+    return result;
+}
+
+/// @brief Calculates the peak signal to noise ratio over the given number of channels.
+double psnr(const dgl::Image2D& expected, const dgl::Image2D& actual, std::size_t channels)
+{
+    double squared_error = 0.0;
+    for (const auto& pos : dmath::sbounds2(expected.size())) {
+        for (std::size_t i = 0; i < channels; i++) {
+            auto difference = static_cast<double>(expected[pos][i]) - static_cast<double>(actual[pos][i]);
+            squared_error += difference * difference;
+        }
+    }
+    auto mean_squared_error = squared_error / static_cast<double>(expected.size().product() * channels);
+    if (mean_squared_error == 0.0)
+        return std::numeric_limits<double>::infinity();
+    return 10.0 * std::log10(255.0 * 255.0 / mean_squared_error);
+}
+
+/// @brief Makes all pixels opaque for BC1, which would otherwise make pixels with an alpha below one half transparent.
+dgl::Image2D gradientImage(dmath::svec2 size, dgl::BlockCompression compression)
+{
+    auto result = gradientImage(size);
+    if (compression == dgl::BlockCompression::BC1) {
+        for (const auto& pos : dmath::sbounds2(size))
+            result[pos].w() = 255;
+    }
+    return result;
+}
+
+std::size_t channelCount(dgl::BlockCompression compression)
+{
+    switch (compression) {
+    case dgl::BlockCompression::BC4:
+        return 1;
+    case dgl::BlockCompression::BC5:
+        return 2;
+    case dgl::BlockCompression::BC1:
+        return 3;
+    default:
+        return 4;
+    }
+}
+
+} // namespace
+
+TEST_CASE("Compressed images consist of blocks of four by four pixels.", "[image][block-compression]")
+{
+    dgl::CompressedImage image({6, 5}, dgl::BlockCompression::BC1);
+    CHECK(image.blockCount() == dmath::svec2(2, 2));
+    CHECK(image.blockByteCount() == 8);
+    CHECK(image.byteCount() == 32);
+    CHECK(image.block({1, 1}) == image.data() + 24);
+    CHECK(image.view().byteCount() == 32);
+
+    dgl::CompressedImage bc7({8, 8}, dgl::BlockCompression::BC7);
+    CHECK(bc7.byteCount() == 64);
+
+    CHECK_FALSE(dgl::CompressedImage());
+    CHECK_FALSE(dgl::CompressedImage({0, 4}, dgl::BlockCompression::BC3));
+}
+
+TEST_CASE("Solid colors survive block compression.", "[image][block-compression]")
+{
+    auto compression = GENERATE(dgl::BlockCompression::BC1,
+                                dgl::BlockCompression::BC3,
+                                dgl::BlockCompression::BC4,
+                                dgl::BlockCompression::BC5,
+                                dgl::BlockCompression::BC7);
+    auto color = GENERATE(dgl::Image2D::Pixel(0, 0, 0, 255),
+                          dgl::Image2D::Pixel(255, 255, 255, 255),
+                          dgl::Image2D::Pixel(200, 100, 50, 255),
+                          dgl::Image2D::Pixel(17, 230, 128, 255));
+
+    dgl::Image2D image({8, 8}, color);
+    auto decompressed = dgl::decompressImage(dgl::compressImage(image, compression));
+    auto channels = channelCount(compression);
+    for (const auto& pos : dmath::sbounds2(image.size())) {
+        for (std::size_t i = 0; i < channels; i++) {
+            // 565 endpoints of BC1 and BC3 can only approximate the color.
+            CHECK(std::abs(static_cast<int>(decompressed[pos][i]) - static_cast<int>(color[i])) <= 4);
+        }
+    }
+}
+
+TEST_CASE("Block compression keeps a gradient with noise recognizable.", "[image][block-compression]")
+{
+    auto [compression, min_psnr] = GENERATE(std::pair{dgl::BlockCompression::BC1, 34.0},
+                                            std::pair{dgl::BlockCompression::BC3, 35.0},
+                                            std::pair{dgl::BlockCompression::BC4, 45.0},
+                                            std::pair{dgl::BlockCompression::BC5, 45.0},
+                                            std::pair{dgl::BlockCompression::BC7, 34.0});
+
+    auto image = gradientImage({64, 64}, compression);
+    auto decompressed = dgl::decompressImage(dgl::compressImage(image, compression));
+    CHECK(psnr(image, decompressed, channelCount(compression)) >= min_psnr);
+
+    // Channels, which are not stored, are zero with an alpha of one.
+    if (compression == dgl::BlockCompression::BC4 || compression == dgl::BlockCompression::BC5) {
+        CHECK(decompressed[dmath::svec2(5, 7)].z() == 0);
+        CHECK(decompressed[dmath::svec2(5, 7)].w() == 255);
+    }
+}
+
+TEST_CASE("BC1 keeps pixels with a low alpha transparent.", "[image][block-compression]")
+{
+    auto image = gradientImage({8, 8});
+    for (const auto& pos : dmath::sbounds2(image.size()))
+        image[pos].w() = (pos.x() + pos.y()) % 3 == 0 ? 0 : 255;
+
+    SECTION("Partially transparent blocks use three colors.")
+    {
+        auto decompressed = dgl::decompressImage(dgl::compressImage(image, dgl::BlockCompression::BC1));
+        for (const auto& pos : dmath::sbounds2(image.size()))
+            CHECK((decompressed[pos].w() == 0) == (image[pos].w() == 0));
+    }
+    SECTION("Fully transparent blocks are transparent black.")
+    {
+        image = dgl::Image2D(image.size(), dgl::Image2D::Pixel(10, 20, 30, 0));
+        auto decompressed = dgl::decompressImage(dgl::compressImage(image, dgl::BlockCompression::BC1));
+        for (const auto& pos : dmath::sbounds2(image.size()))
+            CHECK(decompressed[pos] == dgl::Image2D::Pixel());
+    }
+}
+
+TEST_CASE("Block compression handles partial blocks and any number of threads.", "[image][block-compression]")
+{
+    auto compression = GENERATE(dgl::BlockCompression::BC1, dgl::BlockCompression::BC5, dgl::BlockCompression::BC7);
+
+    auto image = gradientImage({37, 22}, compression);
+    auto single_threaded = dgl::compressImage(image, compression, 1);
+    auto multi_threaded = dgl::compressImage(image, compression, 4);
+    REQUIRE(single_threaded.byteCount() == multi_threaded.byteCount());
+    CHECK(std::memcmp(single_threaded.data(), multi_threaded.data(), single_threaded.byteCount()) == 0);
+
+    auto decompressed = dgl::decompressImage(single_threaded);
+    CHECK(decompressed.size() == image.size());
+    CHECK(psnr(image, decompressed, channelCount(compression)) >= 30.0);
+
+    // Views only compress their own pixels.
+    dmath::sbounds2 bounds(dmath::svec2(3, 2), dmath::svec2(9, 7));
+    auto view_compressed = dgl::compressImage(image.view(bounds), compression, 1);
+    CHECK(view_compressed.size() == dmath::svec2(6, 5));
+    CHECK(psnr(dgl::Image2D(image.view(bounds)), dgl::decompressImage(view_compressed), channelCount(compression)) >=
+          30.0);
+}
+
+TEST_CASE("Only BC7 blocks using mode 6 can be decoded.", "[image][block-compression]")
+{
+    dgl::CompressedImage image({4, 4}, dgl::BlockCompression::BC7);
+    image.data()[0] = std::byte{1};
+    CHECK_THROWS_AS(dgl::decompressImage(image), std::invalid_argument);
+}
@@ -0,0 +1,130 @@
+#include "dang-gl/Math/MathTypes.h"
+#include "dang-gl/Objects/BufferLayout.h"
+
+#include "catch2/catch.hpp"
+
+namespace dgl = dang::gl;
+
+namespace {
+
+struct Mixed {
+    dgl::vec3 position;
+    GLfloat radius;
+    dgl::vec2 offset;
+    std::array<GLfloat, 3> weights;
+    dgl::mat3 rotation;
+};
+
+struct Small {
+    dgl::mat2 matrix;
+    std::array<dgl::vec2, 2> points;
+    GLint index;
+};
+
+} // namespace
+
+template <>
+struct dgl::buffer_layout_members<Mixed>
+    : dgl::buffer_layout_member_list<&Mixed::position,
+                                     &Mixed::radius,
+                                     &Mixed::offset,
+                                     &Mixed::weights,
+                                     &Mixed::rotation> {};
+
+template <>
+struct dgl::buffer_layout_members<Small>
+    : dgl::buffer_layout_member_list<&Small::matrix, &Small::points, &Small::index> {};
+
+TEST_CASE("Buffer layouts follow the std140 rules.", "[buffer-layout]")
+{
+    using Layout = dgl::BufferStructLayout<Mixed, dgl::BufferLayout::Std140>;
+
+    STATIC_REQUIRE(Layout::member_count == 5);
+
+    constexpr auto& members = Layout::members;
+    STATIC_REQUIRE(members[0].type == dgl::DataType::Vec3);
+    STATIC_REQUIRE(members[0].offset == 0);
+    // A float can fill the gap after a vec3.
+    STATIC_REQUIRE(members[1].type == dgl::DataType::Float);
+    STATIC_REQUIRE(members[1].offset == 12);
+    STATIC_REQUIRE(members[2].offset == 16);
+    // Array elements are aligned and padded to a vec4.
+    STATIC_REQUIRE(members[3].offset == 32);
+    STATIC_REQUIRE(members[3].count == 3);
+    STATIC_REQUIRE(members[3].array_stride == 16);
+    STATIC_REQUIRE(members[3].size == 48);
+    // Columns of a mat3 are padded to a vec4.
+    STATIC_REQUIRE(members[4].type == dgl::DataType::Mat3);
+    STATIC_REQUIRE(members[4].offset == 80);
+    STATIC_REQUIRE(members[4].matrix_stride == 16);
+    STATIC_REQUIRE(Layout::size == 128);
+
+    using SmallLayout = dgl::BufferStructLayout<Small, dgl::BufferLayout::Std140>;
+    STATIC_REQUIRE(SmallLayout::members[0].matrix_stride == 16);
+    STATIC_REQUIRE(SmallLayout::members[1].offset == 32);
+    STATIC_REQUIRE(SmallLayout::members[1].array_stride == 16);
+    STATIC_REQUIRE(SmallLayout::members[2].type == dgl::DataType::Int);
+    STATIC_REQUIRE(SmallLayout::members[2].offset == 64);
+    // The size of the whole struct is rounded up to a multiple of a vec4.
+    STATIC_REQUIRE(SmallLayout::size == 80);
+}
+
+TEST_CASE("Buffer layouts follow the std430 rules.", "[buffer-layout]")
+{
+    using Layout = dgl::BufferStructLayout<Mixed, dgl::BufferLayout::Std430>;
+
+    constexpr auto& members = Layout::members;
+    STATIC_REQUIRE(members[1].offset == 12);
+    STATIC_REQUIRE(members[2].offset == 16);
+    // Arrays of scalars are tightly packed.
+    STATIC_REQUIRE(members[3].offset == 24);
+    STATIC_REQUIRE(members[3].array_stride == 4);
+    // Columns of a mat3 are still aligned like a vec4.
+    STATIC_REQUIRE(members[4].offset == 48);
+    STATIC_REQUIRE(members[4].matrix_stride == 16);
+    STATIC_REQUIRE(Layout::size == 96);
+
+    using SmallLayout = dgl::BufferStructLayout<Small, dgl::BufferLayout::Std430>;
+    STATIC_REQUIRE(SmallLayout::members[0].matrix_stride == 8);
+    STATIC_REQUIRE(SmallLayout::members[1].offset == 16);
+    STATIC_REQUIRE(SmallLayout::members[1].array_stride == 8);
+    STATIC_REQUIRE(SmallLayout::members[2].offset == 32);
+    STATIC_REQUIRE(SmallLayout::size == 40);
+}
+
+TEST_CASE("Buffer layouts write members to their offsets.", "[buffer-layout]")
+{
+    using Layout = dgl::BufferStructLayout<Mixed>;
+
+    Mixed value{};
+    value.position = {1.0f, 2.0f, 3.0f};
+    value.radius = 4.0f;
+    value.offset = {5.0f, 6.0f};
+    value.weights = {7.0f, 8.0f, 9.0f};
+    value.rotation = dgl::mat3({{10.0f, 11.0f, 12.0f}, {13.0f, 14.0f, 15.0f}, {16.0f, 17.0f, 18.0f}});
+
+    std::array<std::byte, Layout::size> data{};
+    Layout::write(value, data.data());
+
+    auto read = [&](std::size_t offset) {
+        GLfloat result;
+        std::memcpy(&result, &data[offset], sizeof(result));
+        return result;
+    };
+
+    CHECK(read(0) == 1.0f);
+    CHECK(read(8) == 3.0f);
+    CHECK(read(12) == 4.0f);
+    CHECK(read(20) == 6.0f);
+    CHECK(read(32) == 7.0f);
+    CHECK(read(36) == 0.0f);
+    CHECK(read(48) == 8.0f);
+    CHECK(read(64) == 9.0f);
+    CHECK(read(80) == 10.0f);
+    CHECK(read(88) == 12.0f);
+    CHECK(read(92) == 0.0f);
+    CHECK(read(96) == 13.0f);
+    CHECK(read(116) == 17.0f);
+    CHECK(read(120) == 18.0f);
+    CHECK(read(124) == 0.0f);
+}
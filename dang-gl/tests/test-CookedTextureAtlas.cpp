@@ -0,0 +1,181 @@
+#include "dang-gl/Image/Image.h"
+#include "dang-gl/Texturing/CookedTextureAtlas.h"
+
+#include "catch2/catch.hpp"
+
+namespace dgl = dang::gl;
+namespace dmath = dang::math;
+namespace fs = std::filesystem;
+
+namespace {
+
+dgl::Image2D filledImage(dmath::svec2 size, GLubyte value)
+{
+    return dgl::Image2D(size, dgl::Image2D::Pixel(value, value, value, 255));
+}
+
+} // namespace
+
+TEST_CASE("Cooked texture atlases store the layout and pixels of all layers.", "[texture-atlas][cooked-atlas]")
+{
+    auto packing = GENERATE(dgl::TextureAtlasPacking::Grid, dgl::TextureAtlasPacking::MaxRects);
+
+    dgl::CookingTextureAtlas<> cooking_atlas({64, 4}, packing, 2);
+    cooking_atlas.add("a", filledImage({16, 16}, 1), dgl::TextureAtlasTileBorderGeneration::None);
+    cooking_atlas.add("b", filledImage({32, 32}, 2), dgl::TextureAtlasTileBorderGeneration::All);
+    cooking_atlas.add("c", filledImage({8, 4}, 3), dgl::TextureAtlasTileBorderGeneration::Positive);
+    auto atlas = std::move(cooking_atlas).freeze();
+
+    // The cooking atlas composes the same layers, that would be uploaded to the texture.
+    const auto& levels = atlas.levels();
+    REQUIRE(levels.size() == 2);
+    REQUIRE(levels[0].size() == static_cast<std::size_t>(atlas.layerCount()));
+    auto a = atlas["a"];
+    CHECK(levels[0][a.layer()][static_cast<dmath::svec2>(a.pixelPos())] == dgl::Image2D::Pixel(1, 1, 1, 255));
+
+    auto path = fs::temp_directory_path() / "dang-gl-test-cooked-atlas.bin";
+    dgl::writeCookedTextureAtlas(path, atlas);
+
+    {
+        dgl::CookedTextureAtlasFile file(path);
+        const auto& info = file.info();
+        CHECK(info.pixel_format == GL_RGBA);
+        CHECK(info.pixel_type == GL_UNSIGNED_BYTE);
+        CHECK(info.row_alignment == 4);
+        CHECK(info.packing == packing);
+        CHECK(info.atlas_size == atlas.atlasSize());
+        CHECK(info.layer_count == atlas.layerCount());
+        CHECK(info.mipmap_levels == 2);
+        CHECK_FALSE(info.compression);
+        REQUIRE(info.tiles.size() == 3);
+
+        for (GLint mipmap_level = 0; mipmap_level < info.mipmap_levels; mipmap_level++) {
+            for (GLsizei layer = 0; layer < info.layer_count; layer++) {
+                const auto& expected = levels[mipmap_level][layer];
+                auto image = file.image(mipmap_level, layer);
+                REQUIRE(image.size == expected.byteCount());
+                CHECK(reinterpret_cast<std::uintptr_t>(image.data) % 16 == 0);
+                CHECK(std::memcmp(image.data, expected.data(), image.size) == 0);
+            }
+        }
+
+        // Restored tiles are placed exactly like the original ones.
+        auto tiles = dgl::TextureAtlasTiles<dgl::Image2D>::restore(
+            {64, 4}, info.packing, info.mipmap_levels, info.atlas_size, info.layer_count, info.tiles);
+        CHECK(tiles.atlasSize() == atlas.atlasSize());
+        CHECK(tiles.layerCount() == atlas.layerCount());
+        for (const auto& name : {"a", "b", "c"}) {
+            auto original = atlas[name];
+            auto restored = tiles[name];
+            REQUIRE(restored);
+            CHECK(restored.pixelPos() == original.pixelPos());
+            CHECK(restored.pixelSize() == original.pixelSize());
+            CHECK(restored.layer() == original.layer());
+            CHECK((restored.bounds() == original.bounds()));
+        }
+        CHECK_FALSE(tiles.exists("d"));
+    }
+
+    fs::remove(path);
+}
+
+TEST_CASE("Cooked texture atlases can store block compressed layers.",
+          "[texture-atlas][cooked-atlas][block-compression]")
+{
+    auto compression = GENERATE(dgl::BlockCompression::BC1, dgl::BlockCompression::BC7);
+
+    dgl::CookingTextureAtlas<> cooking_atlas({64, 4}, dgl::TextureAtlasPacking::Grid, 2);
+    cooking_atlas.add("a", filledImage({16, 16}, 1));
+    cooking_atlas.add("b", filledImage({32, 32}, 2));
+    auto atlas = std::move(cooking_atlas).freeze();
+
+    auto path = fs::temp_directory_path() / "dang-gl-test-compressed-cooked-atlas.bin";
+    dgl::writeCookedTextureAtlas(path, atlas, compression);
+
+    {
+        dgl::CookedTextureAtlasFile file(path);
+        const auto& info = file.info();
+        CHECK(info.compression == compression);
+        CHECK(info.tiles.size() == 2);
+
+        const auto& levels = atlas.levels();
+        for (GLint mipmap_level = 0; mipmap_level < info.mipmap_levels; mipmap_level++) {
+            for (GLsizei layer = 0; layer < info.layer_count; layer++) {
+                auto expected = dgl::compressImage(levels[mipmap_level][layer], compression);
+                auto image = file.image(mipmap_level, layer);
+                REQUIRE(image.size == expected.byteCount());
+                CHECK(std::memcmp(image.data, expected.data(), image.size) == 0);
+            }
+        }
+    }
+
+    fs::remove(path);
+
+    dgl::CookingTextureAtlas<dgl::PixelFormat::RED> red_cooking_atlas({64, 4});
+    red_cooking_atlas.add("a", dgl::Image<2, dgl::PixelFormat::RED>(dmath::svec2(16, 16)));
+    auto red_atlas = std::move(red_cooking_atlas).freeze();
+    std::ostringstream stream;
+    CHECK_THROWS_AS(dgl::writeCookedTextureAtlas(stream, red_atlas, compression), std::invalid_argument);
+}
+
+TEST_CASE("Invalid cooked texture atlases are rejected.", "[texture-atlas][cooked-atlas]")
+{
+    auto path = fs::temp_directory_path() / "dang-gl-test-invalid-cooked-atlas.bin";
+
+    SECTION("Missing files cannot be mapped.")
+    {
+        CHECK_THROWS_AS(dgl::CookedTextureAtlasFile(path), dgl::CookedTextureAtlasError);
+    }
+    SECTION("Other files are not cooked atlases.")
+    {
+        std::ofstream(path, std::ios::binary) << "not an atlas";
+        CHECK_THROWS_AS(dgl::CookedTextureAtlasFile(path), dgl::CookedTextureAtlasError);
+    }
+    SECTION("Truncated files are detected.")
+    {
+        dgl::CookingTextureAtlas<> cooking_atlas({64, 4});
+        cooking_atlas.add("a", filledImage({16, 16}, 1));
+        auto atlas = std::move(cooking_atlas).freeze();
+        std::ostringstream stream;
+        dgl::writeCookedTextureAtlas(stream, atlas);
+        auto data = stream.str();
+        std::ofstream(path, std::ios::binary).write(data.data(), static_cast<std::streamsize>(data.size() - 1));
+        CHECK_THROWS_AS(dgl::CookedTextureAtlasFile(path), dgl::CookedTextureAtlasError);
+    }
+    SECTION("Corrupt counts are detected before any memory is reserved for them.")
+    {
+        dgl::CookingTextureAtlas<> cooking_atlas({64, 4});
+        cooking_atlas.add("a", filledImage({16, 16}, 1));
+        auto atlas = std::move(cooking_atlas).freeze();
+        std::ostringstream stream;
+        dgl::writeCookedTextureAtlas(stream, atlas);
+        const auto data = stream.str();
+
+        // Layer count, mipmap levels and tile count follow the magic and nine other 32-bit values.
+        auto check_corrupt = [&](std::size_t offset, std::uint32_t value) {
+            auto corrupt = data;
+            std::memcpy(&corrupt[offset], &value, sizeof(value));
+            std::ofstream(path, std::ios::binary).write(corrupt.data(), static_cast<std::streamsize>(corrupt.size()));
+            CHECK_THROWS_AS(dgl::CookedTextureAtlasFile(path), dgl::CookedTextureAtlasError);
+        };
+        check_corrupt(36, std::numeric_limits<std::int32_t>::max());
+        check_corrupt(40, 1000);
+        check_corrupt(44, std::numeric_limits<std::uint32_t>::max());
+    }
+    SECTION("Duplicate tiles cannot be restored.")
+    {
+        std::vector<dgl::TextureAtlasTileLayout> layout = {{"a", {0, 0, 0}, {16, 16}}, {"a", {16, 0, 0}, {16, 16}}};
+        CHECK_THROWS_AS(dgl::TextureAtlasTiles<dgl::Image2D>::restore(
+                            {64, 4}, dgl::TextureAtlasPacking::Grid, 1, 32, 1, layout),
+                        std::invalid_argument);
+    }
+    SECTION("Tiles outside of the atlas cannot be restored.")
+    {
+        std::vector<dgl::TextureAtlasTileLayout> layout = {{"a", {24, 0, 0}, {16, 16}}};
+        CHECK_THROWS_AS(dgl::TextureAtlasTiles<dgl::Image2D>::restore(
+                            {64, 4}, dgl::TextureAtlasPacking::Grid, 1, 32, 1, layout),
+                        std::invalid_argument);
+    }
+
+    fs::remove(path);
+}
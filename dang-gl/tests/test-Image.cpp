@@ -0,0 +1,187 @@
+#include "dang-gl/Image/Image.h"
+
+#include "catch2/catch.hpp"
+
+namespace dgl = dang::gl;
+namespace dmath = dang::math;
+
+namespace {
+
+template <typename TImage>
+TImage makeGradient(const typename TImage::Size& size)
+{
+    TImage image(size);
+    for (const auto& pos : typename TImage::Bounds(size)) {
+        typename TImage::Pixel pixel;
+        for (std::size_t i = 0; i < pixel.size(); i++)
+            pixel[i] = static_cast<typename TImage::Pixel::value_type>(pos[i % TImage::dim] * 3 + i);
+        image[pos] = pixel;
+    }
+    return image;
+}
+
+} // namespace
+
+TEST_CASE("Images can be filled with a single value.", "[image]")
+{
+    SECTION("Using a value with the same bytes.")
+    {
+        dgl::Image2D image(dmath::svec2(7, 5), {0, 0, 0, 0});
+        for (const auto& pos : dmath::sbounds2(dmath::svec2(7, 5)))
+            CHECK(image[pos] == dgl::Image2D::Pixel(0, 0, 0, 0));
+    }
+    SECTION("Using a value with different bytes.")
+    {
+        dgl::Image2D image(dmath::svec2(7, 5), {1, 2, 3, 4});
+        for (const auto& pos : dmath::sbounds2(dmath::svec2(7, 5)))
+            CHECK(image[pos] == dgl::Image2D::Pixel(1, 2, 3, 4));
+    }
+    SECTION("Using a three-dimensional image with padded rows.")
+    {
+        using Image = dgl::Image<3, dgl::PixelFormat::RGB>;
+        Image image(dmath::svec3(3, 4, 2), {1, 2, 3});
+        CHECK(image.alignedByteWidth() == 12);
+        for (const auto& pos : dmath::sbounds3(dmath::svec3(3, 4, 2)))
+            CHECK(image[pos] == Image::Pixel(1, 2, 3));
+    }
+    SECTION("Using a value with the same bytes leaves the padding zeroed.")
+    {
+        using Image = dgl::Image<2, dgl::PixelFormat::RGB>;
+        Image image(dmath::svec2(1, 3), {255, 255, 255});
+        REQUIRE(image.alignedByteWidth() == 4);
+        auto data = static_cast<const std::byte*>(image.data());
+        for (std::size_t y = 0; y < 3; y++) {
+            CHECK(image[{0, y}] == Image::Pixel(255, 255, 255));
+            CHECK(data[y * 4 + 3] == std::byte());
+        }
+    }
+    SECTION("Using an empty image.")
+    {
+        dgl::Image2D image(dmath::svec2(0, 5), {1, 2, 3, 4});
+        CHECK_FALSE(image);
+    }
+}
+
+TEST_CASE("Images can be constructed from pixel iterators.", "[image]")
+{
+    std::vector<dgl::Image2D::Pixel> pixels;
+    for (std::uint8_t i = 0; i < 6; i++)
+        pixels.emplace_back(i, i, i, i);
+
+    dgl::Image2D image(dmath::svec2(3, 2), pixels.begin());
+
+    CHECK(image[{0, 0}] == pixels[0]);
+    CHECK(image[{2, 0}] == pixels[2]);
+    CHECK(image[{0, 1}] == pixels[3]);
+    CHECK(image[{2, 1}] == pixels[5]);
+}
+
+TEMPLATE_TEST_CASE("Images can be copied in parts.",
+                   "[image]",
+                   dgl::Image2D,
+                   dgl::Image3D,
+                   (dgl::Image<2, dgl::PixelFormat::RGB>),
+                   (dgl::Image<3, dgl::PixelFormat::RED>))
+{
+    using Size = typename TestType::Size;
+    using Bounds = typename TestType::Bounds;
+
+    Size size;
+    Bounds bounds;
+    for (std::size_t i = 0; i < TestType::dim; i++) {
+        size[i] = 9 - i;
+        bounds.low[i] = 1 + i;
+        bounds.high[i] = 6;
+    }
+
+    const auto image = makeGradient<TestType>(size);
+
+    SECTION("Copying the whole image.")
+    {
+        TestType copy;
+        copy = image;
+        for (const auto& pos : Bounds(size))
+            CHECK(copy[pos] == image[pos]);
+    }
+    SECTION("Creating a new image from a subsection.")
+    {
+        auto sub_image = image[bounds];
+        REQUIRE(sub_image.size() == bounds.size());
+        for (const auto& pos : bounds)
+            CHECK(sub_image[pos - bounds.low] == image[pos]);
+    }
+    SECTION("Setting a subsection of an image.")
+    {
+        TestType target(size);
+        Size offset(1);
+        offset[0] = 2;
+        target.setSubImage(offset, image, bounds);
+        for (const auto& pos : Bounds(size)) {
+            if (pos.greaterThanEqual(bounds.low + offset).all() && pos.lessThan(bounds.high + offset).all())
+                CHECK(target[pos] == image[pos - offset]);
+            else
+                CHECK(target[pos] == typename TestType::Pixel());
+        }
+    }
+    SECTION("Moving an overlapping subsection within the same image.")
+    {
+        // Moving the subsection diagonally overlaps different rows, while only moving it along x overlaps each row.
+        Size row_offset;
+        row_offset[0] = 2;
+        for (const auto& offset : {Size(1), row_offset}) {
+            auto target = image;
+            target.setSubImage(offset, target, bounds);
+            for (const auto& pos : Bounds(size)) {
+                if (pos.greaterThanEqual(bounds.low + offset).all() && pos.lessThan(bounds.high + offset).all())
+                    CHECK(target[pos] == image[pos - offset]);
+                else
+                    CHECK(target[pos] == image[pos]);
+            }
+        }
+    }
+}
+
+TEST_CASE("Copies of images without pixels stay without pixels.", "[image]")
+{
+    auto placeholder = dgl::Image2D::placeholder(dmath::svec2(4, 4));
+    dgl::Image2D copy(placeholder);
+    CHECK(copy.size() == dmath::svec2(4, 4));
+    CHECK_FALSE(copy);
+
+    copy = dgl::Image2D(dmath::svec2(2, 2), {1, 2, 3, 4});
+    copy.free();
+    dgl::Image2D assigned(dmath::svec2(3, 3), {1, 2, 3, 4});
+    assigned = copy;
+    CHECK(assigned.size() == dmath::svec2(2, 2));
+    CHECK_FALSE(assigned);
+}
+
+TEST_CASE("Images can be downsampled to the next mipmap level.", "[image]")
+{
+    using Image = dgl::Image<2, dgl::PixelFormat::RED>;
+    std::vector<Image::Pixel> pixels;
+    for (std::uint8_t value : {0, 4, 8, 8, 12, 16})
+        pixels.emplace_back(value);
+    const Image image(dmath::svec2(3, 2), pixels.begin());
+
+    SECTION("Odd sizes are clamped to the edge.")
+    {
+        auto mipmap = image.downsample(false);
+        REQUIRE(mipmap.size() == dmath::svec2(2, 1));
+        CHECK(mipmap[{0, 0}] == Image::Pixel(6));
+        CHECK(mipmap[{1, 0}] == Image::Pixel(12));
+    }
+    SECTION("Odd sizes wrap around to the opposite side.")
+    {
+        auto mipmap = image.downsample(true);
+        REQUIRE(mipmap.size() == dmath::svec2(2, 1));
+        CHECK(mipmap[{0, 0}] == Image::Pixel(6));
+        CHECK(mipmap[{1, 0}] == Image::Pixel(8));
+    }
+    SECTION("A single pixel stays a single pixel.")
+    {
+        auto mipmap = image.downsample(false).downsample(false).downsample(false);
+        REQUIRE(mipmap.size() == dmath::svec2(1, 1));
+        CHECK(mipmap[{0, 0}] == Image::Pixel(9));
+    }
+}
@@ -0,0 +1,45 @@
+#include "dang-gl/Image/ImageLoader.h"
+
+#include "catch2/catch.hpp"
+
+namespace dgl = dang::gl;
+namespace fs = std::filesystem;
+
+TEST_CASE("ImageLoader decodes images on worker threads.", "[image][image-loader]")
+{
+    std::vector<fs::path> paths;
+    for (const auto& entry : fs::directory_iterator("PngSuite")) {
+        const auto& path = entry.path();
+        if (entry.is_regular_file() && path.extension() == ".png" && path.filename().string().find("x") != 0)
+            paths.push_back(path);
+    }
+    REQUIRE_FALSE(paths.empty());
+
+    auto thread_count = GENERATE(as<std::size_t>{}, 1, 3);
+    dgl::ImageLoader loader(thread_count);
+    CHECK(loader.threadCount() == thread_count);
+
+    SECTION("Loading a list of paths.")
+    {
+        auto futures = loader.load(paths);
+        REQUIRE(futures.size() == paths.size());
+        for (std::size_t i = 0; i < paths.size(); i++) {
+            INFO("Loading " << paths[i].filename().string())
+            auto image = futures[i].get();
+            auto expected = dgl::Image2D::loadFromPNG(paths[i]);
+            REQUIRE(image.size() == expected.size());
+            CHECK(std::memcmp(image.data(), expected.data(), image.byteCount()) == 0);
+        }
+    }
+    SECTION("Loading mapped files.")
+    {
+        auto future = loader.load(dgl::MappedFile(paths.front()));
+        auto image = future.get();
+        CHECK(image.size() == dgl::Image2D::loadFromPNG(paths.front()).size());
+    }
+    SECTION("Errors are reported through the future.")
+    {
+        auto future = loader.load(fs::path("PngSuite") / "does-not-exist.png");
+        CHECK_THROWS_AS(future.get(), dgl::PNGError);
+    }
+}
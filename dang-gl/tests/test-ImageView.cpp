@@ -0,0 +1,84 @@
+#include "dang-gl/Image/Image.h"
+#include "dang-gl/Image/ImageView.h"
+
+#include "catch2/catch.hpp"
+
+namespace dgl = dang::gl;
+namespace dmath = dang::math;
+
+TEMPLATE_TEST_CASE("Image views reference subsections without copying.",
+                   "[image][image-view]",
+                   dgl::Image2D,
+                   dgl::Image3D,
+                   (dgl::Image<2, dgl::PixelFormat::RGB>),
+                   (dgl::Image<3, dgl::PixelFormat::RED, dgl::PixelType::UNSIGNED_BYTE, 8>))
+{
+    using Size = typename TestType::Size;
+    using Bounds = typename TestType::Bounds;
+    using Pixel = typename TestType::Pixel;
+
+    Size size;
+    Bounds bounds;
+    for (std::size_t i = 0; i < TestType::dim; i++) {
+        size[i] = 9 - i;
+        bounds.low[i] = 1 + i;
+        bounds.high[i] = 6;
+    }
+
+    TestType image(size);
+    for (const auto& pos : Bounds(size)) {
+        Pixel pixel;
+        for (std::size_t i = 0; i < pixel.size(); i++)
+            pixel[i] = static_cast<typename Pixel::value_type>(pos[i % TestType::dim] * 5 + i);
+        image[pos] = pixel;
+    }
+
+    SECTION("Viewing the whole image.")
+    {
+        auto view = image.view();
+        CHECK(view);
+        CHECK(view.data() == image.data());
+        CHECK(view.size() == size);
+        CHECK(view.rowStride() == image.alignedByteWidth());
+        for (const auto& pos : Bounds(size))
+            CHECK(&view[pos] == &image[pos]);
+    }
+    SECTION("Viewing a subsection.")
+    {
+        auto view = image.view(bounds);
+        CHECK(view.data() == image.data());
+        CHECK(view.imageSize() == size);
+        CHECK(view.bounds() == bounds);
+        REQUIRE(view.size() == bounds.size());
+        for (const auto& pos : bounds)
+            CHECK(&view[pos - bounds.low] == &image[pos]);
+    }
+    SECTION("Viewing a subsection of a view.")
+    {
+        auto view = image.view(bounds);
+        Bounds sub_bounds(Size(1), bounds.size() - Size(1));
+        auto sub_view = view[sub_bounds];
+        CHECK(sub_view.bounds().low == bounds.low + sub_bounds.low);
+        REQUIRE(sub_view.size() == sub_bounds.size());
+        for (const auto& pos : sub_bounds)
+            CHECK(sub_view[pos - sub_bounds.low] == view[pos]);
+    }
+    SECTION("Copying a view into a new image.")
+    {
+        TestType copy(image.view(bounds));
+        REQUIRE(copy.size() == bounds.size());
+        for (const auto& pos : bounds)
+            CHECK(copy[pos - bounds.low] == image[pos]);
+    }
+}
+
+TEST_CASE("Image views can be empty.", "[image][image-view]")
+{
+    dgl::ImageView2D view;
+    CHECK_FALSE(view);
+    CHECK(view.count() == 0);
+
+    dgl::Image2D image(dmath::svec2(4, 4));
+    image.free();
+    CHECK_FALSE(image.view());
+}
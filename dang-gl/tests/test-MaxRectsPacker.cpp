@@ -0,0 +1,82 @@
+#include "dang-gl/Texturing/MaxRectsPacker.h"
+
+#include "catch2/catch.hpp"
+
+#include <random>
+
+namespace dgl = dang::gl;
+
+namespace {
+
+bool overlaps(const dgl::ibounds2& lhs, const dgl::ibounds2& rhs)
+{
+    return lhs.low.lessThan(rhs.high).all() && rhs.low.lessThan(lhs.high).all();
+}
+
+} // namespace
+
+TEST_CASE("MaxRectsPacker fills an area without overlaps.", "[texture-atlas][max-rects]")
+{
+    dgl::MaxRectsPacker packer(dgl::svec2(64, 64));
+
+    SECTION("Equally sized rectangles fill the area completely.")
+    {
+        std::vector<dgl::ibounds2> rects;
+        for (int i = 0; i < 16; i++) {
+            auto position = packer.insert({16, 16});
+            REQUIRE(position);
+            rects.emplace_back(*position, *position + 16);
+        }
+        CHECK_FALSE(packer.insert({1, 1}));
+
+        for (std::size_t i = 0; i < rects.size(); i++) {
+            CHECK(rects[i].low.greaterThanEqual(0).all());
+            CHECK(rects[i].high.lessThanEqual(64).all());
+            for (std::size_t j = i + 1; j < rects.size(); j++)
+                CHECK_FALSE(overlaps(rects[i], rects[j]));
+        }
+    }
+    SECTION("The used size grows as a square.")
+    {
+        for (int i = 0; i < 4; i++)
+            REQUIRE(packer.insert({16, 16}));
+        CHECK(packer.usedSize() == dgl::svec2(32, 32));
+    }
+    SECTION("Removed rectangles can be reused.")
+    {
+        auto first = packer.insert({64, 32});
+        auto second = packer.insert({64, 32});
+        REQUIRE(first);
+        REQUIRE(second);
+        CHECK_FALSE(packer.insert({64, 32}));
+
+        packer.remove({*first, *first + dgl::ivec2(64, 32)});
+        packer.remove({*second, *second + dgl::ivec2(64, 32)});
+        CHECK(packer.freeRectCount() == 1);
+        CHECK(packer.insert({64, 64}) == dgl::svec2());
+    }
+}
+
+TEST_CASE("MaxRectsPacker handles random rectangles.", "[texture-atlas][max-rects]")
+{
+    dgl::MaxRectsPacker packer(dgl::svec2(512, 512));
+    std::mt19937 random;
+    std::uniform_int_distribution<GLsizei> random_size(1, 48);
+
+    std::vector<dgl::ibounds2> rects;
+    for (int i = 0; i < 1000; i++) {
+        dgl::svec2 size(random_size(random), random_size(random));
+        if (auto position = packer.insert(size))
+            rects.emplace_back(*position, *position + size);
+        if (i % 3 == 0 && !rects.empty()) {
+            packer.remove(rects.front());
+            rects.erase(rects.begin());
+        }
+    }
+
+    for (std::size_t i = 0; i < rects.size(); i++) {
+        REQUIRE(rects[i].high.lessThanEqual(512).all());
+        for (std::size_t j = i + 1; j < rects.size(); j++)
+            REQUIRE_FALSE(overlaps(rects[i], rects[j]));
+    }
+}
@@ -1,3 +1,4 @@
+#include "dang-gl/General/MappedFile.h"
 #include "dang-gl/Image/PNGLoader.h"
 
 #include "catch2/catch.hpp"
@@ -69,3 +70,52 @@ TEMPLATE_TEST_CASE_SIG("PNGLoader can read .png images in any format.",
     loadImages<format, 4>();
     loadImages<format, 8>();
 }
+
+TEST_CASE("PNGLoader gives the same result for streams, memory and mapped files.", "[image]")
+{
+    for (const auto& entry : fs::directory_iterator("PngSuite")) {
+        const auto& path = entry.path();
+        if (!entry.is_regular_file() || path.extension() != ".png")
+            continue;
+
+        const auto& filename = path.filename().string();
+        if (filename.find("x") == 0)
+            continue;
+
+        INFO("Loading " << filename)
+
+        std::ifstream file_stream(path, std::ios::binary);
+        auto from_file_stream = dgl::PNGLoader(file_stream).read();
+
+        std::stringstream string_stream;
+        string_stream << std::ifstream(path, std::ios::binary).rdbuf();
+        auto contents = string_stream.str();
+        dgl::PNGLoader string_stream_loader(string_stream);
+        auto from_string_stream = string_stream_loader.read();
+
+        dgl::MappedFile mapped_file(path);
+        REQUIRE(mapped_file);
+        REQUIRE(mapped_file.size() == contents.size());
+        dgl::PNGLoader memory_loader(mapped_file.data(), mapped_file.size());
+        auto from_memory = memory_loader.read();
+
+        auto byte_count = memory_loader.count() * sizeof(dgl::Pixel<dgl::PixelFormat::RGBA>);
+        CHECK(std::memcmp(from_file_stream.get(), from_string_stream.get(), byte_count) == 0);
+        CHECK(std::memcmp(from_file_stream.get(), from_memory.get(), byte_count) == 0);
+    }
+}
+
+TEST_CASE("PNGLoader fails on truncated memory.", "[image]")
+{
+    dgl::MappedFile mapped_file(fs::path("PngSuite") / "basn6a08.png");
+    REQUIRE(mapped_file);
+    CHECK_THROWS_AS(dgl::PNGLoader(mapped_file.data(), mapped_file.size() / 2).read(), dgl::PNGError);
+}
+
+TEST_CASE("MappedFile reports files, that cannot be mapped.", "[image]")
+{
+    dgl::MappedFile mapped_file(fs::path("PngSuite") / "does-not-exist.png");
+    CHECK_FALSE(mapped_file);
+    CHECK(mapped_file.data() == nullptr);
+    CHECK(mapped_file.size() == 0);
+}
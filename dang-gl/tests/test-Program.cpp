@@ -0,0 +1,53 @@
+#include "dang-gl/Objects/Program.h"
+
+#include "catch2/catch.hpp"
+
+namespace dgl = dang::gl;
+
+TEST_CASE("Uniform handles are resolved once and access the same uniform.", "[program]")
+{
+    // Uniforms of an empty program do not exist in any shader, but still cache their values.
+    dgl::Program program(dgl::empty_object);
+
+    auto color = program.resolve<dgl::vec4>("color");
+    auto scale = program.resolve<GLfloat>("scale");
+    REQUIRE(color);
+    REQUIRE(scale);
+    CHECK_FALSE(dgl::UniformHandle<GLfloat>());
+    CHECK(scale.index() != color.index());
+    CHECK(program.resolve<dgl::vec4>("color").index() == color.index());
+
+    auto& uniform = program.uniform(color);
+    CHECK(&uniform == &program.uniform<dgl::vec4>("color"));
+    CHECK_FALSE(uniform.exists());
+    CHECK(uniform.name() == "color");
+
+    program.uniform(color) = dgl::vec4(1.0f, 2.0f, 3.0f, 4.0f);
+    CHECK(program.uniform<dgl::vec4>("color").get() == dgl::vec4(1.0f, 2.0f, 3.0f, 4.0f));
+
+    SECTION("Handles stay valid when the program is moved.")
+    {
+        auto moved = std::move(program);
+        CHECK(moved.uniform(color).get() == dgl::vec4(1.0f, 2.0f, 3.0f, 4.0f));
+        CHECK(&moved.uniform(scale) == &moved.uniform<GLfloat>("scale"));
+    }
+    SECTION("Resolving a uniform with a different type or count fails.")
+    {
+        CHECK_THROWS_AS(program.resolve<GLint>("color"), dgl::ShaderUniformError);
+        CHECK_THROWS_AS(program.resolve<dgl::vec4>("color", 2), dgl::ShaderUniformError);
+    }
+}
+
+TEST_CASE("Uniform arrays cache each element separately.", "[program]")
+{
+    dgl::Program program(dgl::empty_object);
+    auto lights = program.resolve<dgl::vec3>("lights", 3);
+
+    auto& uniform = program.uniform(lights);
+    CHECK(uniform.count() == 3);
+    uniform.set(dgl::vec3(1.0f), 2);
+    uniform.set(dgl::vec3(2.0f), 1);
+    CHECK(uniform.get(0) == dgl::vec3());
+    CHECK(uniform.get(1) == dgl::vec3(2.0f));
+    CHECK(uniform.get(2) == dgl::vec3(1.0f));
+}
@@ -0,0 +1,264 @@
+#include "dang-gl/Objects/Program.h"
+#include "dang-gl/Objects/VAO.h"
+#include "dang-gl/Objects/VBO.h"
+#include "dang-gl/Rendering/RenderQueue.h"
+#include "dang-gl/Rendering/Renderable.h"
+
+#include "catch2/catch.hpp"
+
+#include <random>
+
+namespace dgl = dang::gl;
+
+namespace {
+
+class TestRenderable : public dgl::Renderable {
+public:
+    TestRenderable(dgl::Program& program,
+                   dgl::RenderPass pass = dgl::RenderPass::Opaque,
+                   const void* texture_set = nullptr,
+                   const dgl::VAOBase* vertex_array = nullptr,
+                   dgl::VBO<dgl::mat2x4>* instance_transforms = nullptr)
+        : program_(&program)
+        , pass_(pass)
+        , texture_set_(texture_set)
+        , vertex_array_(vertex_array)
+        , instance_transforms_(instance_transforms)
+    {}
+
+    dgl::Program& program() const override { return *program_; }
+    void draw() const override {}
+    dgl::RenderPass renderPass() const override { return pass_; }
+    const dgl::VAOBase* vertexArray() const override { return vertex_array_; }
+    const void* textureSet() const override { return texture_set_; }
+    dgl::VBO<dgl::mat2x4>* instanceTransforms() const override { return instance_transforms_; }
+
+private:
+    dgl::Program* program_;
+    dgl::RenderPass pass_;
+    const void* texture_set_;
+    const dgl::VAOBase* vertex_array_;
+    dgl::VBO<dgl::mat2x4>* instance_transforms_;
+};
+
+std::vector<const dgl::Renderable*> sortedRenderables(const dgl::RenderQueue& queue)
+{
+    std::vector<const dgl::Renderable*> result;
+    for (const auto& item : queue.items())
+        result.push_back(item.renderable);
+    return result;
+}
+
+std::vector<std::size_t> batchSizes(const dgl::RenderQueue& queue)
+{
+    std::vector<dgl::RenderQueueBatch> batches;
+    dgl::RenderQueue::makeBatches(queue.items(), batches);
+    std::vector<std::size_t> result;
+    std::size_t next = 0;
+    for (const auto& batch : batches) {
+        // Batches cover all items in order without any gaps.
+        CHECK(batch.first == next);
+        next = batch.first + batch.count;
+        result.push_back(batch.count);
+    }
+    CHECK(next == queue.items().size());
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("Render queues sort opaque objects by state and then front to back.", "[render-queue]")
+{
+    dgl::Program program_a(dgl::empty_object);
+    dgl::Program program_b(dgl::empty_object);
+    dgl::VAO<dgl::vec3> vao_a(dgl::empty_object);
+    dgl::VAO<dgl::vec3> vao_b(dgl::empty_object);
+    int textures_a = 0;
+    int textures_b = 0;
+
+    TestRenderable a_near(program_a, dgl::RenderPass::Opaque, &textures_a, &vao_a);
+    TestRenderable a_far(program_a, dgl::RenderPass::Opaque, &textures_a, &vao_a);
+    TestRenderable a_other_vao(program_a, dgl::RenderPass::Opaque, &textures_a, &vao_b);
+    TestRenderable a_other_textures(program_a, dgl::RenderPass::Opaque, &textures_b, &vao_a);
+    TestRenderable b(program_b, dgl::RenderPass::Opaque, &textures_a, &vao_a);
+
+    dgl::RenderQueue queue;
+    queue.push(a_far, 10.0f);
+    queue.push(b, 1.0f);
+    queue.push(a_other_textures, 1.0f);
+    queue.push(a_other_vao, 1.0f);
+    queue.push(a_near, 2.0f);
+    queue.sort();
+
+    // States are numbered in the order they are first pushed.
+    std::vector<const dgl::Renderable*> expected{&a_near, &a_far, &a_other_vao, &a_other_textures, &b};
+    CHECK(sortedRenderables(queue) == expected);
+
+    SECTION("Clearing the queue also resets the numbering of states.")
+    {
+        queue.clear();
+        CHECK(queue.items().empty());
+        queue.push(b, 1.0f);
+        queue.push(a_near, 1.0f);
+        queue.sort();
+        CHECK(sortedRenderables(queue) == std::vector<const dgl::Renderable*>{&b, &a_near});
+    }
+}
+
+TEST_CASE("Render queues draw transparent objects last and back to front.", "[render-queue]")
+{
+    dgl::Program program_a(dgl::empty_object);
+    dgl::Program program_b(dgl::empty_object);
+
+    TestRenderable opaque(program_b);
+    TestRenderable transparent_near(program_a, dgl::RenderPass::Transparent);
+    TestRenderable transparent_middle(program_b, dgl::RenderPass::Transparent);
+    TestRenderable transparent_far(program_a, dgl::RenderPass::Transparent);
+
+    dgl::RenderQueue queue;
+    queue.push(transparent_near, 1.0f);
+    queue.push(transparent_far, 100.0f);
+    queue.push(opaque, 50.0f);
+    queue.push(transparent_middle, 10.0f);
+    queue.sort();
+
+    std::vector<const dgl::Renderable*> expected{&opaque, &transparent_far, &transparent_middle, &transparent_near};
+    CHECK(sortedRenderables(queue) == expected);
+}
+
+TEST_CASE("Render queue depth quantization preserves the order of depths.", "[render-queue]")
+{
+    CHECK(dgl::RenderQueue::quantizeDepth(-1.0f) == 0);
+    CHECK(dgl::RenderQueue::quantizeDepth(0.0f) == 0);
+    CHECK(dgl::RenderQueue::quantizeDepth(std::numeric_limits<float>::quiet_NaN()) == 0);
+    CHECK(dgl::RenderQueue::quantizeDepth(std::numeric_limits<float>::infinity()) <
+          std::uint64_t{1} << dgl::RenderQueue::depth_bits);
+
+    float previous_depth = 0.001f;
+    for (float depth = 0.002f; depth < 10000.0f; depth *= 1.01f) {
+        CHECK(dgl::RenderQueue::quantizeDepth(previous_depth) < dgl::RenderQueue::quantizeDepth(depth));
+        previous_depth = depth;
+    }
+}
+
+TEST_CASE("Render queues sort arbitrary keys.", "[render-queue]")
+{
+    std::mt19937 random(42);
+    std::uniform_int_distribution<std::size_t> program_dist(0, 3);
+    std::uniform_int_distribution<int> pass_dist(0, 1);
+    std::uniform_real_distribution<float> depth_dist(0.0f, 1000.0f);
+
+    std::vector<dgl::Program> programs;
+    for (std::size_t i = 0; i < 4; i++)
+        programs.emplace_back(dgl::empty_object);
+    std::array<int, 8> texture_sets{};
+    std::uniform_int_distribution<std::size_t> texture_dist(0, texture_sets.size() - 1);
+
+    std::vector<TestRenderable> renderables;
+    for (std::size_t i = 0; i < 1000; i++)
+        renderables.emplace_back(programs[program_dist(random)],
+                                 static_cast<dgl::RenderPass>(pass_dist(random)),
+                                 &texture_sets[texture_dist(random)]);
+
+    dgl::RenderQueue queue;
+    for (const auto& renderable : renderables)
+        queue.push(renderable, depth_dist(random));
+
+    auto keys = queue.items();
+    queue.sort();
+
+    REQUIRE(queue.items().size() == keys.size());
+    auto by_key = [](const auto& lhs, const auto& rhs) { return lhs.key < rhs.key; };
+    CHECK(std::is_sorted(queue.items().begin(), queue.items().end(), by_key));
+
+    // The radix sort is stable, just like a merge sort.
+    std::stable_sort(keys.begin(), keys.end(), by_key);
+    for (std::size_t i = 0; i < keys.size(); i++)
+        CHECK(queue.items()[i].renderable == keys[i].renderable);
+}
+
+TEST_CASE("Render queues batch consecutive items with the same state and instance buffer.", "[render-queue]")
+{
+    dgl::Program program_a(dgl::empty_object);
+    dgl::Program program_b(dgl::empty_object);
+    dgl::VAO<dgl::vec3> vao_a(dgl::empty_object);
+    dgl::VAO<dgl::vec3> vao_b(dgl::empty_object);
+    dgl::VBO<dgl::mat2x4> instances(dgl::empty_object);
+    int textures_a = 0;
+    int textures_b = 0;
+
+    auto instanced = [&](dgl::Program& program,
+                         const void* texture_set,
+                         const dgl::VAOBase* vertex_array,
+                         dgl::RenderPass pass = dgl::RenderPass::Opaque) {
+        return TestRenderable(program, pass, texture_set, vertex_array, &instances);
+    };
+
+    dgl::RenderQueue queue;
+    std::vector<dgl::RenderQueueBatch> batches;
+
+    SECTION("Items with the same state form a single batch.")
+    {
+        std::vector<TestRenderable> renderables(4, instanced(program_a, &textures_a, &vao_a));
+        for (std::size_t i = 0; i < renderables.size(); i++)
+            queue.push(renderables[i], static_cast<float>(i + 1));
+        queue.sort();
+        CHECK(batchSizes(queue) == std::vector<std::size_t>{4});
+    }
+    SECTION("A different program, VAO or texture set starts a new batch.")
+    {
+        auto a = instanced(program_a, &textures_a, &vao_a);
+        auto a_other_vao = instanced(program_a, &textures_a, &vao_b);
+        auto a_other_textures = instanced(program_a, &textures_b, &vao_a);
+        auto b = instanced(program_b, &textures_a, &vao_a);
+        for (const auto* renderable : {&a, &a_other_vao, &a_other_textures, &b}) {
+            queue.push(*renderable, 1.0f);
+            queue.push(*renderable, 2.0f);
+        }
+        queue.sort();
+        CHECK(batchSizes(queue) == std::vector<std::size_t>{2, 2, 2, 2});
+    }
+    SECTION("Items without an instance buffer are drawn one by one.")
+    {
+        TestRenderable plain(program_a, dgl::RenderPass::Opaque, &textures_a, &vao_a);
+        auto batched = instanced(program_a, &textures_a, &vao_a);
+        queue.push(plain, 1.0f);
+        queue.push(plain, 2.0f);
+        queue.push(batched, 3.0f);
+        queue.push(batched, 4.0f);
+        queue.push(batched, 5.0f);
+        queue.sort();
+
+        dgl::RenderQueue::makeBatches(queue.items(), batches);
+        REQUIRE(batches.size() == 3);
+        CHECK_FALSE(batches[0].instanced);
+        CHECK_FALSE(batches[1].instanced);
+        CHECK(batches[2].instanced);
+
+        // Submitting reports one draw call per batch and counts the items of instanced batches as batched objects.
+        std::size_t batched_objects = 0;
+        for (const auto& batch : batches)
+            batched_objects += batch.instanced ? batch.count : 0;
+        CHECK(batched_objects == 3);
+    }
+    SECTION("Transparent items are not batched across items, that lie between them in depth.")
+    {
+        auto a = instanced(program_a, &textures_a, &vao_a, dgl::RenderPass::Transparent);
+        auto b = instanced(program_b, &textures_a, &vao_a, dgl::RenderPass::Transparent);
+        queue.push(a, 1.0f);
+        queue.push(a, 2.0f);
+        queue.push(b, 3.0f);
+        queue.push(a, 4.0f);
+        queue.sort();
+
+        std::vector<const dgl::Renderable*> expected{&a, &b, &a, &a};
+        CHECK(sortedRenderables(queue) == expected);
+        CHECK(batchSizes(queue) == std::vector<std::size_t>{1, 1, 2});
+    }
+    SECTION("An empty queue has no batches.")
+    {
+        batches.push_back({0, 1, false});
+        dgl::RenderQueue::makeBatches(queue.items(), batches);
+        CHECK(batches.empty());
+    }
+}
@@ -0,0 +1,447 @@
+#include "dang-gl/Image/Image.h"
+#include "dang-gl/Texturing/TextureAtlasTiles.h"
+
+#include "catch2/catch.hpp"
+
+namespace dgl = dang::gl;
+namespace dmath = dang::math;
+
+using Tiles = dgl::TextureAtlasTiles<dgl::Image2D>;
+
+TEST_CASE("TextureAtlasTiles can add and remove tiles.", "[texture-atlas]")
+{
+    Tiles tiles({256, 4});
+    const dgl::Image2D image(dmath::svec2(16, 16));
+
+    SECTION("Unnamed tiles can be checked and removed using their handle.")
+    {
+        auto handle = tiles.add(image);
+        REQUIRE(handle);
+        CHECK(tiles.exists(handle));
+        CHECK(tiles.tryRemove(handle));
+        CHECK_FALSE(handle);
+    }
+    SECTION("Named tiles can be looked up and removed by name or handle.")
+    {
+        tiles.add("a", image);
+        auto handle = tiles.addWithHandle("b", image);
+        CHECK(tiles.exists("a"));
+        CHECK(tiles.exists(handle));
+        CHECK(*tiles["b"].name() == "b");
+        CHECK_THROWS_AS(tiles.add("a", image), std::invalid_argument);
+
+        tiles.remove("a");
+        CHECK_FALSE(tiles.exists("a"));
+        CHECK_FALSE(tiles.tryRemove("a"));
+
+        tiles.remove(handle);
+        CHECK_FALSE(tiles.exists("b"));
+        CHECK_FALSE(tiles["b"]);
+        tiles.add("b", image);
+        CHECK(tiles.exists("b"));
+    }
+    SECTION("Tiles of a different atlas do not exist.")
+    {
+        Tiles other({256, 4});
+        auto handle = other.add(image);
+        CHECK_FALSE(tiles.exists(handle));
+        CHECK_FALSE(tiles.tryRemove(handle));
+        CHECK(other.exists(handle));
+    }
+}
+
+TEST_CASE("TextureAtlasTiles reuses gaps left by removed tiles.", "[texture-atlas]")
+{
+    Tiles tiles({64, 4});
+    const dgl::Image2D image(dmath::svec2(16, 16));
+
+    std::vector<Tiles::TileHandle> handles;
+    for (int i = 0; i < 16; i++)
+        handles.push_back(tiles.add(image));
+    // A 64x64 layer fits exactly 16 tiles of size 16x16.
+    CHECK(handles.back().layer() == 0);
+
+    // The first gap is filled first, regardless of the order in which the tiles were removed.
+    auto gap_pos = handles[5].pixelPos();
+    auto later_gap_pos = handles[9].pixelPos();
+    tiles.remove(handles[5]);
+    tiles.remove(handles[9]);
+    auto handle = tiles.add(image);
+    CHECK(handle.layer() == 0);
+    CHECK(handle.pixelPos() == gap_pos);
+    auto later_handle = tiles.add(image);
+    CHECK(later_handle.layer() == 0);
+    CHECK(later_handle.pixelPos() == later_gap_pos);
+
+    auto overflow = tiles.add(image);
+    CHECK(overflow.layer() == 1);
+
+    // Removing the only tile in the second layer removes the layer itself.
+    tiles.remove(overflow);
+    CHECK(tiles.add(image).layer() == 1);
+}
+
+TEST_CASE("TextureAtlasTiles uploads tiles with their borders.", "[texture-atlas]")
+{
+    Tiles tiles({64, 4});
+    dgl::Image2D image(dmath::svec2(14, 14));
+    for (const auto& pos : dmath::sbounds2(image.size()))
+        image[pos] = dgl::Image2D::Pixel(static_cast<std::uint8_t>(pos.x()), static_cast<std::uint8_t>(pos.y()), 0, 0);
+    auto small_handle = tiles.add(dgl::Image2D(dmath::svec2(6, 6)), dgl::TextureAtlasTileBorderGeneration::Positive);
+    auto handle = tiles.add(std::move(image), dgl::TextureAtlasTileBorderGeneration::All);
+    CHECK(small_handle.layer() == 0);
+    CHECK(handle.layer() == 1);
+
+    std::vector<std::pair<dgl::ivec3, dgl::Image2D>> uploads;
+    tiles.updateTexture(
+        [](GLsizei size, GLsizei layers, GLsizei) {
+            CHECK(size == 16);
+            CHECK(layers == 2);
+        },
+        [&](const dgl::Image2D::View& view, dgl::ivec3 offset, GLint) { uploads.emplace_back(offset, view); },
+        [](dgl::ivec3, dgl::ivec3, dgl::svec2, GLint) {});
+
+    // Each tile is composed with its border and uploaded at once.
+    REQUIRE(uploads.size() == 2);
+    auto& [offset, bordered] = uploads[0].second.size() == dmath::svec2(16, 16) ? uploads[0] : uploads[1];
+    CHECK(offset == dgl::ivec3(0, 0, 1));
+    REQUIRE(bordered.size() == dmath::svec2(16, 16));
+    CHECK(bordered[{1, 1}] == dgl::Image2D::Pixel(0, 0, 0, 0));
+    CHECK(bordered[{14, 14}] == dgl::Image2D::Pixel(13, 13, 0, 0));
+    CHECK(bordered[{0, 0}] == dgl::Image2D::Pixel(13, 13, 0, 0));
+    CHECK(bordered[{15, 0}] == dgl::Image2D::Pixel(0, 13, 0, 0));
+    CHECK(bordered[{15, 5}] == dgl::Image2D::Pixel(0, 4, 0, 0));
+    CHECK(bordered[{5, 0}] == dgl::Image2D::Pixel(4, 13, 0, 0));
+    CHECK(bordered[{0, 15}] == dgl::Image2D::Pixel(13, 0, 0, 0));
+}
+
+TEST_CASE("TextureAtlasTiles only uploads new tiles when the texture grows.", "[texture-atlas]")
+{
+    Tiles tiles({64, 4});
+    const dgl::Image2D small_image(dmath::svec2(16, 16));
+    const dgl::Image2D big_image(dmath::svec2(32, 32));
+
+    using Copy = std::tuple<dgl::ivec3, dgl::ivec3, dgl::svec2>;
+    std::vector<std::pair<GLsizei, GLsizei>> resizes;
+    std::size_t upload_count = 0;
+    std::vector<Copy> copies;
+    auto update = [&] {
+        upload_count = 0;
+        copies.clear();
+        tiles.updateTexture(
+            [&](GLsizei size, GLsizei layers, GLsizei) { resizes.emplace_back(size, layers); },
+            [&](const dgl::Image2D::View&, dgl::ivec3, GLint) { upload_count++; },
+            [&](dgl::ivec3 src, dgl::ivec3 dst, dgl::svec2 size, GLint) { copies.emplace_back(src, dst, size); });
+    };
+
+    std::vector<Tiles::TileHandle> small_tiles;
+    small_tiles.push_back(tiles.add(small_image));
+    update();
+    CHECK(upload_count == 1);
+    CHECK(resizes.back() == std::pair(16, 1));
+
+    for (int i = 0; i < 3; i++)
+        small_tiles.push_back(tiles.add(small_image));
+    update();
+    CHECK(upload_count == 3);
+    CHECK(resizes.back() == std::pair(32, 1));
+
+    auto big_tile = tiles.add(big_image);
+    update();
+    CHECK(upload_count == 1);
+    CHECK(resizes.back() == std::pair(32, 2));
+
+    update();
+    CHECK(upload_count == 0);
+
+    SECTION("Emptying a layer in the middle copies the last layer into its place instead of uploading it again.")
+    {
+        // A different tile size requires a new layer.
+        auto last_tile = tiles.add(dgl::Image2D(dmath::svec2(8, 8)));
+        update();
+        REQUIRE(last_tile.layer() == 2);
+        REQUIRE(upload_count == 1);
+
+        // The layer is only erased on the next update, as removing tiles has no access to the texture.
+        for (auto& tile : small_tiles)
+            tiles.remove(tile);
+        CHECK(tiles.layerCount() == 3);
+        CHECK(big_tile.layer() == 1);
+
+        update();
+        CHECK(upload_count == 0);
+        REQUIRE(copies.size() == 1);
+        CHECK(copies[0] == Copy({0, 0, 2}, {0, 0, 0}, {8, 8}));
+        CHECK(tiles.layerCount() == 2);
+        CHECK(last_tile.layer() == 0);
+        CHECK(big_tile.layer() == 1);
+        CHECK(resizes.back() == std::pair(32, 2));
+    }
+    SECTION("Emptying the last layer drops it right away.")
+    {
+        tiles.remove(big_tile);
+        CHECK(tiles.layerCount() == 1);
+        update();
+        CHECK(upload_count == 0);
+        CHECK(copies.empty());
+        CHECK(resizes.back() == std::pair(32, 1));
+    }
+}
+
+TEST_CASE("TextureAtlasTiles can defragment sparse layers.", "[texture-atlas]")
+{
+    Tiles tiles({32, 4});
+    const dgl::Image2D image(dmath::svec2(16, 16));
+
+    std::vector<Tiles::TileHandle> handles;
+    for (int i = 0; i < 8; i++)
+        handles.push_back(tiles.add(image));
+    auto big_tile = tiles.add(dgl::Image2D(dmath::svec2(32, 32)));
+    tiles.updateTexture([](GLsizei, GLsizei, GLsizei) {},
+                        [](const dgl::Image2D::View&, dgl::ivec3, GLint) {},
+                        [](dgl::ivec3, dgl::ivec3, dgl::svec2, GLint) {});
+    REQUIRE(big_tile.layer() == 2);
+
+    // Leave two holes in the first and only a single tile in the second layer.
+    tiles.remove(handles[1]);
+    tiles.remove(handles[2]);
+    for (int i = 5; i < 8; i++)
+        tiles.remove(handles[i]);
+
+    auto occupancy = tiles.occupancy();
+    CHECK(occupancy.layer_count == 3);
+    CHECK(occupancy.tile_count == 4);
+    CHECK(occupancy.capacity == 6);
+    CHECK(occupancy.reclaimable_layer_count == 1);
+
+    using Copy = std::tuple<dgl::ivec3, dgl::ivec3, dgl::svec2>;
+    std::vector<Copy> copies;
+    auto resize = [](GLsizei, GLsizei, GLsizei) {};
+    auto copy = [&](dgl::ivec3 src, dgl::ivec3 dst, dgl::svec2 size, GLint) { copies.emplace_back(src, dst, size); };
+
+    SECTION("Nothing happens without a budget.")
+    {
+        CHECK(tiles.defragment(resize, copy, 0) == 0);
+        CHECK(copies.empty());
+        CHECK(tiles.occupancy().layer_count == 3);
+    }
+    SECTION("Tiles are copied into holes and the last layer takes the place of the freed layer.")
+    {
+        CHECK(tiles.defragment(resize, copy, 8) == 1);
+        CHECK(handles[4].layer() == 0);
+        CHECK(big_tile.layer() == 1);
+        REQUIRE(copies.size() == 2);
+        CHECK(copies[0] == Copy({0, 0, 1}, {16, 0, 0}, {16, 16}));
+        CHECK(copies[1] == Copy({0, 0, 2}, {0, 0, 1}, {32, 32}));
+
+        occupancy = tiles.occupancy();
+        CHECK(occupancy.layer_count == 2);
+        CHECK(occupancy.capacity == 5);
+        CHECK(occupancy.reclaimable_layer_count == 0);
+        CHECK(tiles.defragment(resize, copy, 8) == 0);
+    }
+}
+
+TEST_CASE("TextureAtlasTiles can pack tiles of any size.", "[texture-atlas]")
+{
+    Tiles tiles({256, 2}, dgl::TextureAtlasPacking::MaxRects);
+    REQUIRE(tiles.packing() == dgl::TextureAtlasPacking::MaxRects);
+
+    // Each of these would take up a 128x128 cell in a grid.
+    std::vector<Tiles::TileHandle> handles;
+    for (int i = 0; i < 9; i++)
+        handles.push_back(tiles.add(dgl::Image2D(dmath::svec2(63, 63)), dgl::TextureAtlasTileBorderGeneration::All));
+
+    auto occupancy = tiles.occupancy();
+    CHECK(occupancy.layer_count == 1);
+    CHECK(occupancy.texture_pixel_count == 195 * 195);
+    CHECK(occupancy.tile_pixel_count == 9 * 65 * 65);
+    CHECK(handles[0].atlasPixelSize() == 195);
+
+    for (std::size_t i = 0; i < handles.size(); i++) {
+        dgl::ibounds2 rect(dgl::ivec2(handles[i].pixelPos()), dgl::ivec2(handles[i].pixelPos()) + 65);
+        for (std::size_t j = i + 1; j < handles.size(); j++) {
+            dgl::ibounds2 other(dgl::ivec2(handles[j].pixelPos()), dgl::ivec2(handles[j].pixelPos()) + 65);
+            CHECK_FALSE((rect.low.lessThan(other.high).all() && other.low.lessThan(rect.high).all()));
+        }
+    }
+
+    SECTION("Removed tiles free their space.")
+    {
+        auto position = handles[4].pixelPos();
+        tiles.remove(handles[4]);
+        auto handle = tiles.add(dgl::Image2D(dmath::svec2(65, 65)), dgl::TextureAtlasTileBorderGeneration::None);
+        CHECK(handle.pixelPos() == position);
+        CHECK(handle.layer() == 0);
+    }
+    SECTION("Tiles that do not fit go on a new layer.")
+    {
+        auto handle = tiles.add(dgl::Image2D(dmath::svec2(200, 200)));
+        CHECK(handle.layer() == 1);
+        CHECK_THROWS_AS(tiles.add(dgl::Image2D(dmath::svec2(200, 200))), std::length_error);
+        CHECK_THROWS_AS(tiles.add(dgl::Image2D(dmath::svec2(256, 256)), dgl::TextureAtlasTileBorderGeneration::All),
+                        std::invalid_argument);
+    }
+    SECTION("Batches are packed and rolled back as a whole.")
+    {
+        std::vector<Tiles::TileInfo> batch;
+        batch.push_back({"small", dgl::Image2D(dmath::svec2(10, 10)), std::nullopt});
+        batch.push_back({"", dgl::Image2D(dmath::svec2(200, 200)), std::nullopt});
+        batch.push_back({"huge", dgl::Image2D(dmath::svec2(200, 200)), std::nullopt});
+        CHECK_THROWS_AS(tiles.addBatch(std::move(batch)), std::length_error);
+        CHECK_FALSE(tiles.exists("small"));
+        CHECK(tiles.occupancy().layer_count == 1);
+        CHECK(tiles.occupancy().tile_count == 9);
+
+        batch.clear();
+        batch.push_back({"small", dgl::Image2D(dmath::svec2(10, 10)), std::nullopt});
+        batch.push_back({"big", dgl::Image2D(dmath::svec2(200, 200)), std::nullopt});
+        auto batch_handles = tiles.addBatch(std::move(batch));
+        CHECK(batch_handles[0].layer() == 0);
+        CHECK(batch_handles[1].layer() == 1);
+        CHECK(tiles.exists("small"));
+    }
+}
+
+TEST_CASE("TextureAtlasTiles invalidates all handles of a removed tile.", "[texture-atlas]")
+{
+    Tiles tiles({256, 4});
+    auto handle = tiles.addWithHandle("tile", dgl::Image2D(dmath::svec2(16, 16)));
+
+    std::vector<Tiles::TileHandle> copies(8, handle);
+    Tiles::TileHandle moved = std::move(copies[3]);
+    CHECK_FALSE(copies[3]);
+    copies[5].reset();
+    copies[6] = copies[6];
+    copies[7] = std::move(copies[1]);
+    CHECK_FALSE(copies[1]);
+
+    Tiles::TileHandle other = tiles.add(dgl::Image2D(dmath::svec2(16, 16)));
+    copies[0] = other;
+    CHECK(copies[0] == other);
+
+    tiles.remove("tile");
+    CHECK_FALSE(handle);
+    CHECK_FALSE(moved);
+    for (const auto& copy : copies)
+        CHECK(bool(copy) == (&copy == &copies[0]));
+
+    tiles.remove(other);
+    CHECK_FALSE(copies[0]);
+}
+
+TEST_CASE("TextureAtlasTiles can add a whole batch of tiles.", "[texture-atlas]")
+{
+    Tiles tiles({64, 3});
+    tiles.add("existing", dgl::Image2D(dmath::svec2(16, 16)));
+
+    auto makeBatch = [](std::size_t count, dmath::svec2 size, const std::string& prefix) {
+        std::vector<Tiles::TileInfo> batch;
+        for (std::size_t i = 0; i < count; i++)
+            batch.push_back({prefix + std::to_string(i), dgl::Image2D(size), std::nullopt});
+        return batch;
+    };
+
+    SECTION("Tiles are placed by size and returned in order.")
+    {
+        auto batch = makeBatch(20, dmath::svec2(16, 16), "big");
+        auto small = makeBatch(3, dmath::svec2(8, 8), "small");
+        batch.insert(batch.begin() + 5, std::make_move_iterator(small.begin()), std::make_move_iterator(small.end()));
+        batch.push_back({"", dgl::Image2D(dmath::svec2(8, 8)), std::nullopt});
+
+        auto handles = tiles.addBatch(std::move(batch));
+        REQUIRE(handles.size() == 24);
+        CHECK(*handles[0].name() == "big0");
+        CHECK(*handles[5].name() == "small0");
+        CHECK(handles[23].name() == nullptr);
+        CHECK(handles[5].pixelSize() == dmath::svec2(8, 8));
+
+        // 15 big tiles fill the existing layer, the remaining 5 big and 4 small tiles need one new layer each.
+        std::size_t first_layer = 0;
+        for (const auto& handle : handles)
+            first_layer += handle.layer() == 0;
+        CHECK(first_layer == 15);
+        CHECK(handles[5].layer() == handles[23].layer());
+        CHECK(handles[4].layer() != handles[5].layer());
+        CHECK(tiles.exists("big19"));
+    }
+    SECTION("Invalid batches leave the atlas unchanged.")
+    {
+        auto duplicate = makeBatch(2, dmath::svec2(16, 16), "tile");
+        duplicate.push_back({"tile0", dgl::Image2D(dmath::svec2(16, 16)), std::nullopt});
+        CHECK_THROWS_AS(tiles.addBatch(std::move(duplicate)), std::invalid_argument);
+
+        auto existing = makeBatch(2, dmath::svec2(16, 16), "tile");
+        existing.push_back({"existing", dgl::Image2D(dmath::svec2(16, 16)), std::nullopt});
+        CHECK_THROWS_AS(tiles.addBatch(std::move(existing)), std::invalid_argument);
+
+        auto too_many = makeBatch(16 * 3, dmath::svec2(16, 16), "tile");
+        CHECK_THROWS_AS(tiles.addBatch(std::move(too_many)), std::length_error);
+
+        CHECK_FALSE(tiles.exists("tile0"));
+        auto handle = tiles.add(dgl::Image2D(dmath::svec2(16, 16)));
+        CHECK(handle.layer() == 0);
+    }
+}
+
+TEST_CASE("TextureAtlasTiles uploads a separate mipmap chain for each tile.", "[texture-atlas]")
+{
+    CHECK_THROWS_AS(Tiles({64, 4}, dgl::TextureAtlasPacking::Grid, 0), std::invalid_argument);
+    CHECK_THROWS_AS(Tiles({64, 4}, dgl::TextureAtlasPacking::Grid, 8), std::invalid_argument);
+
+    using Upload = std::tuple<dgl::ivec3, dmath::svec2, GLint>;
+    std::vector<Upload> uploads;
+    GLsizei resized_levels = 0;
+    auto update = [&](Tiles& tiles) {
+        uploads.clear();
+        tiles.updateTexture(
+            [&](GLsizei, GLsizei, GLsizei mipmap_levels) { resized_levels = mipmap_levels; },
+            [&](const dgl::Image2D::View& view, dgl::ivec3 offset, GLint level) {
+                uploads.emplace_back(offset, view.size(), level);
+            },
+            [](dgl::ivec3, dgl::ivec3, dgl::svec2, GLint) {});
+    };
+
+    SECTION("Tiles are never smaller than a pixel of the smallest level.")
+    {
+        Tiles tiles({64, 4}, dgl::TextureAtlasPacking::Grid, 4);
+        CHECK(tiles.mipmapLevels() == 4);
+        auto first_handle = tiles.add(dgl::Image2D(dmath::svec2(4, 4)));
+        auto handle = tiles.add(dgl::Image2D(dmath::svec2(4, 4)));
+        update(tiles);
+        CHECK(resized_levels == 4);
+        CHECK(first_handle.pixelPos() == dgl::svec2(0, 0));
+        CHECK(handle.pixelPos() == dgl::svec2(8, 0));
+        REQUIRE(uploads.size() == 8);
+        CHECK(std::count(uploads.begin(), uploads.end(), Upload({8, 0, 0}, {4, 4}, 0)) == 1);
+        CHECK(std::count(uploads.begin(), uploads.end(), Upload({4, 0, 0}, {2, 2}, 1)) == 1);
+        CHECK(std::count(uploads.begin(), uploads.end(), Upload({1, 0, 0}, {1, 1}, 3)) == 1);
+    }
+    SECTION("Borders shrink on levels, which have no room left for them.")
+    {
+        Tiles tiles({64, 4}, dgl::TextureAtlasPacking::Grid, 2);
+        auto handle = tiles.add(dgl::Image2D(dmath::svec2(14, 14)), dgl::TextureAtlasTileBorderGeneration::All);
+        update(tiles);
+        CHECK(handle.pixelPos() == dgl::svec2(0, 0));
+        CHECK(handle.pixelSize() == dmath::svec2(14, 14));
+        auto level_count = [&](GLint level) {
+            return std::count_if(
+                uploads.begin(), uploads.end(), [&](const Upload& upload) { return std::get<2>(upload) == level; });
+        };
+        CHECK(level_count(0) == 1);
+        CHECK(level_count(1) == 1);
+        CHECK(std::count(uploads.begin(), uploads.end(), Upload({0, 0, 0}, {16, 16}, 0)) == 1);
+        CHECK(std::count(uploads.begin(), uploads.end(), Upload({0, 0, 0}, {8, 8}, 1)) == 1);
+    }
+    SECTION("Packed tiles are aligned to the smallest level.")
+    {
+        Tiles tiles({64, 4}, dgl::TextureAtlasPacking::MaxRects, 3);
+        auto first_handle = tiles.add(dgl::Image2D(dmath::svec2(5, 3)));
+        auto handle = tiles.add(dgl::Image2D(dmath::svec2(5, 3)));
+        update(tiles);
+        CHECK(first_handle.pixelPos() == dgl::svec2(0, 0));
+        CHECK(handle.pixelPos().x() % 4 == 0);
+        CHECK(handle.pixelPos().y() % 4 == 0);
+        CHECK(uploads.size() == 6);
+    }
+}
@@ -0,0 +1,213 @@
+#include "dang-gl/Texturing/VirtualTexturePageTable.h"
+#include "dang-gl/Texturing/VirtualTextureResidency.h"
+
+#include "catch2/catch.hpp"
+
+namespace dgl = dang::gl;
+namespace dmath = dang::math;
+
+namespace {
+
+dgl::VirtualTexturePage page(GLsizei x, GLsizei y, GLint level = 0) { return {dgl::svec2(x, y), level}; }
+
+std::vector<dgl::VirtualTexturePage> loadedPages(const std::vector<dgl::VirtualTextureResidency::Load>& loads)
+{
+    std::vector<dgl::VirtualTexturePage> result;
+    for (const auto& load : loads)
+        result.push_back(load.page);
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("VirtualTextureResidency keeps the most recently used pages.", "[virtual-texture]")
+{
+    dgl::VirtualTextureResidency residency(3);
+
+    SECTION("Residency requires at least one slot.")
+    {
+        CHECK_THROWS_AS(dgl::VirtualTextureResidency(0), std::invalid_argument);
+    }
+    SECTION("Missing pages are assigned free slots in order.")
+    {
+        auto loads = residency.update({page(0, 0), page(1, 0), page(0, 0)}, 4);
+        REQUIRE(loads.size() == 2);
+        CHECK(loads[0].page == page(0, 0));
+        CHECK(loads[0].slot == 0);
+        CHECK_FALSE(loads[0].evicted);
+        CHECK(loads[1].page == page(1, 0));
+        CHECK(loads[1].slot == 1);
+        CHECK(residency.residentCount() == 2);
+        CHECK(residency.slot(page(1, 0)) == std::optional<std::size_t>(1));
+        CHECK_FALSE(residency.slot(page(2, 0)));
+
+        CHECK(residency.update({page(0, 0), page(1, 0)}, 4).empty());
+    }
+    SECTION("The least recently used page is evicted first.")
+    {
+        residency.update({page(0, 0), page(1, 0), page(2, 0)}, 4);
+        residency.update({page(0, 0)}, 4);
+        residency.update({page(2, 0)}, 4);
+
+        auto loads = residency.update({page(3, 0)}, 4);
+        REQUIRE(loads.size() == 1);
+        CHECK(loads[0].slot == 1);
+        CHECK(loads[0].evicted == page(1, 0));
+        CHECK_FALSE(residency.slot(page(1, 0)));
+        CHECK(residency.slot(page(3, 0)) == std::optional<std::size_t>(1));
+
+        loads = residency.update({page(4, 0)}, 4);
+        REQUIRE(loads.size() == 1);
+        CHECK(loads[0].evicted == page(0, 0));
+    }
+    SECTION("Pages requested in the same update are never evicted.")
+    {
+        auto loads = residency.update({page(0, 0), page(1, 0), page(2, 0), page(3, 0), page(4, 0)}, 8);
+        CHECK(loads.size() == 3);
+        CHECK(residency.residentCount() == 3);
+        for (const auto& load : loads)
+            CHECK_FALSE(load.evicted);
+
+        loads = residency.update({page(0, 0), page(1, 0), page(3, 0)}, 8);
+        REQUIRE(loads.size() == 1);
+        CHECK(loads[0].page == page(3, 0));
+        CHECK(loads[0].evicted == page(2, 0));
+    }
+    SECTION("Coarser levels are loaded first and loads are limited per update.")
+    {
+        auto loads = residency.update({page(0, 0), page(1, 1), page(0, 0, 2), page(0, 0, 1)}, 2);
+        CHECK(loadedPages(loads) == std::vector{page(0, 0, 2), page(0, 0, 1)});
+
+        loads = residency.update({page(0, 0), page(1, 1), page(0, 0, 2), page(0, 0, 1)}, 2);
+        CHECK(loadedPages(loads) == std::vector{page(0, 0)});
+    }
+    SECTION("Evicting a single page frees its slot.")
+    {
+        residency.update({page(0, 0), page(1, 0), page(2, 0)}, 4);
+        CHECK(residency.evict(page(1, 0)));
+        CHECK_FALSE(residency.evict(page(1, 0)));
+        CHECK(residency.residentCount() == 2);
+        CHECK_FALSE(residency.slot(page(1, 0)));
+
+        auto loads = residency.update({page(1, 0)}, 4);
+        REQUIRE(loads.size() == 1);
+        CHECK(loads[0].slot == 1);
+        CHECK_FALSE(loads[0].evicted);
+    }
+    SECTION("Clearing frees all slots.")
+    {
+        residency.update({page(0, 0), page(1, 0), page(2, 0)}, 4);
+        residency.clear();
+        CHECK(residency.residentCount() == 0);
+
+        auto loads = residency.update({page(5, 5)}, 4);
+        REQUIRE(loads.size() == 1);
+        CHECK(loads[0].slot == 0);
+        CHECK_FALSE(loads[0].evicted);
+    }
+}
+
+TEST_CASE("VirtualTexturePageTable resolves pages to the finest resident page.", "[virtual-texture]")
+{
+    dgl::VirtualTexturePageTable page_table(dgl::svec2(8, 4), 3);
+
+    CHECK(page_table.pageCount(0) == dgl::svec2(8, 4));
+    CHECK(page_table.pageCount(1) == dgl::svec2(4, 2));
+    CHECK(page_table.pageCount(2) == dgl::svec2(2, 1));
+    CHECK_FALSE(page_table.contains(page(8, 0)));
+    CHECK_FALSE(page_table.contains(page(0, 0, 3)));
+    CHECK_THROWS_AS(page_table.setResident(page(0, 2, 2), 0), std::out_of_range);
+
+    CHECK_FALSE(page_table.resolve(page(4, 3)));
+
+    page_table.setResident(page(1, 0, 2), 7);
+    page_table.setResident(page(2, 1, 1), 3);
+    page_table.setResident(page(4, 3), 70000);
+
+    using Entry = dgl::VirtualTexturePageTable::Entry;
+    CHECK(page_table.resolve(page(4, 3)) == Entry{70000, 0});
+    CHECK(page_table.resolve(page(4, 2)) == Entry{3, 1});
+    CHECK(page_table.resolve(page(4, 0)) == Entry{7, 2});
+    CHECK_FALSE(page_table.resolve(page(0, 0)));
+
+    REQUIRE(page_table.dirty());
+    const auto& images = page_table.images();
+    CHECK_FALSE(page_table.dirty());
+    REQUIRE(images.size() == 3);
+    using Pixel = dgl::VirtualTexturePageTable::IndirectionImage::Pixel;
+    CHECK(images[0][dmath::svec2(4, 3)] == Pixel(70000 & 0xFFFF, 70000 >> 16, 0, 1));
+    CHECK(images[0][dmath::svec2(4, 2)] == Pixel(3, 0, 1, 1));
+    CHECK(images[0][dmath::svec2(4, 0)] == Pixel(7, 0, 2, 1));
+    CHECK(images[0][dmath::svec2(0, 0)] == Pixel(0, 0, 0, 0));
+    CHECK(images[1][dmath::svec2(2, 1)] == Pixel(3, 0, 1, 1));
+
+    page_table.setMissing(page(2, 1, 1));
+    CHECK(page_table.resolve(page(4, 2)) == Entry{7, 2});
+    CHECK(page_table.images()[0][dmath::svec2(4, 2)] == Pixel(7, 0, 2, 1));
+}
+
+TEST_CASE("VirtualTexturePageTable levels match the mipmap levels of a texture.", "[virtual-texture]")
+{
+    // Only powers of two give every page a parent and keep the level sizes in line with the indirection texture.
+    CHECK_THROWS_AS(dgl::VirtualTexturePageTable(dgl::svec2(5, 4), 1), std::invalid_argument);
+    CHECK_THROWS_AS(dgl::VirtualTexturePageTable(dgl::svec2(8, 6), 1), std::invalid_argument);
+    CHECK_THROWS_AS(dgl::VirtualTexturePageTable(dgl::svec2(0, 4), 1), std::invalid_argument);
+    CHECK_THROWS_AS(dgl::VirtualTexturePageTable(dgl::svec2(8, 4), 0), std::invalid_argument);
+    CHECK_THROWS_AS(dgl::VirtualTexturePageTable(dgl::svec2(8, 4), 5), std::invalid_argument);
+
+    dgl::VirtualTexturePageTable page_table(dgl::svec2(8, 2), 4);
+    const auto& images = page_table.images();
+    REQUIRE(images.size() == 4);
+    for (GLint level = 0; level < page_table.levelCount(); level++) {
+        auto mipmap_size = dgl::svec2(std::max(8 >> level, 1), std::max(2 >> level, 1));
+        CHECK(page_table.pageCount(level) == mipmap_size);
+        CHECK(images[level].size() == static_cast<dmath::svec2>(mipmap_size));
+    }
+
+    page_table.setResident(page(0, 0, 3), 5);
+    CHECK(page_table.resolve(page(7, 1)) == dgl::VirtualTexturePageTable::Entry{5, 3});
+}
+
+TEST_CASE("Virtual texture residency can be simulated without a GPU.", "[virtual-texture]")
+{
+    // A view moves diagonally across the finest level, requesting a 2x2 block of pages and all of their ancestors.
+    // It stays at each position for a few frames, which is enough to stream in all pages it sees.
+    constexpr GLint level_count = 4;
+    constexpr int frames_per_position = 3;
+    dgl::VirtualTexturePageTable page_table(dgl::svec2(16, 16), level_count);
+    dgl::VirtualTextureResidency residency(16);
+
+    for (GLsizei position = 0; position < 15; position++) {
+        std::vector<dgl::VirtualTexturePage> requested;
+        for (GLsizei y = 0; y < 2; y++) {
+            for (GLsizei x = 0; x < 2; x++) {
+                auto current = page(position + x, position + y);
+                for (; current.level < level_count; current = current.parent())
+                    requested.push_back(current);
+            }
+        }
+
+        for (int frame = 0; frame < frames_per_position; frame++) {
+            for (const auto& load : residency.update(requested, 6)) {
+                if (load.evicted)
+                    page_table.setMissing(*load.evicted);
+                page_table.setResident(load.page, load.slot);
+            }
+            CHECK(residency.residentCount() <= residency.slotCount());
+
+            // Coarser pages are loaded first, so every requested page resolves to a resident ancestor.
+            for (const auto& current : requested) {
+                auto entry = page_table.resolve(current);
+                REQUIRE(entry);
+                REQUIRE(entry->level >= current.level);
+                auto resolved = current;
+                while (resolved.level < entry->level)
+                    resolved = resolved.parent();
+                CHECK(residency.slot(resolved) == std::optional<std::size_t>(entry->slot));
+            }
+        }
+
+        for (const auto& current : requested)
+            CHECK(page_table.resolve(current)->level == current.level);
+    }
+}
@@ -0,0 +1,550 @@
+#pragma once
+
+#include "dang-math/global.h"
+#include "dang-math/matrix.h"
+#include "dang-math/quaternion.h"
+#include "dang-math/vector.h"
+
+namespace dang::math {
+
+/// @brief A non-owning view on a structure-of-arrays of vectors, with a separate array for each component.
+/// @remark Use a const type to get a read-only view.
+template <typename T, std::size_t v_dim>
+struct VectorSpan {
+    using Type = std::remove_const_t<T>;
+    static constexpr auto dim = v_dim;
+
+    using Value = Vector<Type, dim>;
+    using Components = std::array<T*, dim>;
+
+    /// @brief Initializes an empty span.
+    constexpr VectorSpan() = default;
+
+    /// @brief Initializes the span from a pointer for each component and the number of vectors.
+    constexpr VectorSpan(const Components& components, std::size_t size)
+        : components_(components)
+        , size_(size)
+    {}
+
+    /// @brief Allows for implicit conversion from a mutable into a read-only span.
+    template <typename TOther, typename = std::enable_if_t<std::is_same_v<const TOther, T>>>
+    constexpr VectorSpan(const VectorSpan<TOther, dim>& other)
+        : size_(other.size())
+    {
+        for (std::size_t i = 0; i < dim; i++)
+            components_[i] = other.component(i);
+    }
+
+    /// @brief The number of vectors in the span.
+    constexpr std::size_t size() const { return size_; }
+
+    /// @brief Whether the span does not contain any vectors.
+    constexpr bool empty() const { return size_ == 0; }
+
+    /// @brief Returns a pointer to the contiguous array of the given component.
+    constexpr T* component(std::size_t index) const { return components_[index]; }
+
+    /// @brief Gathers the vector at the given index.
+    constexpr Value operator[](std::size_t index) const
+    {
+        Value result;
+        for (std::size_t i = 0; i < dim; i++)
+            result[i] = components_[i][index];
+        return result;
+    }
+
+    /// @brief Scatters the given vector to the given index.
+    constexpr void set(std::size_t index, const Value& value) const
+    {
+        static_assert(!std::is_const_v<T>, "cannot modify a read-only span");
+        for (std::size_t i = 0; i < dim; i++)
+            components_[i][index] = value[i];
+    }
+
+    /// @brief Returns a span on a subrange of the vectors.
+    constexpr VectorSpan subspan(std::size_t offset, std::size_t count) const
+    {
+        assert(offset + count <= size_);
+        Components components;
+        for (std::size_t i = 0; i < dim; i++)
+            components[i] = components_[i] + offset;
+        return {components, count};
+    }
+
+private:
+    Components components_{};
+    std::size_t size_ = 0;
+};
+
+/// @brief A non-owning view on elements, which are separated by an arbitrary stride in bytes.
+/// @remark Allows reading and writing a single attribute of interleaved data, e.g. the positions of mapped vertices.
+/// Use a const type to get a read-only view.
+template <typename T>
+struct StridedSpan {
+    using Byte = std::conditional_t<std::is_const_v<T>, const std::byte, std::byte>;
+
+    /// @brief Initializes an empty span.
+    constexpr StridedSpan() = default;
+
+    /// @brief Initializes the span from a pointer to the first element, the number of elements and the stride in bytes.
+    StridedSpan(T* data, std::size_t size, std::size_t stride = sizeof(T))
+        : data_(reinterpret_cast<Byte*>(data))
+        , size_(size)
+        , stride_(stride)
+    {}
+
+    /// @brief Initializes the span on a single member of a contiguous array of structs.
+    template <typename TStruct, typename TMember>
+    StridedSpan(TStruct* data, std::size_t size, TMember TStruct::*member)
+        : StridedSpan(&(data->*member), size, sizeof(TStruct))
+    {}
+
+    /// @brief Allows for implicit conversion from a mutable into a read-only span.
+    template <typename TOther, typename = std::enable_if_t<std::is_same_v<const TOther, T>>>
+    constexpr StridedSpan(const StridedSpan<TOther>& other)
+        : data_(other.bytes())
+        , size_(other.size())
+        , stride_(other.stride())
+    {}
+
+    /// @brief The number of elements in the span.
+    constexpr std::size_t size() const { return size_; }
+
+    /// @brief Whether the span does not contain any elements.
+    constexpr bool empty() const { return size_ == 0; }
+
+    /// @brief The distance between two elements in bytes.
+    constexpr std::size_t stride() const { return stride_; }
+
+    /// @brief Returns a pointer to the first byte of the first element.
+    constexpr Byte* bytes() const { return data_; }
+
+    /// @brief Returns a reference to the element at the given index.
+    T& operator[](std::size_t index) const { return *reinterpret_cast<T*>(data_ + index * stride_); }
+
+    /// @brief Returns a span on a subrange of the elements.
+    constexpr StridedSpan subspan(std::size_t offset, std::size_t count) const
+    {
+        assert(offset + count <= size_);
+        StridedSpan result;
+        result.data_ = data_ + offset * stride_;
+        result.size_ = count;
+        result.stride_ = stride_;
+        return result;
+    }
+
+private:
+    Byte* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t stride_ = sizeof(T);
+};
+
+namespace detail {
+
+// TODO: C++20 replace with std::type_identity_t
+template <typename T>
+struct type_identity {
+    using type = T;
+};
+
+/// @brief A read-only span, which does not participate in template argument deduction.
+/// @remark Allows passing batches and mutable spans, which are implicitly converted.
+template <typename T, std::size_t v_dim>
+using InputSpan = typename type_identity<VectorSpan<const T, v_dim>>::type;
+
+} // namespace detail
+
+/// @brief Kernels, which process a whole structure-of-arrays of vectors at once.
+/// @remark All loops are branch-free over contiguous component arrays, so that compilers vectorize them to whatever
+/// lane count the target instruction set supports.
+/// @remark The output may be the same as one of the inputs, but must not otherwise overlap with them.
+namespace batch {
+
+/// @brief Converts an array-of-structures into the given structure-of-arrays.
+template <typename T, std::size_t v_dim>
+void deinterleave(const Vector<T, v_dim>* vectors, VectorSpan<T, v_dim> out)
+{
+    for (std::size_t d = 0; d < v_dim; d++) {
+        T* component = out.component(d);
+        for (std::size_t i = 0; i < out.size(); i++)
+            component[i] = vectors[i][d];
+    }
+}
+
+/// @brief Converts a structure-of-arrays into the given array-of-structures.
+template <typename T, std::size_t v_dim>
+void interleave(detail::InputSpan<T, v_dim> vectors, Vector<T, v_dim>* out)
+{
+    for (std::size_t d = 0; d < v_dim; d++) {
+        const T* component = vectors.component(d);
+        for (std::size_t i = 0; i < vectors.size(); i++)
+            out[i][d] = component[i];
+    }
+}
+
+/// @brief Performs an operation on each component of both inputs.
+template <typename T, std::size_t v_dim, typename TOperation>
+void componentwise(TOperation operation,
+                   detail::InputSpan<T, v_dim> lhs,
+                   detail::InputSpan<T, v_dim> rhs,
+                   VectorSpan<T, v_dim> out)
+{
+    assert(lhs.size() == out.size() && rhs.size() == out.size());
+    for (std::size_t d = 0; d < v_dim; d++) {
+        const T* a = lhs.component(d);
+        const T* b = rhs.component(d);
+        T* result = out.component(d);
+        for (std::size_t i = 0; i < out.size(); i++)
+            result[i] = operation(a[i], b[i]);
+    }
+}
+
+/// @brief Component-wise addition.
+template <typename T, std::size_t v_dim>
+void add(detail::InputSpan<T, v_dim> lhs, detail::InputSpan<T, v_dim> rhs, VectorSpan<T, v_dim> out)
+{
+    componentwise(std::plus{}, lhs, rhs, out);
+}
+
+/// @brief Component-wise subtraction.
+template <typename T, std::size_t v_dim>
+void sub(detail::InputSpan<T, v_dim> lhs, detail::InputSpan<T, v_dim> rhs, VectorSpan<T, v_dim> out)
+{
+    componentwise(std::minus{}, lhs, rhs, out);
+}
+
+/// @brief Component-wise multiplication.
+template <typename T, std::size_t v_dim>
+void mul(detail::InputSpan<T, v_dim> lhs, detail::InputSpan<T, v_dim> rhs, VectorSpan<T, v_dim> out)
+{
+    componentwise(std::multiplies{}, lhs, rhs, out);
+}
+
+/// @brief Component-wise division.
+template <typename T, std::size_t v_dim>
+void div(detail::InputSpan<T, v_dim> lhs, detail::InputSpan<T, v_dim> rhs, VectorSpan<T, v_dim> out)
+{
+    componentwise(std::divides{}, lhs, rhs, out);
+}
+
+/// @brief Component-wise minimum.
+template <typename T, std::size_t v_dim>
+void min(detail::InputSpan<T, v_dim> lhs, detail::InputSpan<T, v_dim> rhs, VectorSpan<T, v_dim> out)
+{
+    componentwise(detail::Min{}, lhs, rhs, out);
+}
+
+/// @brief Component-wise maximum.
+template <typename T, std::size_t v_dim>
+void max(detail::InputSpan<T, v_dim> lhs, detail::InputSpan<T, v_dim> rhs, VectorSpan<T, v_dim> out)
+{
+    componentwise(detail::Max{}, lhs, rhs, out);
+}
+
+/// @brief Multiplies every vector with the same scalar.
+template <typename T, std::size_t v_dim>
+void scale(detail::InputSpan<T, v_dim> vectors, T factor, VectorSpan<T, v_dim> out)
+{
+    assert(vectors.size() == out.size());
+    for (std::size_t d = 0; d < v_dim; d++) {
+        const T* a = vectors.component(d);
+        T* result = out.component(d);
+        for (std::size_t i = 0; i < out.size(); i++)
+            result[i] = a[i] * factor;
+    }
+}
+
+/// @brief Linearly interpolates between each pair of vectors using the same factor.
+template <typename T, std::size_t v_dim>
+void interpolate(detail::InputSpan<T, v_dim> from,
+                 detail::InputSpan<T, v_dim> to,
+                 T factor,
+                 VectorSpan<T, v_dim> out)
+{
+    componentwise([factor](T a, T b) { return a + factor * (b - a); }, from, to, out);
+}
+
+/// @brief Calculates the dot-product of each pair of vectors.
+/// @remark As the output does not carry the dimension, the first argument must be a span.
+template <typename TSpanType, std::size_t v_dim, typename T = std::remove_const_t<TSpanType>>
+void dot(VectorSpan<TSpanType, v_dim> lhs, detail::InputSpan<T, v_dim> rhs, T* out)
+{
+    assert(lhs.size() == rhs.size());
+    // Each result is only written after reading all of its components, as the output may be one of them.
+    for (std::size_t i = 0; i < lhs.size(); i++) {
+        T result = lhs.component(0)[i] * rhs.component(0)[i];
+        for (std::size_t d = 1; d < v_dim; d++)
+            result += lhs.component(d)[i] * rhs.component(d)[i];
+        out[i] = result;
+    }
+}
+
+/// @brief Calculates the length of each vector.
+/// @remark As the output does not carry the dimension, the argument must be a span.
+template <typename TSpanType, std::size_t v_dim, typename T = std::remove_const_t<TSpanType>>
+void length(VectorSpan<TSpanType, v_dim> vectors, T* out)
+{
+    static_assert(std::is_floating_point_v<T>);
+    dot(vectors, vectors, out);
+    for (std::size_t i = 0; i < vectors.size(); i++)
+        out[i] = std::sqrt(out[i]);
+}
+
+/// @brief Calculates the cross-product of each pair of vectors.
+template <typename T>
+void cross(detail::InputSpan<T, 3> lhs, detail::InputSpan<T, 3> rhs, VectorSpan<T, 3> out)
+{
+    assert(lhs.size() == out.size() && rhs.size() == out.size());
+    // Results are buffered per block, as compilers give up on checking this many pointers for aliasing at runtime.
+    constexpr std::size_t block_size = 256;
+    T x[block_size];
+    T y[block_size];
+    T z[block_size];
+    for (std::size_t offset = 0; offset < out.size(); offset += block_size) {
+        std::size_t count = std::min(block_size, out.size() - offset);
+        const T* ax = lhs.component(0) + offset;
+        const T* ay = lhs.component(1) + offset;
+        const T* az = lhs.component(2) + offset;
+        const T* bx = rhs.component(0) + offset;
+        const T* by = rhs.component(1) + offset;
+        const T* bz = rhs.component(2) + offset;
+        for (std::size_t i = 0; i < count; i++) {
+            x[i] = ay[i] * bz[i] - az[i] * by[i];
+            y[i] = az[i] * bx[i] - ax[i] * bz[i];
+            z[i] = ax[i] * by[i] - ay[i] * bx[i];
+        }
+        std::copy_n(x, count, out.component(0) + offset);
+        std::copy_n(y, count, out.component(1) + offset);
+        std::copy_n(z, count, out.component(2) + offset);
+    }
+}
+
+/// @brief Normalizes each vector.
+template <typename T, std::size_t v_dim>
+void normalize(detail::InputSpan<T, v_dim> vectors, VectorSpan<T, v_dim> out)
+{
+    static_assert(std::is_floating_point_v<T>);
+    assert(vectors.size() == out.size());
+    constexpr std::size_t block_size = 256;
+    T inverse_lengths[block_size];
+    for (std::size_t offset = 0; offset < out.size(); offset += block_size) {
+        std::size_t count = std::min(block_size, out.size() - offset);
+        auto block = vectors.subspan(offset, count);
+        length(block, inverse_lengths);
+        for (std::size_t i = 0; i < count; i++)
+            inverse_lengths[i] = T{1} / inverse_lengths[i];
+        for (std::size_t d = 0; d < v_dim; d++) {
+            const T* a = block.component(d);
+            T* result = out.component(d) + offset;
+            for (std::size_t i = 0; i < count; i++)
+                result[i] = a[i] * inverse_lengths[i];
+        }
+    }
+}
+
+/// @brief Transforms each point by the given matrix, assuming a w-component of one.
+/// @remark The resulting w-component is discarded, so this is only correct for affine transformations.
+template <typename T>
+void transform(const Matrix<T, 4>& matrix, detail::InputSpan<T, 3> points, VectorSpan<T, 3> out)
+{
+    assert(points.size() == out.size());
+    const T* px = points.component(0);
+    const T* py = points.component(1);
+    const T* pz = points.component(2);
+    T* x = out.component(0);
+    T* y = out.component(1);
+    T* z = out.component(2);
+    const auto& m = matrix;
+    for (std::size_t i = 0; i < out.size(); i++) {
+        T rx = m(0, 0) * px[i] + m(1, 0) * py[i] + m(2, 0) * pz[i] + m(3, 0);
+        T ry = m(0, 1) * px[i] + m(1, 1) * py[i] + m(2, 1) * pz[i] + m(3, 1);
+        T rz = m(0, 2) * px[i] + m(1, 2) * py[i] + m(2, 2) * pz[i] + m(3, 2);
+        x[i] = rx;
+        y[i] = ry;
+        z[i] = rz;
+    }
+}
+
+/// @brief Multiplies the given matrix with each vector.
+template <typename T>
+void transform(const Matrix<T, 4>& matrix, detail::InputSpan<T, 4> vectors, VectorSpan<T, 4> out)
+{
+    assert(vectors.size() == out.size());
+    const T* vx = vectors.component(0);
+    const T* vy = vectors.component(1);
+    const T* vz = vectors.component(2);
+    const T* vw = vectors.component(3);
+    T* x = out.component(0);
+    T* y = out.component(1);
+    T* z = out.component(2);
+    T* w = out.component(3);
+    const auto& m = matrix;
+    for (std::size_t i = 0; i < out.size(); i++) {
+        T rx = m(0, 0) * vx[i] + m(1, 0) * vy[i] + m(2, 0) * vz[i] + m(3, 0) * vw[i];
+        T ry = m(0, 1) * vx[i] + m(1, 1) * vy[i] + m(2, 1) * vz[i] + m(3, 1) * vw[i];
+        T rz = m(0, 2) * vx[i] + m(1, 2) * vy[i] + m(2, 2) * vz[i] + m(3, 2) * vw[i];
+        T rw = m(0, 3) * vx[i] + m(1, 3) * vy[i] + m(2, 3) * vz[i] + m(3, 3) * vw[i];
+        x[i] = rx;
+        y[i] = ry;
+        z[i] = rz;
+        w[i] = rw;
+    }
+}
+
+/// @brief Applies the transformation of the given quaternion to each vector.
+/// @remark The quaternion should be normalized.
+template <typename T>
+void transform(const Quaternion<T>& quaternion, detail::InputSpan<T, 3> vectors, VectorSpan<T, 3> out)
+{
+    assert(vectors.size() == out.size());
+    const T* vx = vectors.component(0);
+    const T* vy = vectors.component(1);
+    const T* vz = vectors.component(2);
+    T* x = out.component(0);
+    T* y = out.component(1);
+    T* z = out.component(2);
+    const T qw = quaternion.w();
+    const T qx = quaternion.x();
+    const T qy = quaternion.y();
+    const T qz = quaternion.z();
+    for (std::size_t i = 0; i < out.size(); i++) {
+        // Same as the single vector version: v + 2 * (w * (u x v) + u x (u x v))
+        T uvx = qy * vz[i] - qz * vy[i];
+        T uvy = qz * vx[i] - qx * vz[i];
+        T uvz = qx * vy[i] - qy * vx[i];
+        T uuvx = qy * uvz - qz * uvy;
+        T uuvy = qz * uvx - qx * uvz;
+        T uuvz = qx * uvy - qy * uvx;
+        T rx = vx[i] + T(2) * (qw * uvx + uuvx);
+        T ry = vy[i] + T(2) * (qw * uvy + uuvy);
+        T rz = vz[i] + T(2) * (qw * uvz + uuvz);
+        x[i] = rx;
+        y[i] = ry;
+        z[i] = rz;
+    }
+}
+
+} // namespace batch
+
+/// @brief An owning structure-of-arrays of vectors, which stores each component in a separate contiguous array.
+/// @remark Meant to be used with the kernels in the batch namespace, which process many vectors at once.
+template <typename T, std::size_t v_dim>
+struct VectorBatch {
+    using Type = T;
+    static constexpr auto dim = v_dim;
+
+    using Value = Vector<T, dim>;
+    using Span = VectorSpan<T, dim>;
+    using ConstSpan = VectorSpan<const T, dim>;
+
+    /// @brief Initializes an empty batch.
+    VectorBatch() = default;
+
+    /// @brief Initializes the batch with the given number of copies of the given vector.
+    explicit VectorBatch(std::size_t size, const Value& value = {})
+    {
+        for (std::size_t i = 0; i < dim; i++)
+            components_[i].assign(size, value[i]);
+    }
+
+    /// @brief Initializes the batch from an array-of-structures.
+    explicit VectorBatch(const std::vector<Value>& vectors)
+        : VectorBatch(vectors.size())
+    {
+        batch::deinterleave(vectors.data(), span());
+    }
+
+    /// @brief Converts the batch back into an array-of-structures.
+    std::vector<Value> toVectors() const
+    {
+        std::vector<Value> result(size());
+        batch::interleave(span(), result.data());
+        return result;
+    }
+
+    /// @brief The number of vectors in the batch.
+    std::size_t size() const { return components_[0].size(); }
+
+    /// @brief Whether the batch does not contain any vectors.
+    bool empty() const { return components_[0].empty(); }
+
+    /// @brief Resizes the batch, filling new entries with the given vector.
+    void resize(std::size_t size, const Value& value = {})
+    {
+        for (std::size_t i = 0; i < dim; i++)
+            components_[i].resize(size, value[i]);
+    }
+
+    /// @brief Reserves space for the given number of vectors.
+    void reserve(std::size_t capacity)
+    {
+        for (auto& component : components_)
+            component.reserve(capacity);
+    }
+
+    /// @brief Removes all vectors from the batch.
+    void clear()
+    {
+        for (auto& component : components_)
+            component.clear();
+    }
+
+    /// @brief Appends the given vector.
+    void push_back(const Value& value)
+    {
+        for (std::size_t i = 0; i < dim; i++)
+            components_[i].push_back(value[i]);
+    }
+
+    /// @brief Returns a pointer to the contiguous array of the given component.
+    T* component(std::size_t index) { return components_[index].data(); }
+
+    /// @brief Returns a pointer to the contiguous array of the given component.
+    const T* component(std::size_t index) const { return components_[index].data(); }
+
+    /// @brief Gathers the vector at the given index.
+    Value operator[](std::size_t index) const { return span()[index]; }
+
+    /// @brief Scatters the given vector to the given index.
+    void set(std::size_t index, const Value& value) { span().set(index, value); }
+
+    /// @brief Returns a mutable span of the whole batch.
+    Span span()
+    {
+        typename Span::Components components;
+        for (std::size_t i = 0; i < dim; i++)
+            components[i] = components_[i].data();
+        return {components, size()};
+    }
+
+    /// @brief Returns a read-only span of the whole batch.
+    ConstSpan span() const
+    {
+        typename ConstSpan::Components components;
+        for (std::size_t i = 0; i < dim; i++)
+            components[i] = components_[i].data();
+        return {components, size()};
+    }
+
+    operator Span() { return span(); }
+    operator ConstSpan() const { return span(); }
+
+private:
+    std::array<std::vector<T>, dim> components_;
+};
+
+template <std::size_t v_dim>
+using vecbatch = VectorBatch<float, v_dim>;
+
+template <std::size_t v_dim>
+using dvecbatch = VectorBatch<double, v_dim>;
+
+using vec2batch = vecbatch<2>;
+using vec3batch = vecbatch<3>;
+using vec4batch = vecbatch<4>;
+
+using dvec2batch = dvecbatch<2>;
+using dvec3batch = dvecbatch<3>;
+using dvec4batch = dvecbatch<4>;
+
+} // namespace dang::math
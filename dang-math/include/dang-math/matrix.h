@@ -2,11 +2,17 @@
 
 #include "dang-math/bounds.h"
 #include "dang-math/global.h"
+#include "dang-math/simd.h"
 #include "dang-math/vector.h"
 
 namespace dang::math {
 
+template <typename T, std::size_t v_dim>
+struct LUDecomposition;
+
 /// @brief A generic, column-major matrix of any dimensions.
+/// @remark With DMATH_USE_SIMD, multiplication, transposition and inversion of 4x4 matrices use SIMD instructions,
+/// as long as they are not constant evaluated.
 template <typename T, std::size_t v_cols, std::size_t v_rows = v_cols>
 struct Matrix : std::array<Vector<T, v_rows>, v_cols> {
     using Base = std::array<Vector<T, v_rows>, v_cols>;
@@ -123,6 +129,10 @@ struct Matrix : std::array<Vector<T, v_rows>, v_cols> {
     /// @brief Returns the transposed matrix.
     constexpr auto transpose() const
     {
+        if constexpr (detail::SimdMatrixOps<T, cols, rows>::has_transpose) {
+            if (!detail::isConstantEvaluated())
+                return detail::SimdMatrixOps<T, cols, rows>::transpose(*this);
+        }
         Matrix<T, rows, cols> result;
         sbounds2 bounds{{cols, rows}};
         for (auto [x, y] : bounds)
@@ -204,52 +214,76 @@ struct Matrix : std::array<Vector<T, v_rows>, v_cols> {
     /// @brief Returns the inverse of the matrix.
     /// @remark
     /// Algorithms used:
-    /// - Dim &lt;= 4: Cramer's rule
-    /// - Dim > 4: Blockwise inversion (recursive)
+    /// - Dim &lt; 4: Cramer's rule
+    /// - Dim = 4: Cramer's rule, using shared 2x2 sub-determinants
+    /// - Dim > 4: LU-decomposition for floating point types, otherwise Cramer's rule
     constexpr std::optional<Matrix> inverse() const
     {
         static_assert(cols == rows);
 
         constexpr std::size_t Dim = cols;
-        constexpr std::size_t DimHalf1 = Dim / 2 + Dim % 2;
-        constexpr std::size_t DimHalf2 = Dim / 2;
 
-        if constexpr (Dim <= 4) {
+        if constexpr (Dim == 4) {
+            if constexpr (detail::SimdMatrixOps<T, 4, 4>::has_inverse) {
+                if (!detail::isConstantEvaluated())
+                    return detail::SimdMatrixOps<T, 4, 4>::inverse(*this);
+            }
+            return inverse4();
+        }
+        else if constexpr (Dim < 4 || !std::is_floating_point_v<T>) {
             T det = determinant();
             if (det == T{})
                 return std::nullopt;
             return adjugate() / det;
         }
         else {
-            auto a = subMatrix<0, 0, DimHalf1, DimHalf1>();
-            auto b = subMatrix<DimHalf1, 0, DimHalf2, DimHalf1>();
-            auto c = subMatrix<0, DimHalf1, DimHalf1, DimHalf2>();
-            auto d = subMatrix<DimHalf1, DimHalf1, DimHalf2, DimHalf2>();
-
-            auto a_inv = a.inverse();
-            if (!a_inv)
-                return std::nullopt;
+            return lu().inverse();
+        }
+    }
 
-            auto s_inv = (d - c * *a_inv * b).inverse();
-            if (!s_inv)
-                return std::nullopt;
+    /// @brief Returns the LU-decomposition of the matrix, which can be reused to solve multiple linear equations.
+    constexpr auto lu() const
+    {
+        static_assert(cols == rows);
+        return LUDecomposition<T, cols>(*this);
+    }
 
-            auto e = *a_inv + *a_inv * b * *s_inv * c * *a_inv;
-            auto f = -*a_inv * b * *s_inv;
-            auto g = -*s_inv * c * *a_inv;
-            auto h = *s_inv;
+    /// @brief Returns the inverse of an affine transformation matrix, which is a lot cheaper than a full inversion.
+    /// @remark The last row is assumed to be [0, 0, 0, 1] and is not read.
+    constexpr std::optional<Matrix> affineInverse() const
+    {
+        static_assert(cols == 4 && rows == 4);
 
-            Matrix result;
-            result.setSubMatrix<0, 0, DimHalf1, DimHalf1>(e);
-            result.setSubMatrix<DimHalf1, 0, DimHalf2, DimHalf1>(f);
-            result.setSubMatrix<0, DimHalf1, DimHalf1, DimHalf2>(g);
-            result.setSubMatrix<DimHalf1, DimHalf1, DimHalf2, DimHalf2>(h);
-            return result;
+        if constexpr (detail::SimdMatrixOps<T, 4, 4>::has_affine_inverse) {
+            if (!detail::isConstantEvaluated())
+                return detail::SimdMatrixOps<T, 4, 4>::affineInverse(*this);
         }
+
+        // The rows of the inverse are the cross-products of the columns, divided by the determinant.
+        Vector<T, 3> col0{(*this)(0, 0), (*this)(0, 1), (*this)(0, 2)};
+        Vector<T, 3> col1{(*this)(1, 0), (*this)(1, 1), (*this)(1, 2)};
+        Vector<T, 3> col2{(*this)(2, 0), (*this)(2, 1), (*this)(2, 2)};
+        Vector<T, 3> translation{(*this)(3, 0), (*this)(3, 1), (*this)(3, 2)};
+
+        auto row0 = col1.cross(col2);
+        T det = col0.dot(row0);
+        if (det == T{})
+            return std::nullopt;
+
+        row0 /= det;
+        auto row1 = col2.cross(col0) / det;
+        auto row2 = col0.cross(col1) / det;
+
+        Matrix result;
+        for (std::size_t col = 0; col < 3; col++)
+            result[col] = {row0[col], row1[col], row2[col], T{}};
+        result[3] = {-row0.dot(translation), -row1.dot(translation), -row2.dot(translation), T{1}};
+        return result;
     }
 
     /// @brief Returns the determinant of the matrix.
-    /// @remark Up to 3x3 is hard-coded, otherwise uses very costly recursion.
+    /// @remark Up to 3x3 is hard-coded. Bigger floating point matrices use LU-decomposition, otherwise uses very costly
+    /// recursion.
     constexpr auto determinant() const
     {
         constexpr std::size_t Dim = cols < rows ? cols : rows;
@@ -264,6 +298,9 @@ struct Matrix : std::array<Vector<T, v_rows>, v_cols> {
                    (*this)(0, 2) * (*this)(1, 0) * (*this)(2, 1) - (*this)(2, 0) * (*this)(1, 1) * (*this)(0, 2) -
                    (*this)(2, 1) * (*this)(1, 2) * (*this)(0, 0) - (*this)(2, 2) * (*this)(1, 0) * (*this)(0, 1);
         }
+        else if constexpr (Dim > 4 && cols == rows && std::is_floating_point_v<T>) {
+            return lu().determinant();
+        }
         else {
             T result{};
             if constexpr (Dim > 0) {
@@ -281,15 +318,15 @@ struct Matrix : std::array<Vector<T, v_rows>, v_cols> {
     /// @brief Solves a single column of the matrix, when seen as a linear equation.
     /// @remark
     /// Algorithms used:
-    /// - Unknowns >= 6: Inverse
-    /// - Unknowns &lt; 6: Column-swap and determinant. (Swaps performed in-place)
+    /// - Unknowns >= 6: LU-decomposition for floating point types
+    /// - Unknowns &lt; 6 or non floating point types: Column-swap and determinant. (Swaps performed in-place)
     constexpr std::optional<T> solveCol(std::size_t col)
     {
         static_assert(cols == rows + 1);
 
-        if constexpr (rows >= 6) {
-            if (auto inv = subMatrix<0, 0, rows, rows>().inverse())
-                return (*inv * (*this)[rows])[col];
+        if constexpr (rows >= 6 && std::is_floating_point_v<T>) {
+            if (auto result = subMatrix<0, 0, rows, rows>().lu().solve((*this)[rows]))
+                return (*result)[col];
             return std::nullopt;
         }
         else {
@@ -313,15 +350,15 @@ struct Matrix : std::array<Vector<T, v_rows>, v_cols> {
     /// @brief Solves a single column of the matrix, when seen as a linear equation.
     /// @remark
     /// Algorithms used:
-    /// - Unknowns >= 6: Inverse
-    /// - Unknowns &lt; 6: Column-swap and determinant. (Swaps not performed in-place)
+    /// - Unknowns >= 6: LU-decomposition for floating point types
+    /// - Unknowns &lt; 6 or non floating point types: Column-swap and determinant. (Swaps not performed in-place)
     constexpr std::optional<T> solveCol(std::size_t col) const
     {
         static_assert(cols == rows + 1);
 
-        if constexpr (rows >= 6) {
-            if (auto inv = subMatrix<0, 0, rows, rows>().inverse())
-                return (*inv * (*this)[rows])[col];
+        if constexpr (rows >= 6 && std::is_floating_point_v<T>) {
+            if (auto result = subMatrix<0, 0, rows, rows>().lu().solve((*this)[rows]))
+                return (*result)[col];
             return std::nullopt;
         }
         else {
@@ -339,15 +376,15 @@ struct Matrix : std::array<Vector<T, v_rows>, v_cols> {
     /// vector.
     /// @remark
     /// Algorithms used:
-    /// - Unknowns >= 6: Inverse
-    /// - Unknowns &lt; 6: Column-swap and determinant. (Swaps performed in-place)
+    /// - Unknowns >= 6: LU-decomposition for floating point types
+    /// - Unknowns &lt; 6 or non floating point types: Column-swap and determinant. (Swaps performed in-place)
     constexpr std::optional<T> solveCol(std::size_t col, Vector<T, cols> vector)
     {
         static_assert(cols == rows);
 
-        if constexpr (rows >= 6) {
-            if (auto inv = inverse())
-                return (*inv * vector)[col];
+        if constexpr (rows >= 6 && std::is_floating_point_v<T>) {
+            if (auto result = lu().solve(vector))
+                return (*result)[col];
             return std::nullopt;
         }
         else {
@@ -372,15 +409,15 @@ struct Matrix : std::array<Vector<T, v_rows>, v_cols> {
     /// vector.
     /// @remark
     /// Algorithms used:
-    /// - Unknowns >= 6: Inverse
-    /// - Unknowns &lt; 6: Column-swap and determinant. (Swaps not performed in-place)
+    /// - Unknowns >= 6: LU-decomposition for floating point types
+    /// - Unknowns &lt; 6 or non floating point types: Column-swap and determinant. (Swaps not performed in-place)
     constexpr std::optional<T> solveCol(std::size_t col, Vector<T, cols> vector) const
     {
         static_assert(cols == rows);
 
-        if constexpr (rows >= 6) {
-            if (auto inv = inverse())
-                return (*inv * vector)[col];
+        if constexpr (rows >= 6 && std::is_floating_point_v<T>) {
+            if (auto result = lu().solve(vector))
+                return (*result)[col];
             return std::nullopt;
         }
         else {
@@ -397,16 +434,14 @@ struct Matrix : std::array<Vector<T, v_rows>, v_cols> {
     /// @brief Solves the matrix, when seen as a linear equation.
     /// @remark
     /// Algorithms used:
-    /// - Unknowns >= 5: Inverse
-    /// - Unknowns &lt; 5: Column-swap and determinant. (Swaps performed in-place)
+    /// - Unknowns >= 5: LU-decomposition for floating point types
+    /// - Unknowns &lt; 5 or non floating point types: Column-swap and determinant. (Swaps performed in-place)
     constexpr std::optional<Vector<T, rows>> solve()
     {
         static_assert(cols == rows + 1);
 
-        if constexpr (rows >= 5) {
-            if (auto inv = subMatrix<0, 0, rows, rows>().inverse())
-                return *inv * (*this)[rows];
-            return std::nullopt;
+        if constexpr (rows >= 5 && std::is_floating_point_v<T>) {
+            return subMatrix<0, 0, rows, rows>().lu().solve((*this)[rows]);
         }
         else {
             T old_determinant = determinant();
@@ -433,16 +468,14 @@ struct Matrix : std::array<Vector<T, v_rows>, v_cols> {
     /// @brief Solves the matrix, when seen as a linear equation.
     /// @remark
     /// Algorithms used:
-    /// Unknowns >= 5: Inverse
-    /// Unknowns &lt; 5: Column-swap and determinant. (Swaps not performed in-place)
+    /// Unknowns >= 5: LU-decomposition for floating point types
+    /// Unknowns &lt; 5 or non floating point types: Column-swap and determinant. (Swaps not performed in-place)
     constexpr std::optional<Vector<T, rows>> solve() const
     {
         static_assert(cols == rows + 1);
 
-        if constexpr (rows >= 5) {
-            if (auto inv = subMatrix<0, 0, rows, rows>().inverse())
-                return *inv * (*this)[rows];
-            return std::nullopt;
+        if constexpr (rows >= 5 && std::is_floating_point_v<T>) {
+            return subMatrix<0, 0, rows, rows>().lu().solve((*this)[rows]);
         }
         else {
             T old_determinant = determinant();
@@ -470,16 +503,14 @@ struct Matrix : std::array<Vector<T, v_rows>, v_cols> {
     /// @brief Solves the matrix, when seen as a linear equation in combination with the given vector.
     /// @remark
     /// Algorithms used:
-    /// - Unknowns >= 5: Inverse
-    /// - Unknowns &lt; 5: Column-swap and determinant. (Swaps performed in-place)
+    /// - Unknowns >= 5: LU-decomposition for floating point types
+    /// - Unknowns &lt; 5 or non floating point types: Column-swap and determinant. (Swaps performed in-place)
     constexpr std::optional<Vector<T, cols>> solve(Vector<T, cols> vector)
     {
         static_assert(cols == rows);
 
-        if constexpr (rows >= 5) {
-            if (auto inv = inverse())
-                return *inv * vector;
-            return std::nullopt;
+        if constexpr (rows >= 5 && std::is_floating_point_v<T>) {
+            return lu().solve(vector);
         }
         else {
             T old_determinant = determinant();
@@ -506,16 +537,14 @@ struct Matrix : std::array<Vector<T, v_rows>, v_cols> {
     /// @brief Solves the matrix, when seen as a linear equation in combination with the given vector.
     /// @remark
     /// Algorithms used:
-    /// - Unknowns >= 5: Inverse
-    /// - Unknowns &lt; 5: Column-swap and determinant. (Swaps not performed in-place)
+    /// - Unknowns >= 5: LU-decomposition for floating point types
+    /// - Unknowns &lt; 5 or non floating point types: Column-swap and determinant. (Swaps not performed in-place)
     constexpr std::optional<Vector<T, cols>> solve(Vector<T, cols> vector) const
     {
         static_assert(cols == rows);
 
-        if constexpr (rows >= 5) {
-            if (auto inv = inverse())
-                return *inv * vector;
-            return std::nullopt;
+        if constexpr (rows >= 5 && std::is_floating_point_v<T>) {
+            return lu().solve(vector);
         }
         else {
             T old_determinant = determinant();
@@ -613,11 +642,15 @@ struct Matrix : std::array<Vector<T, v_rows>, v_cols> {
     template <std::size_t v_other_cols>
     friend constexpr auto operator*(const Matrix& lhs, const Matrix<T, v_other_cols, cols>& rhs)
     {
+        if constexpr (v_other_cols == cols && detail::SimdMatrixOps<T, cols, rows>::has_multiply) {
+            if (!detail::isConstantEvaluated())
+                return detail::SimdMatrixOps<T, cols, rows>::multiply(lhs, rhs);
+        }
         Matrix<T, v_other_cols, rows> result;
-        sbounds2 bounds{{v_other_cols, rows}};
-        for (const auto& pos : bounds)
+        for (std::size_t col = 0; col < v_other_cols; col++)
             for (std::size_t i = 0; i < cols; i++)
-                result[pos] += lhs(i, pos.y()) * rhs(pos.x(), i);
+                for (std::size_t row = 0; row < rows; row++)
+                    result(col, row) += lhs(i, row) * rhs(col, i);
         return result;
     }
 
@@ -687,6 +720,172 @@ struct Matrix : std::array<Vector<T, v_rows>, v_cols> {
         }
         return stream;
     }
+
+private:
+    /// @brief Inverts a 4x4 matrix using Cramer's rule, sharing the 2x2 sub-determinants of the upper and lower half.
+    constexpr std::optional<Matrix> inverse4() const
+    {
+        const auto& m = *this;
+
+        T s0 = m(0, 0) * m(1, 1) - m(1, 0) * m(0, 1);
+        T s1 = m(0, 0) * m(1, 2) - m(1, 0) * m(0, 2);
+        T s2 = m(0, 0) * m(1, 3) - m(1, 0) * m(0, 3);
+        T s3 = m(0, 1) * m(1, 2) - m(1, 1) * m(0, 2);
+        T s4 = m(0, 1) * m(1, 3) - m(1, 1) * m(0, 3);
+        T s5 = m(0, 2) * m(1, 3) - m(1, 2) * m(0, 3);
+
+        T c5 = m(2, 2) * m(3, 3) - m(3, 2) * m(2, 3);
+        T c4 = m(2, 1) * m(3, 3) - m(3, 1) * m(2, 3);
+        T c3 = m(2, 1) * m(3, 2) - m(3, 1) * m(2, 2);
+        T c2 = m(2, 0) * m(3, 3) - m(3, 0) * m(2, 3);
+        T c1 = m(2, 0) * m(3, 2) - m(3, 0) * m(2, 2);
+        T c0 = m(2, 0) * m(3, 1) - m(3, 0) * m(2, 1);
+
+        T det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+        if (det == T{})
+            return std::nullopt;
+
+        Matrix result;
+        result(0, 0) = m(1, 1) * c5 - m(1, 2) * c4 + m(1, 3) * c3;
+        result(0, 1) = -m(0, 1) * c5 + m(0, 2) * c4 - m(0, 3) * c3;
+        result(0, 2) = m(3, 1) * s5 - m(3, 2) * s4 + m(3, 3) * s3;
+        result(0, 3) = -m(2, 1) * s5 + m(2, 2) * s4 - m(2, 3) * s3;
+        result(1, 0) = -m(1, 0) * c5 + m(1, 2) * c2 - m(1, 3) * c1;
+        result(1, 1) = m(0, 0) * c5 - m(0, 2) * c2 + m(0, 3) * c1;
+        result(1, 2) = -m(3, 0) * s5 + m(3, 2) * s2 - m(3, 3) * s1;
+        result(1, 3) = m(2, 0) * s5 - m(2, 2) * s2 + m(2, 3) * s1;
+        result(2, 0) = m(1, 0) * c4 - m(1, 1) * c2 + m(1, 3) * c0;
+        result(2, 1) = -m(0, 0) * c4 + m(0, 1) * c2 - m(0, 3) * c0;
+        result(2, 2) = m(3, 0) * s4 - m(3, 1) * s2 + m(3, 3) * s0;
+        result(2, 3) = -m(2, 0) * s4 + m(2, 1) * s2 - m(2, 3) * s0;
+        result(3, 0) = -m(1, 0) * c3 + m(1, 1) * c1 - m(1, 2) * c0;
+        result(3, 1) = m(0, 0) * c3 - m(0, 1) * c1 + m(0, 2) * c0;
+        result(3, 2) = -m(3, 0) * s3 + m(3, 1) * s1 - m(3, 2) * s0;
+        result(3, 3) = m(2, 0) * s3 - m(2, 1) * s1 + m(2, 2) * s0;
+        return result / det;
+    }
+};
+
+/// @brief The LU-decomposition of a square matrix using partial pivoting.
+/// @remark Decomposing is O(n³), after which each solve is only O(n²), so it should be reused for multiple linear
+/// equations with the same matrix.
+/// @remark Only supports floating point types, as integer division would silently truncate the factors.
+template <typename T, std::size_t v_dim>
+struct LUDecomposition {
+    static_assert(std::is_floating_point_v<T>, "LU-decomposition requires a floating point type.");
+
+    static constexpr auto dim = v_dim;
+
+    /// @brief Decomposes the given matrix into a lower and upper triangular matrix and a row permutation.
+    explicit constexpr LUDecomposition(const Matrix<T, v_dim>& matrix)
+        : lu_(matrix)
+    {
+        for (std::size_t k = 0; k < dim; k++) {
+            std::size_t pivot = k;
+            T pivot_magnitude = abs(lu_(k, k));
+            for (std::size_t row = k + 1; row < dim; row++) {
+                T magnitude = abs(lu_(k, row));
+                if (magnitude > pivot_magnitude) {
+                    pivot = row;
+                    pivot_magnitude = magnitude;
+                }
+            }
+
+            pivots_[k] = pivot;
+            if (pivot != k) {
+                for (std::size_t col = 0; col < dim; col++) {
+                    T tmp = lu_(col, k);
+                    lu_(col, k) = lu_(col, pivot);
+                    lu_(col, pivot) = tmp;
+                }
+                odd_permutation_ = !odd_permutation_;
+            }
+
+            T diagonal = lu_(k, k);
+            if (diagonal == T{}) {
+                singular_ = true;
+                continue;
+            }
+
+            for (std::size_t row = k + 1; row < dim; row++)
+                lu_(k, row) /= diagonal;
+            for (std::size_t col = k + 1; col < dim; col++) {
+                T factor = lu_(col, k);
+                for (std::size_t row = k + 1; row < dim; row++)
+                    lu_(col, row) -= lu_(k, row) * factor;
+            }
+        }
+    }
+
+    /// @brief Whether the decomposed matrix is singular and can therefore neither be solved nor inverted.
+    constexpr bool singular() const { return singular_; }
+
+    /// @brief Returns the combined lower (without its unit diagonal) and upper triangular matrix.
+    constexpr const auto& combined() const { return lu_; }
+
+    /// @brief Returns the row, that was swapped with the row of the same index during decomposition.
+    constexpr const auto& pivots() const { return pivots_; }
+
+    /// @brief Returns the determinant of the decomposed matrix.
+    constexpr T determinant() const
+    {
+        if (singular_)
+            return T{};
+        T result = odd_permutation_ ? T{-1} : T{1};
+        for (std::size_t i = 0; i < dim; i++)
+            result *= lu_(i, i);
+        return result;
+    }
+
+    /// @brief Solves the linear equation with the given vector or returns std::nullopt, if the matrix is singular.
+    constexpr std::optional<Vector<T, v_dim>> solve(Vector<T, v_dim> vector) const
+    {
+        if (singular_)
+            return std::nullopt;
+
+        for (std::size_t k = 0; k < dim; k++) {
+            if (pivots_[k] != k) {
+                T tmp = vector[k];
+                vector[k] = vector[pivots_[k]];
+                vector[pivots_[k]] = tmp;
+            }
+        }
+
+        for (std::size_t k = 0; k < dim; k++)
+            for (std::size_t row = k + 1; row < dim; row++)
+                vector[row] -= lu_(k, row) * vector[k];
+
+        for (std::size_t k = dim; k-- > 0;) {
+            vector[k] /= lu_(k, k);
+            for (std::size_t row = 0; row < k; row++)
+                vector[row] -= lu_(k, row) * vector[k];
+        }
+
+        return vector;
+    }
+
+    /// @brief Returns the inverse of the decomposed matrix or std::nullopt, if the matrix is singular.
+    constexpr std::optional<Matrix<T, v_dim>> inverse() const
+    {
+        if (singular_)
+            return std::nullopt;
+
+        Matrix<T, v_dim> result;
+        for (std::size_t col = 0; col < dim; col++) {
+            Vector<T, v_dim> unit;
+            unit[col] = T{1};
+            result[col] = *solve(unit);
+        }
+        return result;
+    }
+
+private:
+    static constexpr T abs(T value) { return value < T{} ? -value : value; }
+
+    Matrix<T, v_dim> lu_;
+    std::array<std::size_t, v_dim> pivots_{};
+    bool odd_permutation_ = false;
+    bool singular_ = false;
 };
 
 template <std::size_t v_cols, std::size_t v_rows = v_cols>
@@ -0,0 +1,436 @@
+#pragma once
+
+#include "dang-math/global.h"
+
+#include <optional>
+
+// SIMD support is opt-in using DMATH_USE_SIMD and additionally requires the target to support the instruction set.
+// The scalar implementation is always used during constant evaluation, which requires a compiler builtin.
+
+#if defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#define DMATH_HAS_IS_CONSTANT_EVALUATED
+#endif
+
+#if defined(DMATH_USE_SIMD) && defined(DMATH_HAS_IS_CONSTANT_EVALUATED)
+#if defined(__SSE3__) || defined(__AVX__)
+#define DMATH_SIMD_SSE
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define DMATH_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+namespace dang::math {
+
+namespace detail {
+
+/// @brief Returns true, if the call happens during constant evaluation.
+/// @remark Always returns true, if the compiler cannot tell the difference, which disables all SIMD paths.
+// TODO: C++20 replace with std::is_constant_evaluated
+constexpr bool isConstantEvaluated() noexcept
+{
+#ifdef DMATH_HAS_IS_CONSTANT_EVALUATED
+    return __builtin_is_constant_evaluated();
+#else
+    return true;
+#endif
+}
+
+/// @brief Returns the smaller of both values, using the same semantics as std::min.
+struct Min {
+    template <typename T>
+    constexpr T operator()(T lhs, T rhs) const
+    {
+        return std::min(lhs, rhs);
+    }
+};
+
+/// @brief Returns the larger of both values, using the same semantics as std::max.
+struct Max {
+    template <typename T>
+    constexpr T operator()(T lhs, T rhs) const
+    {
+        return std::max(lhs, rhs);
+    }
+};
+
+/// @brief Provides SIMD operations for vectors of the given type and dimension.
+/// @remark Only specialized for combinations that are supported by the target instruction set and actually outperform
+/// the scalar implementation, which compilers tend to auto-vectorize well already.
+/// @remark Three-component vectors are not specialized, as the partial loads and stores cost more than they gain.
+/// @remark Integer vectors are not specialized, as the scalar implementation is vectorized by the compiler already.
+/// @remark Specializations set the respective flags for each group of operations they provide.
+template <typename T, std::size_t v_dim>
+struct SimdOps {
+    static constexpr bool has_arithmetic = false;
+    static constexpr bool has_min_max = false;
+    static constexpr bool has_dot = false;
+};
+
+#if defined(DMATH_SIMD_SSE)
+
+template <>
+struct SimdOps<float, 4> {
+    static constexpr bool has_arithmetic = true;
+    static constexpr bool has_min_max = true;
+    static constexpr bool has_dot = true;
+
+    using Register = __m128;
+
+    static Register load(const float* values) { return _mm_loadu_ps(values); }
+    static void store(float* values, Register value) { _mm_storeu_ps(values, value); }
+
+    static Register apply(std::plus<>, Register lhs, Register rhs) { return _mm_add_ps(lhs, rhs); }
+    static Register apply(std::minus<>, Register lhs, Register rhs) { return _mm_sub_ps(lhs, rhs); }
+    static Register apply(std::multiplies<>, Register lhs, Register rhs) { return _mm_mul_ps(lhs, rhs); }
+    static Register apply(std::divides<>, Register lhs, Register rhs) { return _mm_div_ps(lhs, rhs); }
+    // Operands are swapped to match the NaN and signed zero semantics of std::min and std::max.
+    static Register apply(Min, Register lhs, Register rhs) { return _mm_min_ps(rhs, lhs); }
+    static Register apply(Max, Register lhs, Register rhs) { return _mm_max_ps(rhs, lhs); }
+
+    static float dot(Register lhs, Register rhs)
+    {
+        auto product = _mm_mul_ps(lhs, rhs);
+        auto sum = _mm_add_ps(product, _mm_movehdup_ps(product));
+        return _mm_cvtss_f32(_mm_add_ss(sum, _mm_movehl_ps(sum, sum)));
+    }
+};
+
+
+#elif defined(DMATH_SIMD_NEON)
+
+template <>
+struct SimdOps<float, 4> {
+    static constexpr bool has_arithmetic = true;
+    static constexpr bool has_min_max = true;
+    static constexpr bool has_dot = true;
+
+    using Register = float32x4_t;
+
+    static Register load(const float* values) { return vld1q_f32(values); }
+    static void store(float* values, Register value) { vst1q_f32(values, value); }
+
+    static Register apply(std::plus<>, Register lhs, Register rhs) { return vaddq_f32(lhs, rhs); }
+    static Register apply(std::minus<>, Register lhs, Register rhs) { return vsubq_f32(lhs, rhs); }
+    static Register apply(std::multiplies<>, Register lhs, Register rhs) { return vmulq_f32(lhs, rhs); }
+    static Register apply(std::divides<>, Register lhs, Register rhs) { return vdivq_f32(lhs, rhs); }
+    // vminq and vmaxq propagate NaN, so the comparison of std::min and std::max is replicated instead.
+    static Register apply(Min, Register lhs, Register rhs) { return vbslq_f32(vcltq_f32(rhs, lhs), rhs, lhs); }
+    static Register apply(Max, Register lhs, Register rhs) { return vbslq_f32(vcltq_f32(lhs, rhs), rhs, lhs); }
+
+    static float dot(Register lhs, Register rhs) { return vaddvq_f32(vmulq_f32(lhs, rhs)); }
+};
+
+
+#endif
+
+/// @brief Provides SIMD operations for matrices of the given type and dimensions.
+/// @remark Specializations set the respective flags for each operation they provide.
+template <typename T, std::size_t v_cols, std::size_t v_rows>
+struct SimdMatrixOps {
+    static constexpr bool has_multiply = false;
+    static constexpr bool has_transpose = false;
+    static constexpr bool has_inverse = false;
+    static constexpr bool has_affine_inverse = false;
+};
+
+#if defined(DMATH_SIMD_SSE)
+
+template <>
+struct SimdMatrixOps<float, 4, 4> {
+    static constexpr bool has_multiply = true;
+    static constexpr bool has_transpose = true;
+    static constexpr bool has_inverse = true;
+    static constexpr bool has_affine_inverse = true;
+
+    using Register = __m128;
+
+    template <int v_x, int v_y, int v_z, int v_w>
+    static Register shuffle(Register lhs, Register rhs)
+    {
+        return _mm_shuffle_ps(lhs, rhs, _MM_SHUFFLE(v_w, v_z, v_y, v_x));
+    }
+
+    template <int v_x, int v_y, int v_z, int v_w>
+    static Register swizzle(Register value)
+    {
+        return shuffle<v_x, v_y, v_z, v_w>(value, value);
+    }
+
+    template <typename TMatrix>
+    static TMatrix multiply(const TMatrix& lhs, const TMatrix& rhs)
+    {
+        Register col0 = _mm_loadu_ps(lhs[0].data());
+        Register col1 = _mm_loadu_ps(lhs[1].data());
+        Register col2 = _mm_loadu_ps(lhs[2].data());
+        Register col3 = _mm_loadu_ps(lhs[3].data());
+        TMatrix result;
+        for (std::size_t col = 0; col < 4; col++) {
+            const float* factors = rhs[col].data();
+            Register sum = _mm_mul_ps(col0, _mm_set1_ps(factors[0]));
+            sum = _mm_add_ps(sum, _mm_mul_ps(col1, _mm_set1_ps(factors[1])));
+            sum = _mm_add_ps(sum, _mm_mul_ps(col2, _mm_set1_ps(factors[2])));
+            sum = _mm_add_ps(sum, _mm_mul_ps(col3, _mm_set1_ps(factors[3])));
+            _mm_storeu_ps(result[col].data(), sum);
+        }
+        return result;
+    }
+
+    template <typename TMatrix>
+    static TMatrix transpose(const TMatrix& matrix)
+    {
+        Register col0 = _mm_loadu_ps(matrix[0].data());
+        Register col1 = _mm_loadu_ps(matrix[1].data());
+        Register col2 = _mm_loadu_ps(matrix[2].data());
+        Register col3 = _mm_loadu_ps(matrix[3].data());
+        _MM_TRANSPOSE4_PS(col0, col1, col2, col3);
+        TMatrix result;
+        _mm_storeu_ps(result[0].data(), col0);
+        _mm_storeu_ps(result[1].data(), col1);
+        _mm_storeu_ps(result[2].data(), col2);
+        _mm_storeu_ps(result[3].data(), col3);
+        return result;
+    }
+
+    /// @brief Inverts the matrix blockwise using 2x2 sub-matrices, which are stored in a single register each.
+    /// @remark Based on: https://lxjk.github.io/2017/09/03/Fast-4x4-Matrix-Inverse-with-SSE-SIMD-Explained.html
+    template <typename TMatrix>
+    static std::optional<TMatrix> inverse(const TMatrix& matrix)
+    {
+        Register col0 = _mm_loadu_ps(matrix[0].data());
+        Register col1 = _mm_loadu_ps(matrix[1].data());
+        Register col2 = _mm_loadu_ps(matrix[2].data());
+        Register col3 = _mm_loadu_ps(matrix[3].data());
+
+        Register a = _mm_movelh_ps(col0, col1);
+        Register b = _mm_movehl_ps(col1, col0);
+        Register c = _mm_movelh_ps(col2, col3);
+        Register d = _mm_movehl_ps(col3, col2);
+
+        // Determinants of a, b, c and d.
+        Register det_sub = _mm_sub_ps(
+            _mm_mul_ps(shuffle<0, 2, 0, 2>(col0, col2), shuffle<1, 3, 1, 3>(col1, col3)),
+            _mm_mul_ps(shuffle<1, 3, 1, 3>(col0, col2), shuffle<0, 2, 0, 2>(col1, col3)));
+        Register det_a = swizzle<0, 0, 0, 0>(det_sub);
+        Register det_b = swizzle<1, 1, 1, 1>(det_sub);
+        Register det_c = swizzle<2, 2, 2, 2>(det_sub);
+        Register det_d = swizzle<3, 3, 3, 3>(det_sub);
+
+        Register d_c = adjugateMultiply(d, c);
+        Register a_b = adjugateMultiply(a, b);
+        Register x = _mm_sub_ps(_mm_mul_ps(det_d, a), multiply2(b, d_c));
+        Register w = _mm_sub_ps(_mm_mul_ps(det_a, d), multiply2(c, a_b));
+        Register y = _mm_sub_ps(_mm_mul_ps(det_b, c), multiplyAdjugate(d, a_b));
+        Register z = _mm_sub_ps(_mm_mul_ps(det_c, b), multiplyAdjugate(a, d_c));
+
+        Register trace = _mm_mul_ps(a_b, swizzle<0, 2, 1, 3>(d_c));
+        trace = _mm_hadd_ps(trace, trace);
+        trace = _mm_hadd_ps(trace, trace);
+
+        Register det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(det_a, det_d), _mm_mul_ps(det_b, det_c)), trace);
+        if (_mm_cvtss_f32(det) == 0.0f)
+            return std::nullopt;
+
+        Register inv_det = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+        x = _mm_mul_ps(x, inv_det);
+        y = _mm_mul_ps(y, inv_det);
+        z = _mm_mul_ps(z, inv_det);
+        w = _mm_mul_ps(w, inv_det);
+
+        TMatrix result;
+        _mm_storeu_ps(result[0].data(), shuffle<3, 1, 3, 1>(x, y));
+        _mm_storeu_ps(result[1].data(), shuffle<2, 0, 2, 0>(x, y));
+        _mm_storeu_ps(result[2].data(), shuffle<3, 1, 3, 1>(z, w));
+        _mm_storeu_ps(result[3].data(), shuffle<2, 0, 2, 0>(z, w));
+        return result;
+    }
+
+    /// @brief Inverts a matrix, which only consists of a linear transformation and a translation.
+    /// @remark The last row is assumed to be [0, 0, 0, 1].
+    template <typename TMatrix>
+    static std::optional<TMatrix> affineInverse(const TMatrix& matrix)
+    {
+        Register col0 = _mm_loadu_ps(matrix[0].data());
+        Register col1 = _mm_loadu_ps(matrix[1].data());
+        Register col2 = _mm_loadu_ps(matrix[2].data());
+        Register col3 = _mm_loadu_ps(matrix[3].data());
+
+        // The rows of the inverse are the cross-products of the columns, divided by the determinant.
+        Register row0 = cross(col1, col2);
+        Register row1 = cross(col2, col0);
+        Register row2 = cross(col0, col1);
+
+        Register det = _mm_mul_ps(col0, row0);
+        det = _mm_add_ps(det, _mm_movehdup_ps(det));
+        det = _mm_add_ss(det, _mm_movehl_ps(det, det));
+        if (_mm_cvtss_f32(det) == 0.0f)
+            return std::nullopt;
+
+        Register inv_det = _mm_div_ps(_mm_set1_ps(1.0f), swizzle<0, 0, 0, 0>(det));
+        row0 = _mm_mul_ps(row0, inv_det);
+        row1 = _mm_mul_ps(row1, inv_det);
+        row2 = _mm_mul_ps(row2, inv_det);
+        Register row3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+        Register translation = _mm_mul_ps(row0, swizzle<0, 0, 0, 0>(col3));
+        translation = _mm_add_ps(translation, _mm_mul_ps(row1, swizzle<1, 1, 1, 1>(col3)));
+        translation = _mm_add_ps(translation, _mm_mul_ps(row2, swizzle<2, 2, 2, 2>(col3)));
+        translation = _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f), translation);
+
+        TMatrix result;
+        _mm_storeu_ps(result[0].data(), row0);
+        _mm_storeu_ps(result[1].data(), row1);
+        _mm_storeu_ps(result[2].data(), row2);
+        _mm_storeu_ps(result[3].data(), translation);
+        return result;
+    }
+
+private:
+    /// @brief Multiplies two 2x2 matrices.
+    static Register multiply2(Register lhs, Register rhs)
+    {
+        return _mm_add_ps(_mm_mul_ps(lhs, swizzle<0, 3, 0, 3>(rhs)),
+                          _mm_mul_ps(swizzle<1, 0, 3, 2>(lhs), swizzle<2, 1, 2, 1>(rhs)));
+    }
+
+    /// @brief Multiplies the adjugate of the first 2x2 matrix with the second.
+    static Register adjugateMultiply(Register lhs, Register rhs)
+    {
+        return _mm_sub_ps(_mm_mul_ps(swizzle<3, 3, 0, 0>(lhs), rhs),
+                          _mm_mul_ps(swizzle<1, 1, 2, 2>(lhs), swizzle<2, 3, 0, 1>(rhs)));
+    }
+
+    /// @brief Multiplies the first 2x2 matrix with the adjugate of the second.
+    static Register multiplyAdjugate(Register lhs, Register rhs)
+    {
+        return _mm_sub_ps(_mm_mul_ps(lhs, swizzle<3, 0, 3, 0>(rhs)),
+                          _mm_mul_ps(swizzle<1, 0, 3, 2>(lhs), swizzle<2, 1, 2, 1>(rhs)));
+    }
+
+    /// @brief Calculates the cross-product of the xyz-components, which leaves a w-component of zero.
+    static Register cross(Register lhs, Register rhs)
+    {
+        return _mm_sub_ps(_mm_mul_ps(swizzle<1, 2, 0, 3>(lhs), swizzle<2, 0, 1, 3>(rhs)),
+                          _mm_mul_ps(swizzle<2, 0, 1, 3>(lhs), swizzle<1, 2, 0, 3>(rhs)));
+    }
+};
+
+#if defined(__AVX__)
+
+template <>
+struct SimdMatrixOps<double, 4, 4> {
+    static constexpr bool has_multiply = true;
+    static constexpr bool has_transpose = true;
+    static constexpr bool has_inverse = false;
+    static constexpr bool has_affine_inverse = false;
+
+    using Register = __m256d;
+
+    template <typename TMatrix>
+    static TMatrix multiply(const TMatrix& lhs, const TMatrix& rhs)
+    {
+        Register col0 = _mm256_loadu_pd(lhs[0].data());
+        Register col1 = _mm256_loadu_pd(lhs[1].data());
+        Register col2 = _mm256_loadu_pd(lhs[2].data());
+        Register col3 = _mm256_loadu_pd(lhs[3].data());
+        TMatrix result;
+        for (std::size_t col = 0; col < 4; col++) {
+            const double* factors = rhs[col].data();
+            Register sum = _mm256_mul_pd(col0, _mm256_set1_pd(factors[0]));
+            sum = _mm256_add_pd(sum, _mm256_mul_pd(col1, _mm256_set1_pd(factors[1])));
+            sum = _mm256_add_pd(sum, _mm256_mul_pd(col2, _mm256_set1_pd(factors[2])));
+            sum = _mm256_add_pd(sum, _mm256_mul_pd(col3, _mm256_set1_pd(factors[3])));
+            _mm256_storeu_pd(result[col].data(), sum);
+        }
+        return result;
+    }
+
+    template <typename TMatrix>
+    static TMatrix transpose(const TMatrix& matrix)
+    {
+        Register col0 = _mm256_loadu_pd(matrix[0].data());
+        Register col1 = _mm256_loadu_pd(matrix[1].data());
+        Register col2 = _mm256_loadu_pd(matrix[2].data());
+        Register col3 = _mm256_loadu_pd(matrix[3].data());
+        Register low01 = _mm256_unpacklo_pd(col0, col1);
+        Register high01 = _mm256_unpackhi_pd(col0, col1);
+        Register low23 = _mm256_unpacklo_pd(col2, col3);
+        Register high23 = _mm256_unpackhi_pd(col2, col3);
+        TMatrix result;
+        _mm256_storeu_pd(result[0].data(), _mm256_permute2f128_pd(low01, low23, 0x20));
+        _mm256_storeu_pd(result[1].data(), _mm256_permute2f128_pd(high01, high23, 0x20));
+        _mm256_storeu_pd(result[2].data(), _mm256_permute2f128_pd(low01, low23, 0x31));
+        _mm256_storeu_pd(result[3].data(), _mm256_permute2f128_pd(high01, high23, 0x31));
+        return result;
+    }
+};
+
+#endif
+
+#elif defined(DMATH_SIMD_NEON)
+
+template <>
+struct SimdMatrixOps<float, 4, 4> {
+    static constexpr bool has_multiply = true;
+    static constexpr bool has_transpose = true;
+    static constexpr bool has_inverse = false;
+    static constexpr bool has_affine_inverse = false;
+
+    using Register = float32x4_t;
+
+    template <typename TMatrix>
+    static TMatrix multiply(const TMatrix& lhs, const TMatrix& rhs)
+    {
+        Register col0 = vld1q_f32(lhs[0].data());
+        Register col1 = vld1q_f32(lhs[1].data());
+        Register col2 = vld1q_f32(lhs[2].data());
+        Register col3 = vld1q_f32(lhs[3].data());
+        TMatrix result;
+        for (std::size_t col = 0; col < 4; col++) {
+            Register factors = vld1q_f32(rhs[col].data());
+            Register sum = vmulq_laneq_f32(col0, factors, 0);
+            sum = vfmaq_laneq_f32(sum, col1, factors, 1);
+            sum = vfmaq_laneq_f32(sum, col2, factors, 2);
+            sum = vfmaq_laneq_f32(sum, col3, factors, 3);
+            vst1q_f32(result[col].data(), sum);
+        }
+        return result;
+    }
+
+    template <typename TMatrix>
+    static TMatrix transpose(const TMatrix& matrix)
+    {
+        float32x4x2_t even = vtrnq_f32(vld1q_f32(matrix[0].data()), vld1q_f32(matrix[1].data()));
+        float32x4x2_t odd = vtrnq_f32(vld1q_f32(matrix[2].data()), vld1q_f32(matrix[3].data()));
+        TMatrix result;
+        vst1q_f32(result[0].data(), vcombine_f32(vget_low_f32(even.val[0]), vget_low_f32(odd.val[0])));
+        vst1q_f32(result[1].data(), vcombine_f32(vget_low_f32(even.val[1]), vget_low_f32(odd.val[1])));
+        vst1q_f32(result[2].data(), vcombine_f32(vget_high_f32(even.val[0]), vget_high_f32(odd.val[0])));
+        vst1q_f32(result[3].data(), vcombine_f32(vget_high_f32(even.val[1]), vget_high_f32(odd.val[1])));
+        return result;
+    }
+};
+
+#endif
+
+// The flags are checked instead of detecting the functions, which would pass the register type as a template argument
+// and trigger warnings about its ignored alignment attributes.
+
+/// @brief Whether the given component-wise operation has a SIMD implementation for vectors of the given type and
+/// dimension.
+template <typename T, std::size_t v_dim, typename TOperation>
+inline constexpr bool has_simd_op_v =
+    (SimdOps<T, v_dim>::has_arithmetic &&
+     (std::is_same_v<TOperation, std::plus<>> || std::is_same_v<TOperation, std::minus<>> ||
+      std::is_same_v<TOperation, std::multiplies<>> || std::is_same_v<TOperation, std::divides<>>)) ||
+    (SimdOps<T, v_dim>::has_min_max && (std::is_same_v<TOperation, Min> || std::is_same_v<TOperation, Max>));
+
+/// @brief Whether the dot-product has a SIMD implementation for vectors of the given type and dimension.
+template <typename T, std::size_t v_dim>
+inline constexpr bool has_simd_dot_v = SimdOps<T, v_dim>::has_dot;
+
+} // namespace detail
+
+} // namespace dang::math
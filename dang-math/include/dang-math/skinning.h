@@ -0,0 +1,305 @@
+#pragma once
+
+#include "dang-math/batch.h"
+#include "dang-math/global.h"
+#include "dang-math/quaternion.h"
+#include "dang-math/simd.h"
+#include "dang-math/vector.h"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace dang::math {
+
+/// @brief The vertex data of a mesh, which is influenced by up to four bones per vertex.
+/// @remark Normals are optional and skipped, if the span is empty. Unused influences should have a weight of zero, but
+/// must still use a valid bone index.
+template <typename TIndex = std::uint8_t>
+struct SkinningInput {
+    StridedSpan<const vec3> positions;
+    StridedSpan<const vec3> normals;
+    StridedSpan<const Vector<TIndex, 4>> bone_indices;
+    StridedSpan<const vec4> bone_weights;
+};
+
+/// @brief The destination of skinned positions and normals, which can point into interleaved (mapped) vertex data.
+/// @remark Normals are only written, if both the input and output span for normals is not empty.
+struct SkinningOutput {
+    StridedSpan<vec3> positions;
+    StridedSpan<vec3> normals;
+};
+
+namespace skinning {
+
+/// @brief The minimum number of vertices for which an additional thread is used.
+inline constexpr std::size_t min_vertices_per_thread = 8192;
+
+namespace detail {
+
+/// @brief Blends up to four dual-quaternions and transforms a single vertex with the normalized result.
+template <typename TIndex>
+inline void dualQuaternionVertex(const SkinningInput<TIndex>& input,
+                                 const dquat* palette,
+                                 const SkinningOutput& output,
+                                 bool skin_normals,
+                                 std::size_t index)
+{
+    const auto& indices = input.bone_indices[index];
+    const auto& weights = input.bone_weights[index];
+
+#if defined(DMATH_SIMD_SSE)
+    using Ops = dang::math::detail::SimdOps<float, 4>;
+
+    auto first_real = Ops::load(palette[indices[0]].real.asVector().data());
+    auto real = _mm_mul_ps(first_real, _mm_set1_ps(weights[0]));
+    auto dual = _mm_mul_ps(Ops::load(palette[indices[0]].dual.asVector().data()), _mm_set1_ps(weights[0]));
+    for (std::size_t i = 1; i < 4; i++) {
+        if (weights[i] == 0.0f)
+            continue;
+        // Blend along the shortest path, as q and -q represent the same transformation.
+        auto bone_real = Ops::load(palette[indices[i]].real.asVector().data());
+        auto bone_dual = Ops::load(palette[indices[i]].dual.asVector().data());
+        auto weight = _mm_set1_ps(Ops::dot(first_real, bone_real) < 0.0f ? -weights[i] : weights[i]);
+        real = _mm_add_ps(real, _mm_mul_ps(bone_real, weight));
+        dual = _mm_add_ps(dual, _mm_mul_ps(bone_dual, weight));
+    }
+
+    auto inv_length = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(_mm_set1_ps(Ops::dot(real, real))));
+    real = _mm_mul_ps(real, inv_length);
+    dual = _mm_mul_ps(dual, inv_length);
+
+    auto cross = [](__m128 lhs, __m128 rhs) {
+        auto lhs_yzx = _mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(3, 0, 2, 1));
+        auto rhs_yzx = _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(3, 0, 2, 1));
+        auto result = _mm_sub_ps(_mm_mul_ps(lhs, rhs_yzx), _mm_mul_ps(lhs_yzx, rhs));
+        return _mm_shuffle_ps(result, result, _MM_SHUFFLE(3, 0, 2, 1));
+    };
+    auto real_w = _mm_shuffle_ps(real, real, _MM_SHUFFLE(3, 3, 3, 3));
+    auto two = _mm_set1_ps(2.0f);
+
+    // v' = v + 2 * (w * (u x v) + u x (u x v))
+    auto rotate = [&](__m128 vector) {
+        auto uv = cross(real, vector);
+        return _mm_add_ps(vector, _mm_mul_ps(two, _mm_add_ps(_mm_mul_ps(real_w, uv), cross(real, uv))));
+    };
+    auto store = [](vec3& target, __m128 value) {
+        alignas(16) float values[4];
+        _mm_store_ps(values, value);
+        target = {values[0], values[1], values[2]};
+    };
+
+    // t = 2 * (real.w * dual.xyz - dual.w * real.xyz + real.xyz x dual.xyz)
+    auto dual_w = _mm_shuffle_ps(dual, dual, _MM_SHUFFLE(3, 3, 3, 3));
+    auto translation = _mm_mul_ps(
+        two, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(real_w, dual), _mm_mul_ps(dual_w, real)), cross(real, dual)));
+
+    const auto& position = input.positions[index];
+    store(output.positions[index],
+          _mm_add_ps(rotate(_mm_setr_ps(position.x(), position.y(), position.z(), 0.0f)), translation));
+
+    if (skin_normals) {
+        const auto& normal = input.normals[index];
+        store(output.normals[index], rotate(_mm_setr_ps(normal.x(), normal.y(), normal.z(), 0.0f)));
+    }
+#else
+    const auto& first_real = palette[indices[0]].real.asVector();
+    auto real = first_real * weights[0];
+    auto dual = palette[indices[0]].dual.asVector() * weights[0];
+    for (std::size_t i = 1; i < 4; i++) {
+        if (weights[i] == 0.0f)
+            continue;
+        // Blend along the shortest path, as q and -q represent the same transformation.
+        const auto& bone_real = palette[indices[i]].real.asVector();
+        float weight = first_real.dot(bone_real) < 0.0f ? -weights[i] : weights[i];
+        real += bone_real * weight;
+        dual += palette[indices[i]].dual.asVector() * weight;
+    }
+
+    float inv_length = 1.0f / real.length();
+    real *= inv_length;
+    dual *= inv_length;
+
+    auto u = real.xyz();
+    auto rotate = [&](const vec3& vector) {
+        auto uv = u.cross(vector);
+        return vector + 2.0f * (real.w() * uv + u.cross(uv));
+    };
+    auto translation = 2.0f * (real.w() * dual.xyz() - dual.w() * u + u.cross(dual.xyz()));
+
+    output.positions[index] = rotate(input.positions[index]) + translation;
+    if (skin_normals)
+        output.normals[index] = rotate(input.normals[index]);
+#endif
+}
+
+#if defined(DMATH_SIMD_SSE)
+
+/// @brief Skins four consecutive vertices at once, with one register per component, holding all four vertices.
+template <typename TIndex>
+inline void dualQuaternionQuad(const SkinningInput<TIndex>& input,
+                               const dquat* palette,
+                               const SkinningOutput& output,
+                               bool skin_normals,
+                               std::size_t index)
+{
+    __m128 first[4];
+    __m128 real[4];
+    __m128 dual[4];
+
+    auto sign_bit = _mm_set1_ps(-0.0f);
+    for (std::size_t influence = 0; influence < 4; influence++) {
+        __m128 bone_real[4];
+        __m128 bone_dual[4];
+        alignas(16) float weights[4];
+        for (std::size_t vertex = 0; vertex < 4; vertex++) {
+            const auto& bone = palette[input.bone_indices[index + vertex][influence]];
+            bone_real[vertex] = _mm_loadu_ps(bone.real.asVector().data());
+            bone_dual[vertex] = _mm_loadu_ps(bone.dual.asVector().data());
+            weights[vertex] = input.bone_weights[index + vertex][influence];
+        }
+        _MM_TRANSPOSE4_PS(bone_real[0], bone_real[1], bone_real[2], bone_real[3]);
+        _MM_TRANSPOSE4_PS(bone_dual[0], bone_dual[1], bone_dual[2], bone_dual[3]);
+        auto weight = _mm_load_ps(weights);
+
+        if (influence == 0) {
+            for (std::size_t i = 0; i < 4; i++) {
+                first[i] = bone_real[i];
+                real[i] = _mm_mul_ps(bone_real[i], weight);
+                dual[i] = _mm_mul_ps(bone_dual[i], weight);
+            }
+            continue;
+        }
+
+        // Blend along the shortest path, as q and -q represent the same transformation.
+        auto dot = _mm_mul_ps(first[0], bone_real[0]);
+        for (std::size_t i = 1; i < 4; i++)
+            dot = _mm_add_ps(dot, _mm_mul_ps(first[i], bone_real[i]));
+        weight = _mm_xor_ps(weight, _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), sign_bit));
+
+        for (std::size_t i = 0; i < 4; i++) {
+            real[i] = _mm_add_ps(real[i], _mm_mul_ps(bone_real[i], weight));
+            dual[i] = _mm_add_ps(dual[i], _mm_mul_ps(bone_dual[i], weight));
+        }
+    }
+
+    auto length_squared = _mm_mul_ps(real[0], real[0]);
+    for (std::size_t i = 1; i < 4; i++)
+        length_squared = _mm_add_ps(length_squared, _mm_mul_ps(real[i], real[i]));
+    auto inv_length = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(length_squared));
+    for (std::size_t i = 0; i < 4; i++) {
+        real[i] = _mm_mul_ps(real[i], inv_length);
+        dual[i] = _mm_mul_ps(dual[i], inv_length);
+    }
+
+    auto cross = [](const __m128(&lhs)[4], const __m128(&rhs)[3], __m128(&result)[3]) {
+        result[0] = _mm_sub_ps(_mm_mul_ps(lhs[1], rhs[2]), _mm_mul_ps(lhs[2], rhs[1]));
+        result[1] = _mm_sub_ps(_mm_mul_ps(lhs[2], rhs[0]), _mm_mul_ps(lhs[0], rhs[2]));
+        result[2] = _mm_sub_ps(_mm_mul_ps(lhs[0], rhs[1]), _mm_mul_ps(lhs[1], rhs[0]));
+    };
+    auto two = _mm_set1_ps(2.0f);
+
+    // v' = v + 2 * (w * (u x v) + u x (u x v))
+    auto rotate = [&](__m128(&vector)[3]) {
+        __m128 uv[3];
+        __m128 uuv[3];
+        cross(real, vector, uv);
+        cross(real, uv, uuv);
+        for (std::size_t i = 0; i < 3; i++)
+            vector[i] = _mm_add_ps(vector[i], _mm_mul_ps(two, _mm_add_ps(_mm_mul_ps(real[3], uv[i]), uuv[i])));
+    };
+    auto load = [&](const StridedSpan<const vec3>& span, __m128(&vector)[3]) {
+        const auto& v0 = span[index];
+        const auto& v1 = span[index + 1];
+        const auto& v2 = span[index + 2];
+        const auto& v3 = span[index + 3];
+        for (std::size_t i = 0; i < 3; i++)
+            vector[i] = _mm_setr_ps(v0[i], v1[i], v2[i], v3[i]);
+    };
+    auto store = [&](const StridedSpan<vec3>& span, const __m128(&vector)[3]) {
+        alignas(16) float components[3][4];
+        for (std::size_t i = 0; i < 3; i++)
+            _mm_store_ps(components[i], vector[i]);
+        for (std::size_t vertex = 0; vertex < 4; vertex++)
+            span[index + vertex] = {components[0][vertex], components[1][vertex], components[2][vertex]};
+    };
+
+    // t = 2 * (real.w * dual.xyz - dual.w * real.xyz + real.xyz x dual.xyz)
+    __m128 translation[3];
+    cross(real, {dual[0], dual[1], dual[2]}, translation);
+    for (std::size_t i = 0; i < 3; i++) {
+        auto offset = _mm_sub_ps(_mm_mul_ps(real[3], dual[i]), _mm_mul_ps(dual[3], real[i]));
+        translation[i] = _mm_mul_ps(two, _mm_add_ps(translation[i], offset));
+    }
+
+    __m128 position[3];
+    load(input.positions, position);
+    rotate(position);
+    for (std::size_t i = 0; i < 3; i++)
+        position[i] = _mm_add_ps(position[i], translation[i]);
+    store(output.positions, position);
+
+    if (skin_normals) {
+        __m128 normal[3];
+        load(input.normals, normal);
+        rotate(normal);
+        store(output.normals, normal);
+    }
+}
+
+#endif
+
+} // namespace detail
+
+/// @brief Performs dual-quaternion linear blend skinning on the vertices in the range [begin, end).
+/// @remark The blended dual-quaternion of each vertex is normalized, so weights do not need to add up to exactly one.
+template <typename TIndex>
+inline void dualQuaternionRange(const SkinningInput<TIndex>& input,
+                                const dquat* palette,
+                                const SkinningOutput& output,
+                                std::size_t begin,
+                                std::size_t end)
+{
+    assert(input.bone_indices.size() >= end && input.bone_weights.size() >= end);
+    assert(input.positions.size() >= end && output.positions.size() >= end);
+    bool skin_normals = !input.normals.empty() && !output.normals.empty();
+    assert(!skin_normals || (input.normals.size() >= end && output.normals.size() >= end));
+
+    std::size_t index = begin;
+#if defined(DMATH_SIMD_SSE)
+    for (; index + 4 <= end; index += 4)
+        detail::dualQuaternionQuad(input, palette, output, skin_normals, index);
+#endif
+    for (; index < end; index++)
+        detail::dualQuaternionVertex(input, palette, output, skin_normals, index);
+}
+
+/// @brief Performs dual-quaternion linear blend skinning on all vertices, split across multiple threads.
+/// @remark A thread count of zero uses the hardware concurrency. No more threads are started than there are chunks of
+/// min_vertices_per_thread, with the calling thread always processing the first chunk itself.
+template <typename TIndex>
+inline void dualQuaternion(const SkinningInput<TIndex>& input,
+                           const dquat* palette,
+                           const SkinningOutput& output,
+                           std::size_t thread_count = 0)
+{
+    std::size_t count = input.positions.size();
+    if (thread_count == 0)
+        thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+    thread_count = std::clamp<std::size_t>(count / min_vertices_per_thread, 1, thread_count);
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+    std::size_t chunk_size = (count + thread_count - 1) / thread_count;
+    for (std::size_t begin = chunk_size; begin < count; begin += chunk_size) {
+        std::size_t end = std::min(begin + chunk_size, count);
+        threads.emplace_back([&, begin, end] { dualQuaternionRange(input, palette, output, begin, end); });
+    }
+    dualQuaternionRange(input, palette, output, 0, std::min(chunk_size, count));
+    for (auto& thread : threads)
+        thread.join();
+}
+
+} // namespace skinning
+
+} // namespace dang::math
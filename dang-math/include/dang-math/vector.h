@@ -2,6 +2,7 @@
 
 #include "dang-math/enums.h"
 #include "dang-math/global.h"
+#include "dang-math/simd.h"
 #include "dang-math/utils.h"
 
 namespace dang::math {
@@ -9,6 +10,8 @@ namespace dang::math {
 // TODO: C++20 Replace SFINAE/static_assert with requires
 
 /// @brief A vector of the templated type and dimension, using std::array as base.
+/// @remark If DMATH_USE_SIMD is defined, some operations of vec4 use SIMD instructions at runtime, while still being
+/// usable in constant expressions.
 template <typename T, std::size_t v_dim>
 struct Vector : std::array<T, v_dim> {
     using Base = std::array<T, v_dim>;
@@ -110,6 +113,12 @@ struct Vector : std::array<T, v_dim> {
     constexpr auto dot(const Vector& other) const
     {
         static_assert(!std::is_same_v<T, bool>);
+        if constexpr (detail::has_simd_dot_v<T, dim>) {
+            if (!detail::isConstantEvaluated()) {
+                using Simd = detail::SimdOps<T, dim>;
+                return Simd::dot(Simd::load(this->data()), Simd::load(other.data()));
+            }
+        }
         T result{};
         for (std::size_t i = 0; i < dim; i++)
             result += (*this)[i] * other[i];
@@ -120,6 +129,13 @@ struct Vector : std::array<T, v_dim> {
     constexpr auto sqrdot() const
     {
         static_assert(!std::is_same_v<T, bool>);
+        if constexpr (detail::has_simd_dot_v<T, dim>) {
+            if (!detail::isConstantEvaluated()) {
+                using Simd = detail::SimdOps<T, dim>;
+                auto value = Simd::load(this->data());
+                return Simd::dot(value, value);
+            }
+        }
         T result{};
         for (std::size_t i = 0; i < dim; i++)
             result += (*this)[i] * (*this)[i];
@@ -250,14 +266,14 @@ struct Vector : std::array<T, v_dim> {
     constexpr auto min(const Vector& other) const
     {
         static_assert(!std::is_same_v<T, bool>);
-        return variadicOp([](T a, T b) { return std::min(a, b); }, other);
+        return simdOp(detail::Min{}, other);
     }
 
     /// @brief Returns a vector, only taking the larger components of both vectors.
     constexpr auto max(const Vector& other) const
     {
         static_assert(!std::is_same_v<T, bool>);
-        return variadicOp([](T a, T b) { return std::max(a, b); }, other);
+        return simdOp(detail::Max{}, other);
     }
 
     /// @brief Returns a vector, for which each component is clamped between low and high.
@@ -355,56 +371,56 @@ struct Vector : std::array<T, v_dim> {
     friend constexpr auto operator+(const Vector& lhs, const Vector& rhs)
     {
         static_assert(!std::is_same_v<T, bool>);
-        return lhs.variadicOp(std::plus{}, rhs);
+        return lhs.simdOp(std::plus{}, rhs);
     }
 
     /// @brief Component-wise addition of two vectors.
     constexpr auto& operator+=(const Vector& other)
     {
         static_assert(!std::is_same_v<T, bool>);
-        return assignmentOp(std::plus{}, other);
+        return simdAssignmentOp(std::plus{}, other);
     }
 
     /// @brief Component-wise subtraction of two vectors.
     friend constexpr auto operator-(const Vector& lhs, const Vector& rhs)
     {
         static_assert(!std::is_same_v<T, bool>);
-        return lhs.variadicOp(std::minus{}, rhs);
+        return lhs.simdOp(std::minus{}, rhs);
     }
 
     /// @brief Component-wise subtraction of two vectors.
     constexpr auto& operator-=(const Vector& other)
     {
         static_assert(!std::is_same_v<T, bool>);
-        return assignmentOp(std::minus{}, other);
+        return simdAssignmentOp(std::minus{}, other);
     }
 
     /// @brief Component-wise multiplication of two vectors.
     friend constexpr auto operator*(const Vector& lhs, const Vector& rhs)
     {
         static_assert(!std::is_same_v<T, bool>);
-        return lhs.variadicOp(std::multiplies{}, rhs);
+        return lhs.simdOp(std::multiplies{}, rhs);
     }
 
     /// @brief Component-wise multiplication of two vectors.
     constexpr auto& operator*=(const Vector& other)
     {
         static_assert(!std::is_same_v<T, bool>);
-        return assignmentOp(std::multiplies{}, other);
+        return simdAssignmentOp(std::multiplies{}, other);
     }
 
     /// @brief Component-wise division of two vectors.
     friend constexpr auto operator/(const Vector& lhs, const Vector& rhs)
     {
         static_assert(!std::is_same_v<T, bool>);
-        return lhs.variadicOp(std::divides{}, rhs);
+        return lhs.simdOp(std::divides{}, rhs);
     }
 
     /// @brief Component-wise division of two vectors.
     constexpr auto& operator/=(const Vector& other)
     {
         static_assert(!std::is_same_v<T, bool>);
-        return assignmentOp(std::divides{}, other);
+        return simdAssignmentOp(std::divides{}, other);
     }
 
     /// @brief Component-wise modulus of two vectors.
@@ -461,6 +477,37 @@ struct Vector : std::array<T, v_dim> {
         return *this;
     }
 
+    /// @brief Performs an operation on each component with another vector.
+    /// @remark Uses SIMD instructions at runtime, if they are available for the given operation.
+    template <typename TOperation>
+    constexpr auto simdOp(TOperation operation, const Vector& other) const
+    {
+        if constexpr (detail::has_simd_op_v<T, dim, TOperation>) {
+            if (!detail::isConstantEvaluated()) {
+                using Simd = detail::SimdOps<T, dim>;
+                Vector result;
+                Simd::store(result.data(), Simd::apply(operation, Simd::load(this->data()), Simd::load(other.data())));
+                return result;
+            }
+        }
+        return variadicOp(operation, other);
+    }
+
+    /// @brief Performs an operation with another vector and assigns the result to itself.
+    /// @remark Uses SIMD instructions at runtime, if they are available for the given operation.
+    template <typename TOperation>
+    constexpr auto& simdAssignmentOp(TOperation operation, const Vector& other)
+    {
+        if constexpr (detail::has_simd_op_v<T, dim, TOperation>) {
+            if (!detail::isConstantEvaluated()) {
+                using Simd = detail::SimdOps<T, dim>;
+                Simd::store(this->data(), Simd::apply(operation, Simd::load(this->data()), Simd::load(other.data())));
+                return *this;
+            }
+        }
+        return assignmentOp(operation, other);
+    }
+
     /// @brief Returns a string representing the vector in the form [x, y, z].
     auto format() const { return (std::stringstream() << *this).str(); }
 
@@ -0,0 +1,104 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include "dang-math/batch.h"
+#include "dang-math/matrix.h"
+#include "dang-math/quaternion.h"
+#include "dang-math/vector.h"
+
+#include "catch2/catch.hpp"
+
+namespace dmath = dang::math;
+
+namespace {
+
+std::vector<dmath::vec3> makePoints(std::size_t count)
+{
+    std::vector<dmath::vec3> result(count);
+    for (std::size_t i = 0; i < count; i++)
+        result[i] = dmath::vec3(static_cast<float>(i % 17), static_cast<float>(i % 13) + 1, static_cast<float>(i % 7));
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("Vector batch kernels compared to per-element loops.", "[batch][.benchmark]")
+{
+    constexpr std::size_t count = 100'000;
+    const auto lhs_vectors = makePoints(count);
+    const auto rhs_vectors = makePoints(count + 3);
+    std::vector<dmath::vec3> out_vectors(count);
+
+    const dmath::vec3batch lhs(lhs_vectors);
+    const dmath::vec3batch rhs(std::vector<dmath::vec3>(rhs_vectors.begin(), rhs_vectors.begin() + count));
+    dmath::vec3batch out(count);
+
+    const dmath::mat4 matrix({{0.8f, 0, -0.6f, 0}, {0, 1, 0, 0}, {0.6f, 0, 0.8f, 0}, {1, 2, 3, 1}});
+    const auto quaternion = dmath::quat::fromAxis(dmath::vec3(1, 1, 0).normalize(), 30);
+
+    BENCHMARK("add (per-element)")
+    {
+        for (std::size_t i = 0; i < count; i++)
+            out_vectors[i] = lhs_vectors[i] + rhs_vectors[i];
+        return out_vectors.back();
+    };
+    BENCHMARK("add (batch)")
+    {
+        dmath::batch::add(lhs, rhs, out.span());
+        return out[count - 1];
+    };
+
+    BENCHMARK("cross (per-element)")
+    {
+        for (std::size_t i = 0; i < count; i++)
+            out_vectors[i] = lhs_vectors[i].cross(rhs_vectors[i]);
+        return out_vectors.back();
+    };
+    BENCHMARK("cross (batch)")
+    {
+        dmath::batch::cross(lhs, rhs, out.span());
+        return out[count - 1];
+    };
+
+    BENCHMARK("normalize (per-element)")
+    {
+        for (std::size_t i = 0; i < count; i++)
+            out_vectors[i] = rhs_vectors[i].normalize();
+        return out_vectors.back();
+    };
+    BENCHMARK("normalize (batch)")
+    {
+        dmath::batch::normalize(rhs, out.span());
+        return out[count - 1];
+    };
+
+    BENCHMARK("transform by matrix (per-element)")
+    {
+        for (std::size_t i = 0; i < count; i++)
+            out_vectors[i] = (matrix * dmath::vec4(lhs_vectors[i], 1)).xyz();
+        return out_vectors.back();
+    };
+    BENCHMARK("transform by matrix (batch)")
+    {
+        dmath::batch::transform(matrix, lhs, out.span());
+        return out[count - 1];
+    };
+
+    BENCHMARK("transform by quaternion (per-element)")
+    {
+        for (std::size_t i = 0; i < count; i++)
+            out_vectors[i] = quaternion * lhs_vectors[i];
+        return out_vectors.back();
+    };
+    BENCHMARK("transform by quaternion (batch)")
+    {
+        dmath::batch::transform(quaternion, lhs, out.span());
+        return out[count - 1];
+    };
+
+    BENCHMARK("deinterleave and interleave")
+    {
+        dmath::batch::deinterleave(lhs_vectors.data(), out.span());
+        dmath::batch::interleave(out.span(), out_vectors.data());
+        return out_vectors.back();
+    };
+}
@@ -0,0 +1,86 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include "dang-math/matrix.h"
+
+#include "catch2/catch.hpp"
+
+namespace dmath = dang::math;
+
+TEMPLATE_TEST_CASE("4x4 matrix operations compared to reference implementations.",
+                   "[matrix][simd][.benchmark]",
+                   dmath::mat4,
+                   dmath::dmat4)
+{
+    TestType a({{2, 0, 1, 0}, {1, 3, 0, 2}, {0, 1, 4, 1}, {5, -2, 1, 1}});
+    TestType b({{1, 2, 3, 4}, {0, 1, 0, 2}, {-1, 0, 2, 1}, {3, 1, 1, 1}});
+    TestType affine({{0, 0, -2, 0}, {0, 1, 0, 0}, {0.5, 0, 0, 0}, {1, 2, 3, 1}});
+
+    BENCHMARK("multiply (reference)")
+    {
+        TestType result;
+        dmath::sbounds2 bounds{{4, 4}};
+        for (const auto& pos : bounds)
+            for (std::size_t i = 0; i < 4; i++)
+                result[pos] += a(i, pos.y()) * b(pos.x(), i);
+        return result;
+    };
+    BENCHMARK("multiply") { return a * b; };
+
+    BENCHMARK("transpose") { return a.transpose(); };
+
+    BENCHMARK("inverse (reference)") { return a.adjugate() / a.determinant(); };
+    BENCHMARK("inverse") { return a.inverse(); };
+    BENCHMARK("affineInverse") { return affine.affineInverse(); };
+}
+
+namespace {
+
+template <std::size_t v_dim>
+auto makeSystem()
+{
+    dmath::Matrix<double, v_dim> matrix;
+    for (std::size_t col = 0; col < v_dim; col++)
+        for (std::size_t row = 0; row < v_dim; row++)
+            matrix(col, row) = col == row ? static_cast<double>(v_dim) : static_cast<double>((col * 7 + row * 3) % 5);
+    return matrix;
+}
+
+template <std::size_t v_dim>
+double laplaceDeterminant(const dmath::Matrix<double, v_dim>& matrix)
+{
+    if constexpr (v_dim == 1) {
+        return matrix(0, 0);
+    }
+    else {
+        double result = 0;
+        for (std::size_t col = 0; col < v_dim; col++)
+            result += (col % 2 ? -1 : 1) * matrix(col, 0) * laplaceDeterminant(matrix.minor(col, 0));
+        return result;
+    }
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE_SIG("Solving linear equations with LU-decomposition.",
+                       "[matrix][lu][.benchmark]",
+                       ((std::size_t v_dim), v_dim),
+                       6,
+                       8,
+                       12)
+{
+    const auto matrix = makeSystem<v_dim>();
+    dmath::Vector<double, v_dim> vector;
+    for (std::size_t i = 0; i < v_dim; i++)
+        vector[i] = static_cast<double>(i + 1);
+
+    if constexpr (v_dim <= 8) {
+        BENCHMARK("determinant (cofactor expansion)") { return laplaceDeterminant(matrix); };
+    }
+    BENCHMARK("determinant") { return matrix.determinant(); };
+
+    BENCHMARK("solve") { return matrix.solve(vector); };
+    BENCHMARK("inverse") { return matrix.inverse(); };
+
+    const auto lu = matrix.lu();
+    BENCHMARK("solve (reusing decomposition)") { return lu.solve(vector); };
+}
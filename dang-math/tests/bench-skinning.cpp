@@ -0,0 +1,58 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include "dang-math/skinning.h"
+
+#include "catch2/catch.hpp"
+
+namespace dmath = dang::math;
+
+TEST_CASE("Dual-quaternion skinning compared to per-vertex dual-quaternion operations.", "[skinning][.benchmark]")
+{
+    constexpr std::size_t count = 200'000;
+    constexpr std::size_t bone_count = 64;
+
+    std::vector<dmath::dquat> palette;
+    for (std::size_t i = 0; i < bone_count; i++) {
+        auto angle = static_cast<float>(i) * 5;
+        palette.push_back(dmath::dquat::fromAxis(dmath::vec3(1, 2, 3).normalize(), angle).translate({angle, 1, 0}));
+    }
+
+    std::vector<dmath::vec3> positions(count);
+    std::vector<dmath::vec3> normals(count, dmath::vec3(0, 1, 0));
+    std::vector<dmath::Vector<std::uint8_t, 4>> bone_indices(count);
+    std::vector<dmath::vec4> bone_weights(count, dmath::vec4(0.4f, 0.3f, 0.2f, 0.1f));
+    for (std::size_t i = 0; i < count; i++) {
+        positions[i] = dmath::vec3(static_cast<float>(i % 17), static_cast<float>(i % 13), static_cast<float>(i % 7));
+        for (std::size_t j = 0; j < 4; j++)
+            bone_indices[i][j] = static_cast<std::uint8_t>((i + j * 7) % bone_count);
+    }
+
+    dmath::SkinningInput<std::uint8_t> input{{positions.data(), count},
+                                             {normals.data(), count},
+                                             {bone_indices.data(), count},
+                                             {bone_weights.data(), count}};
+    std::vector<dmath::vec3> out_positions(count);
+    std::vector<dmath::vec3> out_normals(count);
+    dmath::SkinningOutput output{{out_positions.data(), count}, {out_normals.data(), count}};
+
+    BENCHMARK("per-vertex dual-quaternion operations")
+    {
+        for (std::size_t i = 0; i < count; i++) {
+            auto blended = palette[bone_indices[i][0]] * bone_weights[i][0];
+            for (std::size_t j = 1; j < 4; j++)
+                blended += palette[bone_indices[i][j]] * bone_weights[i][j];
+            blended = blended.normalize();
+            out_positions[i] = blended * positions[i];
+            out_normals[i] = blended.real * normals[i];
+        }
+        return out_positions.back();
+    };
+
+    for (std::size_t thread_count : {1, 2, 4, 8}) {
+        BENCHMARK("skinning::dualQuaternion (" + std::to_string(thread_count) + " threads)")
+        {
+            dmath::skinning::dualQuaternion(input, palette.data(), output, thread_count);
+            return out_positions.back();
+        };
+    }
+}
@@ -0,0 +1,101 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include "dang-math/vector.h"
+
+#include "catch2/catch.hpp"
+
+namespace dmath = dang::math;
+
+namespace {
+
+template <typename TVector>
+std::vector<TVector> makeVectors(std::size_t count)
+{
+    std::vector<TVector> result(count);
+    for (std::size_t i = 0; i < count; i++)
+        for (std::size_t d = 0; d < TVector::dim; d++)
+            result[i][d] = static_cast<typename TVector::Type>((i * 7 + d * 3) % 11 + 1);
+    return result;
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Vector operations using scalar and SIMD paths.",
+                   "[vector][simd][.benchmark]",
+                   dmath::vec3,
+                   dmath::vec4,
+                   dmath::ivec4)
+{
+    using Vector = TestType;
+    using T = typename Vector::Type;
+
+    constexpr std::size_t count = 4096;
+    const auto lhs = makeVectors<Vector>(count);
+    const auto rhs = makeVectors<Vector>(count + 1);
+
+    BENCHMARK("add (scalar)")
+    {
+        Vector result;
+        for (std::size_t i = 0; i < count; i++)
+            result = result.variadicOp(std::plus{}, lhs[i].variadicOp(std::plus{}, rhs[i + 1]));
+        return result;
+    };
+    BENCHMARK("add (simd)")
+    {
+        Vector result;
+        for (std::size_t i = 0; i < count; i++)
+            result += lhs[i] + rhs[i + 1];
+        return result;
+    };
+
+    BENCHMARK("mul (scalar)")
+    {
+        Vector result;
+        for (std::size_t i = 0; i < count; i++)
+            result = result.variadicOp(std::plus{}, lhs[i].variadicOp(std::multiplies{}, rhs[i + 1]));
+        return result;
+    };
+    BENCHMARK("mul (simd)")
+    {
+        Vector result;
+        for (std::size_t i = 0; i < count; i++)
+            result += lhs[i] * rhs[i + 1];
+        return result;
+    };
+
+    BENCHMARK("dot (scalar)")
+    {
+        T result{};
+        for (std::size_t i = 0; i < count; i++)
+            result += lhs[i].variadicOp(std::multiplies{}, rhs[i + 1]).sum();
+        return result;
+    };
+    BENCHMARK("dot (simd)")
+    {
+        T result{};
+        for (std::size_t i = 0; i < count; i++)
+            result += lhs[i].dot(rhs[i + 1]);
+        return result;
+    };
+
+    BENCHMARK("min/max (scalar)")
+    {
+        Vector low = lhs[0];
+        Vector high = lhs[0];
+        for (std::size_t i = 0; i < count; i++) {
+            low = low.variadicOp([](T a, T b) { return std::min(a, b); }, rhs[i]);
+            high = high.variadicOp([](T a, T b) { return std::max(a, b); }, rhs[i]);
+        }
+        return low + high;
+    };
+    BENCHMARK("min/max (simd)")
+    {
+        Vector low = lhs[0];
+        Vector high = lhs[0];
+        for (std::size_t i = 0; i < count; i++) {
+            low = low.min(rhs[i]);
+            high = high.max(rhs[i]);
+        }
+        return low + high;
+    };
+}
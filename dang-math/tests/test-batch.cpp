@@ -0,0 +1,161 @@
+#include "dang-math/batch.h"
+#include "dang-math/vector.h"
+
+#include "catch2/catch.hpp"
+
+namespace dmath = dang::math;
+
+namespace {
+
+void checkApprox(const dmath::vec3& actual, const dmath::vec3& expected)
+{
+    CAPTURE(actual, expected);
+    CHECK(actual.x() == Approx(expected.x()).margin(1e-5));
+    CHECK(actual.y() == Approx(expected.y()).margin(1e-5));
+    CHECK(actual.z() == Approx(expected.z()).margin(1e-5));
+}
+
+} // namespace
+
+TEST_CASE("Vector batches can be converted from and to arrays of vectors.", "[batch][conversion]")
+{
+    const std::vector<dmath::vec3> vectors{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+    dmath::vec3batch batch(vectors);
+
+    REQUIRE(batch.size() == 3);
+    CHECK(batch.component(0)[1] == 4);
+    CHECK(batch.component(1)[2] == 8);
+    CHECK(batch[2] == dmath::vec3(7, 8, 9));
+    CHECK(batch.toVectors() == vectors);
+
+    batch.set(1, {0, 0, 0});
+    batch.push_back({1, 1, 1});
+    CHECK(batch.toVectors() == std::vector<dmath::vec3>{{1, 2, 3}, {0, 0, 0}, {7, 8, 9}, {1, 1, 1}});
+}
+
+TEST_CASE("Vector spans can view a part of a batch.", "[batch][span]")
+{
+    dmath::vec3batch batch(std::vector<dmath::vec3>{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}});
+    auto span = batch.span().subspan(1, 2);
+
+    REQUIRE(span.size() == 2);
+    CHECK(span[0] == dmath::vec3(4, 5, 6));
+
+    dmath::VectorSpan<const float, 3> const_span = span;
+    CHECK(const_span[1] == dmath::vec3(7, 8, 9));
+}
+
+TEST_CASE("Vector batch kernels give the same results as single vector operations.", "[batch][operations]")
+{
+    const std::vector<dmath::vec3> lhs_vectors{{1, 2, 3}, {-4, 5, 6}, {7, -8, 9}, {0.5f, 0.25f, -1}, {3, 3, 3}};
+    const std::vector<dmath::vec3> rhs_vectors{{2, 1, 1}, {1, -1, 2}, {3, 3, 3}, {-2, 4, 0.5f}, {1, 2, 4}};
+    const dmath::vec3batch lhs(lhs_vectors);
+    const dmath::vec3batch rhs(rhs_vectors);
+    dmath::vec3batch out(lhs.size());
+
+    auto checkEach = [&](auto operation) {
+        auto results = out.toVectors();
+        for (std::size_t i = 0; i < results.size(); i++)
+            checkApprox(results[i], operation(lhs_vectors[i], rhs_vectors[i]));
+    };
+
+    SECTION("Component-wise operations.")
+    {
+        dmath::batch::add(lhs, rhs, out.span());
+        checkEach([](auto a, auto b) { return a + b; });
+        dmath::batch::sub(lhs, rhs, out.span());
+        checkEach([](auto a, auto b) { return a - b; });
+        dmath::batch::mul(lhs, rhs, out.span());
+        checkEach([](auto a, auto b) { return a * b; });
+        dmath::batch::div(lhs, rhs, out.span());
+        checkEach([](auto a, auto b) { return a / b; });
+        dmath::batch::min(lhs, rhs, out.span());
+        checkEach([](auto a, auto b) { return a.min(b); });
+        dmath::batch::max(lhs, rhs, out.span());
+        checkEach([](auto a, auto b) { return a.max(b); });
+        dmath::batch::scale(lhs, 2.0f, out.span());
+        checkEach([](auto a, auto) { return a * 2.0f; });
+        dmath::batch::interpolate(lhs, rhs, 0.25f, out.span());
+        checkEach([](auto a, auto b) { return a + 0.25f * (b - a); });
+    }
+    SECTION("Geometric operations.")
+    {
+        dmath::batch::cross(lhs, rhs, out.span());
+        checkEach([](auto a, auto b) { return a.cross(b); });
+        dmath::batch::normalize(lhs, out.span());
+        checkEach([](auto a, auto) { return a.normalize(); });
+
+        std::vector<float> values(lhs.size());
+        dmath::batch::dot(lhs.span(), rhs, values.data());
+        for (std::size_t i = 0; i < values.size(); i++)
+            CHECK(values[i] == Approx(lhs_vectors[i].dot(rhs_vectors[i])));
+        dmath::batch::length(lhs.span(), values.data());
+        for (std::size_t i = 0; i < values.size(); i++)
+            CHECK(values[i] == Approx(lhs_vectors[i].length()));
+    }
+    SECTION("Transformations.")
+    {
+        dmath::mat4 matrix({{0, 1, 0, 0}, {-1, 0, 0, 0}, {0, 0, 2, 0}, {1, 2, 3, 1}});
+        dmath::batch::transform(matrix, lhs, out.span());
+        checkEach([&](auto a, auto) { return (matrix * dmath::vec4(a, 1)).xyz(); });
+
+        auto quaternion = dmath::quat::fromAxis({0, 1, 0}, 90);
+        dmath::batch::transform(quaternion, lhs, out.span());
+        checkEach([&](auto a, auto) { return quaternion * a; });
+    }
+    SECTION("Operations can be performed in-place.")
+    {
+        out = lhs;
+        dmath::batch::cross(out, rhs, out.span());
+        checkEach([](auto a, auto b) { return a.cross(b); });
+    }
+    SECTION("Dot-products can be written into a component of either input.")
+    {
+        for (std::size_t d = 0; d < 3; d++) {
+            out = lhs;
+            dmath::batch::dot(out.span(), rhs, out.component(d));
+            for (std::size_t i = 0; i < lhs.size(); i++)
+                CHECK(out.component(d)[i] == Approx(lhs_vectors[i].dot(rhs_vectors[i])));
+
+            out = rhs;
+            dmath::batch::dot(lhs.span(), out, out.component(d));
+            for (std::size_t i = 0; i < lhs.size(); i++)
+                CHECK(out.component(d)[i] == Approx(lhs_vectors[i].dot(rhs_vectors[i])));
+        }
+    }
+}
+
+TEST_CASE("Vector batch kernels handle batches spanning multiple blocks.", "[batch][operations]")
+{
+    // Some kernels process vectors in blocks of 256, so this covers two full blocks and a partial one.
+    constexpr std::size_t count = 2 * 256 + 89;
+    std::vector<dmath::vec3> lhs_vectors;
+    std::vector<dmath::vec3> rhs_vectors;
+    for (std::size_t i = 0; i < count; i++) {
+        auto value = static_cast<float>(i);
+        lhs_vectors.emplace_back(1.0f + static_cast<float>(i % 7), static_cast<float>(i % 11) - 5.5f, value * 0.1f);
+        rhs_vectors.emplace_back(static_cast<float>(i % 5) - 2.0f, 1.0f + static_cast<float>(i % 3), value * -0.05f);
+    }
+    const dmath::vec3batch lhs(lhs_vectors);
+    const dmath::vec3batch rhs(rhs_vectors);
+    dmath::vec3batch out(lhs.size());
+
+    auto checkEach = [&](auto operation) {
+        auto results = out.toVectors();
+        REQUIRE(results.size() == count);
+        for (std::size_t i = 0; i < results.size(); i++)
+            checkApprox(results[i], operation(lhs_vectors[i], rhs_vectors[i]));
+    };
+
+    dmath::batch::cross(lhs, rhs, out.span());
+    checkEach([](auto a, auto b) { return a.cross(b); });
+    dmath::batch::normalize(lhs, out.span());
+    checkEach([](auto a, auto) { return a.normalize(); });
+
+    out = lhs;
+    dmath::batch::cross(out, rhs, out.span());
+    checkEach([](auto a, auto b) { return a.cross(b); });
+    out = lhs;
+    dmath::batch::normalize(out, out.span());
+    checkEach([](auto a, auto) { return a.normalize(); });
+}
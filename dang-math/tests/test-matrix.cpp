@@ -0,0 +1,182 @@
+#include "dang-math/matrix.h"
+
+#include "catch2/catch.hpp"
+
+namespace dmath = dang::math;
+
+namespace {
+
+template <typename T>
+void checkApprox(const dmath::Matrix<T, 4>& actual, const dmath::Matrix<T, 4>& expected)
+{
+    CAPTURE(actual, expected);
+    for (std::size_t col = 0; col < 4; col++)
+        for (std::size_t row = 0; row < 4; row++)
+            CHECK(actual(col, row) == Approx(expected(col, row)).margin(1e-5));
+}
+
+template <std::size_t v_dim>
+constexpr auto makeMatrix(const double (&columns)[v_dim][v_dim])
+{
+    dmath::Matrix<double, v_dim> result;
+    for (std::size_t col = 0; col < v_dim; col++)
+        for (std::size_t row = 0; row < v_dim; row++)
+            result(col, row) = columns[col][row];
+    return result;
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("4x4 matrices can be multiplied, transposed and inverted.", "[matrix]", dmath::mat4, dmath::dmat4)
+{
+    using T = typename TestType::Type;
+
+    constexpr TestType a({{2, 0, 1, 0}, {1, 3, 0, 2}, {0, 1, 4, 1}, {5, -2, 1, 1}});
+    constexpr TestType b({{1, 2, 3, 4}, {0, 1, 0, 2}, {-1, 0, 2, 1}, {3, 1, 1, 1}});
+    TestType c = a;
+    TestType d = b;
+
+    SECTION("Runtime results match constant evaluation.")
+    {
+        constexpr auto product = a * b;
+        constexpr auto transposed = a.transpose();
+        constexpr auto inverse = a.inverse();
+        STATIC_REQUIRE(inverse.has_value());
+
+        CHECK(c * d == product);
+        CHECK(c.transpose() == transposed);
+        REQUIRE(c.inverse());
+        checkApprox(*c.inverse(), *inverse);
+    }
+    SECTION("The inverse matches the adjugate divided by the determinant.")
+    {
+        checkApprox(*c.inverse(), c.adjugate() / c.determinant());
+        checkApprox(*c.inverse() * c, TestType::identity());
+    }
+    SECTION("Singular matrices cannot be inverted.")
+    {
+        constexpr TestType singular({{1, 2, 3, 4}, {2, 4, 6, 8}, {0, 1, 0, 1}, {1, 0, 1, 0}});
+        STATIC_REQUIRE_FALSE(singular.inverse());
+        TestType runtime_singular = singular;
+        CHECK_FALSE(runtime_singular.inverse());
+        CHECK_FALSE(TestType().inverse());
+    }
+    SECTION("Affine matrices have a cheaper inverse.")
+    {
+        constexpr TestType affine({{0, 0, -2, 0}, {0, 1, 0, 0}, {0.5, 0, 0, 0}, {1, 2, 3, 1}});
+        constexpr auto inverse = affine.affineInverse();
+        STATIC_REQUIRE(inverse.has_value());
+
+        TestType runtime_affine = affine;
+        REQUIRE(runtime_affine.affineInverse());
+        checkApprox(*runtime_affine.affineInverse(), *inverse);
+        checkApprox(*runtime_affine.affineInverse(), *runtime_affine.inverse());
+        checkApprox(*runtime_affine.affineInverse() * runtime_affine, TestType::identity());
+
+        TestType singular = runtime_affine;
+        singular[1] = {};
+        CHECK_FALSE(singular.affineInverse());
+    }
+    SECTION("Multiplication with non-square matrices still works.")
+    {
+        constexpr dmath::Matrix<T, 2, 4> e({{1, 2, 3, 4}, {5, 6, 7, 8}});
+        CHECK(c * e == a * e);
+    }
+}
+
+TEST_CASE("Matrices can be LU-decomposed to solve linear equations.", "[matrix][lu]")
+{
+    // Columns are chosen, so that the top left block is singular, which requires pivoting.
+    constexpr auto a = makeMatrix<6>({{0, 2, 1, 0, 3, 1},
+                                      {1, 0, 2, 1, 0, 2},
+                                      {4, 1, 0, 3, 1, 0},
+                                      {0, 3, 1, 5, 2, 1},
+                                      {2, 0, 1, 1, 6, 0},
+                                      {1, 1, 0, 2, 0, 7}});
+    constexpr auto b = makeMatrix<6>({{1, 2, 3, 4, 5, 6}, {}, {}, {}, {}, {}})[0];
+
+    SECTION("The decomposition can be done during constant evaluation.")
+    {
+        constexpr auto lu = a.lu();
+        STATIC_REQUIRE_FALSE(lu.singular());
+        constexpr auto x = lu.solve(b);
+        STATIC_REQUIRE(x.has_value());
+    }
+    SECTION("Solving the equation gives the original vector when multiplied with the matrix.")
+    {
+        auto lu = a.lu();
+        auto x = lu.solve(b);
+        REQUIRE(x);
+        auto product = a * *x;
+        for (std::size_t i = 0; i < 6; i++)
+            CHECK(product[i] == Approx(b[i]));
+
+        auto y = a.solve(b);
+        REQUIRE(y);
+        for (std::size_t i = 0; i < 6; i++)
+            CHECK((*y)[i] == Approx((*x)[i]));
+
+        auto z = a.solveCol(2, b);
+        REQUIRE(z);
+        CHECK(*z == Approx((*x)[2]));
+    }
+    SECTION("The inverse multiplied with the matrix gives the identity matrix.")
+    {
+        auto inverse = a.inverse();
+        REQUIRE(inverse);
+        auto product = *inverse * a;
+        for (std::size_t col = 0; col < 6; col++)
+            for (std::size_t row = 0; row < 6; row++)
+                CHECK(product(col, row) == Approx(col == row ? 1.0 : 0.0).margin(1e-12));
+    }
+    SECTION("The determinant matches cofactor expansion.")
+    {
+        dmath::dmat4 small = a.subMatrix<1, 1, 4, 4>();
+        CHECK(small.lu().determinant() == Approx(small.determinant()));
+
+        constexpr auto triangular = makeMatrix<6>({{2, 0, 0, 0, 0, 0},
+                                                   {1, 3, 0, 0, 0, 0},
+                                                   {1, 1, -1, 0, 0, 0},
+                                                   {1, 1, 1, 4, 0, 0},
+                                                   {1, 1, 1, 1, 0.5, 0},
+                                                   {1, 1, 1, 1, 1, 2}});
+        CHECK(triangular.determinant() == Approx(-24));
+
+        auto swapped = triangular;
+        std::swap(swapped[0], swapped[1]);
+        CHECK(swapped.determinant() == Approx(24));
+    }
+    SECTION("Singular matrices cannot be solved.")
+    {
+        auto singular = a;
+        singular[3] = singular[1] * 2.0;
+        auto lu = singular.lu();
+        CHECK(lu.singular());
+        CHECK(lu.determinant() == 0);
+        CHECK_FALSE(lu.solve(b));
+        CHECK_FALSE(lu.inverse());
+        CHECK_FALSE(singular.solve(b));
+    }
+}
+
+TEST_CASE("Integer matrices bigger than 4x4 are solved without LU-decomposition.", "[matrix]")
+{
+    // Rotating the rows of a diagonal matrix keeps all results integral.
+    dmath::Matrix<int, 6> a;
+    for (std::size_t col = 0; col < 6; col++)
+        a(col, (col + 1) % 6) = static_cast<int>(col) + 1;
+    dmath::Vector<int, 6> x;
+    for (std::size_t i = 0; i < 6; i++)
+        x[i] = 6 - static_cast<int>(i);
+    auto b = a * x;
+
+    CHECK(a.solve(b) == std::optional(x));
+    CHECK(a.solveCol(2, b) == std::optional(4));
+
+    dmath::Matrix<int, 6> permutation;
+    for (std::size_t col = 0; col < 6; col++)
+        permutation(col, (col + 1) % 6) = 1;
+    auto inverse = permutation.inverse();
+    REQUIRE(inverse);
+    CHECK(*inverse * permutation == dmath::Matrix<int, 6>::identity());
+}
@@ -0,0 +1,132 @@
+#include "dang-math/skinning.h"
+
+#include "catch2/catch.hpp"
+
+namespace dmath = dang::math;
+
+namespace {
+
+struct Vertex {
+    dmath::vec3 position;
+    dmath::vec3 normal;
+    dmath::vec2 texcoord;
+};
+
+struct SkinnedMesh {
+    std::vector<dmath::vec3> positions;
+    std::vector<dmath::vec3> normals;
+    std::vector<dmath::Vector<std::uint8_t, 4>> bone_indices;
+    std::vector<dmath::vec4> bone_weights;
+
+    explicit SkinnedMesh(std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; i++) {
+            auto x = static_cast<float>(i % 17);
+            positions.emplace_back(x, static_cast<float>(i % 5) - 2, static_cast<float>(i % 3));
+            normals.push_back(dmath::vec3(1, x, 2).normalize());
+            bone_indices.emplace_back(static_cast<std::uint8_t>(i % 4),
+                                      static_cast<std::uint8_t>((i + 1) % 4),
+                                      static_cast<std::uint8_t>((i + 2) % 4),
+                                      static_cast<std::uint8_t>(3));
+            if (i % 3 == 0)
+                bone_weights.emplace_back(1, 0, 0, 0);
+            else
+                bone_weights.emplace_back(0.5f, 0.25f, 0.125f, 0.125f);
+        }
+    }
+
+    auto input() const
+    {
+        return dmath::SkinningInput<std::uint8_t>{
+            {positions.data(), positions.size()},
+            {normals.data(), normals.size()},
+            {bone_indices.data(), bone_indices.size()},
+            {bone_weights.data(), bone_weights.size()},
+        };
+    }
+
+    auto reference(const std::vector<dmath::dquat>& palette, std::size_t index) const
+    {
+        const auto& indices = bone_indices[index];
+        const auto& weights = bone_weights[index];
+        auto blended = palette[indices[0]] * weights[0];
+        for (std::size_t i = 1; i < 4; i++) {
+            const auto& first = palette[indices[0]].real.asVector();
+            float sign = first.dot(palette[indices[i]].real.asVector()) < 0 ? -1.0f : 1.0f;
+            blended += palette[indices[i]] * (weights[i] * sign);
+        }
+        blended = blended.normalize();
+        return std::pair{blended * positions[index], blended.real * normals[index]};
+    }
+};
+
+std::vector<dmath::dquat> makePalette()
+{
+    return {
+        dmath::dquat(),
+        dmath::dquat::fromTranslation({1, 2, 3}),
+        dmath::dquat::fromAxis(dmath::vec3(0, 1, 0), 90).translate({0, 1, 0}),
+        // Negated to represent the same transformation on the opposite hemisphere.
+        -dmath::dquat::fromAxis(dmath::vec3(1, 1, 0).normalize(), 30).translate({-2, 0, 1}),
+    };
+}
+
+void checkApprox(const dmath::vec3& actual, const dmath::vec3& expected)
+{
+    CAPTURE(actual, expected);
+    for (std::size_t i = 0; i < 3; i++)
+        CHECK(actual[i] == Approx(expected[i]).margin(1e-4));
+}
+
+} // namespace
+
+TEST_CASE("Dual-quaternion skinning matches blending dual-quaternions per vertex.", "[skinning]")
+{
+    const auto palette = makePalette();
+
+    SECTION("Writing to separate arrays.")
+    {
+        SkinnedMesh mesh(100);
+        std::vector<dmath::vec3> positions(mesh.positions.size());
+        std::vector<dmath::vec3> normals(mesh.normals.size());
+        dmath::SkinningOutput output{{positions.data(), positions.size()}, {normals.data(), normals.size()}};
+
+        dmath::skinning::dualQuaternion(mesh.input(), palette.data(), output);
+
+        for (std::size_t i = 0; i < positions.size(); i++) {
+            auto [position, normal] = mesh.reference(palette, i);
+            checkApprox(positions[i], position);
+            checkApprox(normals[i], normal);
+        }
+    }
+    SECTION("Writing into interleaved vertices using multiple threads.")
+    {
+        SkinnedMesh mesh(dmath::skinning::min_vertices_per_thread * 3 + 5);
+        std::vector<Vertex> vertices(mesh.positions.size(), {{}, {}, {7, 8}});
+        dmath::SkinningOutput output{{vertices.data(), vertices.size(), &Vertex::position},
+                                     {vertices.data(), vertices.size(), &Vertex::normal}};
+
+        dmath::skinning::dualQuaternion(mesh.input(), palette.data(), output, 4);
+
+        for (std::size_t i = 0; i < vertices.size(); i += 97) {
+            auto [position, normal] = mesh.reference(palette, i);
+            checkApprox(vertices[i].position, position);
+            checkApprox(vertices[i].normal, normal);
+        }
+        auto [position, normal] = mesh.reference(palette, vertices.size() - 1);
+        checkApprox(vertices.back().position, position);
+        CHECK(vertices.back().texcoord == dmath::vec2(7, 8));
+    }
+    SECTION("Normals are optional.")
+    {
+        SkinnedMesh mesh(10);
+        auto input = mesh.input();
+        input.normals = {};
+        std::vector<dmath::vec3> positions(mesh.positions.size());
+
+        dmath::skinning::dualQuaternion(input, palette.data(), {{positions.data(), positions.size()}, {}});
+
+        for (std::size_t i = 0; i < positions.size(); i++)
+            checkApprox(positions[i], mesh.reference(palette, i).first);
+    }
+}
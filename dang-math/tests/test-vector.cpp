@@ -414,3 +414,66 @@ TEST_CASE("Vectors support 3-dimensional operations.", "[vector][operations]")
     CHECK(rotated_deg.y() == Approx(2));
     CHECK(rotated_deg.z() == Approx(1));
 }
+
+TEST_CASE("Vectors give the same results at runtime as during constant evaluation.", "[vector][simd]")
+{
+    SECTION("Using vec3.")
+    {
+        constexpr dmath::vec3 a(6, -4, 6);
+        constexpr dmath::vec3 b(1, 2, -3);
+        dmath::vec3 c = a;
+        dmath::vec3 d = b;
+
+        CAPTURE(a, b);
+
+        CHECK(c + d == a + b);
+        CHECK(c - d == a - b);
+        CHECK(c * d == a * b);
+        CHECK(c / d == a / b);
+        CHECK(c.dot(d) == a.dot(b));
+        CHECK(c.sqrdot() == a.sqrdot());
+        CHECK(c.min(d) == a.min(b));
+        CHECK(c.max(d) == a.max(b));
+        CHECK((c += d) == a + b);
+        CHECK(c.normalize().length() == Approx(1));
+    }
+    SECTION("Using vec4.")
+    {
+        constexpr dmath::vec4 a(6, -4, 6, 8);
+        constexpr dmath::vec4 b(1, 2, -3, 4);
+        dmath::vec4 c = a;
+        dmath::vec4 d = b;
+
+        CAPTURE(a, b);
+
+        CHECK(c + d == a + b);
+        CHECK(c - d == a - b);
+        CHECK(c * d == a * b);
+        CHECK(c / d == a / b);
+        CHECK(c.dot(d) == a.dot(b));
+        CHECK(c.sqrdot() == a.sqrdot());
+        CHECK(c.min(d) == a.min(b));
+        CHECK(c.max(d) == a.max(b));
+        CHECK((c *= d) == a * b);
+        CHECK(c.normalize().length() == Approx(1));
+    }
+    SECTION("Using ivec4.")
+    {
+        constexpr dmath::ivec4 a(6, -4, 6, 8);
+        constexpr dmath::ivec4 b(1, 2, -3, 4);
+        dmath::ivec4 c = a;
+        dmath::ivec4 d = b;
+
+        CAPTURE(a, b);
+
+        CHECK(c + d == a + b);
+        CHECK(c - d == a - b);
+        CHECK(c * d == a * b);
+        CHECK(c / d == a / b);
+        CHECK(c.dot(d) == a.dot(b));
+        CHECK(c.sqrdot() == a.sqrdot());
+        CHECK(c.min(d) == a.min(b));
+        CHECK(c.max(d) == a.max(b));
+        CHECK((c -= d) == a - b);
+    }
+}